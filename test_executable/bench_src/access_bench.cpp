@@ -0,0 +1,138 @@
+//
+// Created in October 2026
+//
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    
+    ///weak_ptr whose content has been destroyed
+    referable_unique<std::uint64_t>::weak_ptr expired_weak_ptr()
+    {
+        auto object = variable_util::make_referable_unique<std::uint64_t>(0);
+        return referable_unique<std::uint64_t>::weak_ptr(object);
+    }
+    
+    bench::registrar expired_get_view(
+            "access/expired/get_view",
+            [](std::uint64_t iterations)
+            {
+                auto weak = expired_weak_ptr();
+                std::uint64_t expired_count = 0;
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    try
+                    {
+                        bench::do_not_optimize(weak.get_view());
+                    }
+                    catch (const std::bad_weak_ptr &)
+                    {
+                        ++expired_count;
+                    }
+                }
+                bench::do_not_optimize(expired_count);
+                return iterations;
+            }
+    );
+    
+    bench::registrar expired_try_get_view(
+            "access/expired/try_get_view",
+            [](std::uint64_t iterations)
+            {
+                auto weak = expired_weak_ptr();
+                std::uint64_t expired_count = 0;
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    auto result = weak.try_get_view();
+                    expired_count += (result.get_status() == variable_util::access_status::expired);
+                }
+                bench::do_not_optimize(expired_count);
+                return iterations;
+            }
+    );
+    
+    bench::registrar expired_get_const_view(
+            "access/expired/get_const_view",
+            [](std::uint64_t iterations)
+            {
+                auto weak = expired_weak_ptr();
+                std::uint64_t expired_count = 0;
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    try
+                    {
+                        bench::do_not_optimize(weak.get_const_view());
+                    }
+                    catch (const std::bad_weak_ptr &)
+                    {
+                        ++expired_count;
+                    }
+                }
+                bench::do_not_optimize(expired_count);
+                return iterations;
+            }
+    );
+    
+    bench::registrar expired_read(
+            "access/expired/read",
+            [](std::uint64_t iterations)
+            {
+                auto weak = expired_weak_ptr();
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                    bench::do_not_optimize(weak.read([](const std::uint64_t &content) { return content; }));
+                return iterations;
+            }
+    );
+    
+    bench::registrar live_get_view(
+            "access/live/get_view",
+            [](std::uint64_t iterations)
+            {
+                auto object = variable_util::make_referable_unique<std::uint64_t>(0);
+                referable_unique<std::uint64_t>::weak_ptr weak(object);
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    auto view = weak.get_view();
+                    ++**view;
+                }
+                return iterations;
+            }
+    );
+    
+    bench::registrar live_try_get_view(
+            "access/live/try_get_view",
+            [](std::uint64_t iterations)
+            {
+                auto object = variable_util::make_referable_unique<std::uint64_t>(0);
+                referable_unique<std::uint64_t>::weak_ptr weak(object);
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    auto result = weak.try_get_view();
+                    ++**result;
+                }
+                return iterations;
+            }
+    );
+    
+    bench::registrar expired_atomic_load(
+            "access/expired/atomic_load",
+            [](std::uint64_t iterations)
+            {
+                std::optional<referable_unique<std::atomic<std::uint64_t>>::weak_ptr> weak;
+                {
+                    referable_unique<std::atomic<std::uint64_t>> object(std::uint64_t(0));
+                    weak.emplace(object);
+                }
+                for (std::uint64_t i = 0; i < iterations; ++i) bench::do_not_optimize(**weak);
+                return iterations;
+            }
+    );
+}
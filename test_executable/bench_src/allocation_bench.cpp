@@ -0,0 +1,147 @@
+//
+// Created in October 2026
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    
+    struct payload
+    {
+        std::uint64_t values[4];
+        
+        explicit payload(std::uint64_t seed) : values{seed, seed + 1, seed + 2, seed + 3}
+        {}
+    };
+    
+    const unsigned thread_counts[] = {1, 4};
+    
+    ///Objects alive per thread, every operation replaces the oldest one
+    constexpr std::uint64_t live_count = 4096;
+    
+    /**
+     * Every thread keeps live_count objects and replaces one per operation.
+     * @tparam churn_t callable with (iterations, thread index) running the workload of one thread
+     */
+    template<typename churn_t>
+    void register_churn_cases(const std::string &name, churn_t churn)
+    {
+        for (unsigned thread_count: thread_counts)
+        {
+            bench::registrar(
+                    "churn/" + name + "/threads:" + std::to_string(thread_count),
+                    [thread_count, churn](std::uint64_t iterations)
+                    {
+                        const std::uint64_t per_thread = iterations / thread_count + 1;
+                        bench::run_threads(
+                                thread_count,
+                                [&](unsigned thread_index) { churn(per_thread, thread_index); }
+                        );
+                        return per_thread * thread_count;
+                    }
+            );
+        }
+    }
+    
+    /**
+     * Replace live objects in a ring with objects created by make
+     * @tparam make_t callable with (seed) returning referable_unique<payload>
+     */
+    template<typename make_t>
+    void churn_ring(std::uint64_t iterations, make_t make)
+    {
+        std::vector<std::optional<referable_unique<payload>>> live(live_count);
+        for (std::uint64_t i = 0; i < iterations; ++i)
+        {
+            live[i % live_count].reset();
+            live[i % live_count].emplace(make(i));
+            if (i % live_count == live_count - 1) bench::sample_resident_set();
+        }
+    }
+    
+    std::pmr::synchronized_pool_resource &shared_pool()
+    {
+        static std::pmr::synchronized_pool_resource pool;
+        return pool;
+    }
+    
+    const bool churn_cases_registered = (
+            register_churn_cases(
+                    "global_heap",
+                    [](std::uint64_t iterations, unsigned)
+                    {
+                        churn_ring(
+                                iterations,
+                                [](std::uint64_t seed)
+                                {
+                                    return variable_util::make_referable_unique<payload>(seed);
+                                }
+                        );
+                    }
+            ),
+            register_churn_cases(
+                    "synchronized_pool",
+                    [](std::uint64_t iterations, unsigned)
+                    {
+                        const std::pmr::polymorphic_allocator<std::byte> allocator(&shared_pool());
+                        churn_ring(
+                                iterations,
+                                [&allocator](std::uint64_t seed)
+                                {
+                                    return variable_util::allocate_referable_unique<payload>(allocator, seed);
+                                }
+                        );
+                    }
+            ),
+            register_churn_cases(
+                    /// objects never leave the thread which creates them,
+                    /// so each thread can use a pool without synchronization
+                    "thread_local_pool",
+                    [](std::uint64_t iterations, unsigned)
+                    {
+                        std::pmr::unsynchronized_pool_resource pool;
+                        const std::pmr::polymorphic_allocator<std::byte> allocator(&pool);
+                        churn_ring(
+                                iterations,
+                                [&allocator](std::uint64_t seed)
+                                {
+                                    return variable_util::allocate_referable_unique<payload>(allocator, seed);
+                                }
+                        );
+                    }
+            ),
+            register_churn_cases(
+                    /// a generation of live_count objects is created in an arena,
+                    /// then dropped at once and the arena is released for the next one
+                    "monotonic_arena",
+                    [](std::uint64_t iterations, unsigned)
+                    {
+                        std::pmr::monotonic_buffer_resource arena;
+                        const std::pmr::polymorphic_allocator<std::byte> allocator(&arena);
+                        std::vector<referable_unique<payload>> generation;
+                        generation.reserve(live_count);
+                        for (std::uint64_t i = 0; i < iterations; ++i)
+                        {
+                            generation.push_back(variable_util::allocate_referable_unique<payload>(allocator, i));
+                            if (generation.size() == live_count)
+                            {
+                                bench::sample_resident_set();
+                                generation.clear();
+                                arena.release();
+                            }
+                        }
+                    }
+            ),
+            true
+    );
+}
@@ -0,0 +1,330 @@
+//
+// Created in October 2026
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#include <unistd.h>
+
+#include "bench.hpp"
+
+namespace
+{
+    std::atomic<std::uint64_t> global_allocation_count(0);
+    std::atomic<std::uint64_t> peak_resident_set(0);
+    std::mutex latency_guard;
+    std::vector<std::uint64_t> recorded_latencies;
+    
+    std::vector<std::pair<std::string, bench::case_function>> &registered_cases()
+    {
+        static std::vector<std::pair<std::string, bench::case_function>> cases;
+        return cases;
+    }
+    
+    void *counted_allocate(std::size_t size, std::size_t alignment)
+    {
+        global_allocation_count.fetch_add(1, std::memory_order_relaxed);
+        if (size == 0) size = 1;
+        void *pointer = alignment <= alignof(std::max_align_t)
+                        ? std::malloc(size)
+                        : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+        if (!pointer) throw std::bad_alloc();
+        return pointer;
+    }
+}
+
+void *operator new(std::size_t size)
+{
+    return counted_allocate(size, alignof(std::max_align_t));
+}
+
+void *operator new[](std::size_t size)
+{
+    return counted_allocate(size, alignof(std::max_align_t));
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    return counted_allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return counted_allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept
+{
+    std::free(pointer);
+}
+
+std::uint64_t bench::allocation_count() noexcept
+{
+    return global_allocation_count.load(std::memory_order_relaxed);
+}
+
+void bench::sample_resident_set() noexcept
+{
+    unsigned long long total_pages = 0, resident_pages = 0;
+    if (FILE *statm = std::fopen("/proc/self/statm", "r"))
+    {
+        if (std::fscanf(statm, "%llu %llu", &total_pages, &resident_pages) != 2) resident_pages = 0;
+        std::fclose(statm);
+    }
+    const std::uint64_t resident_set = resident_pages * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+    std::uint64_t peak = peak_resident_set.load(std::memory_order_relaxed);
+    while (resident_set > peak && !peak_resident_set.compare_exchange_weak(peak, resident_set));
+}
+
+void bench::record_latency(std::uint64_t nanoseconds)
+{
+    std::lock_guard<std::mutex> latency_lock(latency_guard);
+    recorded_latencies.push_back(nanoseconds);
+}
+
+bench::registrar::registrar(const std::string &name, bench::case_function function)
+{
+    registered_cases().emplace_back(name, std::move(function));
+}
+
+void bench::run_threads(unsigned thread_count, const std::function<void(unsigned)> &function)
+{
+    std::atomic<unsigned> ready_count(0);
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    for (unsigned thread_index = 0; thread_index < thread_count; ++thread_index)
+    {
+        threads.emplace_back(
+                [&, thread_index]()
+                {
+                    ready_count.fetch_add(1);
+                    while (ready_count.load() < thread_count) std::this_thread::yield();
+                    function(thread_index);
+                }
+        );
+    }
+    for (auto &thread: threads) thread.join();
+}
+
+namespace
+{
+    enum class output_format
+    {
+        table, csv, json
+    };
+    
+    struct case_result
+    {
+        std::uint64_t operations;
+        double nanoseconds_per_operation;
+        double operations_per_second;
+        double allocations_per_operation;
+        ///0 if the case sampled no resident set size
+        std::uint64_t resident_set_kib;
+        ///0 if the case recorded no latency
+        std::uint64_t p999_latency_nanoseconds;
+    };
+    
+    ///99.9th percentile of the recorded latencies, which are cleared
+    std::uint64_t take_p999_latency()
+    {
+        std::lock_guard<std::mutex> latency_lock(latency_guard);
+        if (recorded_latencies.empty()) return 0;
+        const auto rank = recorded_latencies.begin() + (recorded_latencies.size() - 1) * 999 / 1000;
+        std::nth_element(recorded_latencies.begin(), rank, recorded_latencies.end());
+        const std::uint64_t p999_latency = *rank;
+        recorded_latencies.clear();
+        return p999_latency;
+    }
+    
+    /**
+     * Run function with doubling iterations until one run lasts minimum_duration
+     * and return the measurement of the last run
+     */
+    case_result measure(const bench::case_function &function, std::chrono::nanoseconds minimum_duration)
+    {
+        std::uint64_t iterations = 1, operations = 0, allocations = 0;
+        std::chrono::nanoseconds elapsed(0);
+        while (true)
+        {
+#if defined(__GLIBC__)
+            /// return the memory freed by previous runs so that rss is comparable between cases
+            malloc_trim(0);
+#endif
+            peak_resident_set.store(0, std::memory_order_relaxed);
+            take_p999_latency();
+            const std::uint64_t allocations_before = bench::allocation_count();
+            const auto start = std::chrono::steady_clock::now();
+            operations = function(iterations);
+            elapsed = std::chrono::steady_clock::now() - start;
+            allocations = bench::allocation_count() - allocations_before;
+            if (elapsed >= minimum_duration || iterations >= (std::uint64_t(1) << 40)) break;
+            iterations *= 2;
+        }
+        if (operations == 0) operations = 1;
+        const double nanoseconds = elapsed.count() > 0 ? (double) elapsed.count() : 1.0;
+        return case_result{
+                operations,
+                nanoseconds / (double) operations,
+                (double) operations * 1e9 / nanoseconds,
+                (double) allocations / (double) operations,
+                peak_resident_set.load(std::memory_order_relaxed) / 1024,
+                take_p999_latency()
+        };
+    }
+    
+    void print_header(output_format format)
+    {
+        switch (format)
+        {
+            case output_format::table:
+                std::printf(
+                        "%-56s %14s %12s %14s %14s %12s %12s\n",
+                        "case", "iterations", "ns/op", "ops/s", "allocs/op", "rss KiB", "p99.9 ns"
+                );
+                break;
+            case output_format::csv:
+                std::printf("case,iterations,ns_per_op,ops_per_s,allocs_per_op,rss_kib,p999_ns\n");
+                break;
+            case output_format::json:
+                std::printf("[");
+                break;
+        }
+    }
+    
+    ///Case names never contain characters which need escaping in csv or json
+    void print_result(output_format format, const std::string &name, const case_result &result, bool first)
+    {
+        const std::string resident_set = result.resident_set_kib ? std::to_string(result.resident_set_kib) : "";
+        const std::string p999_latency =
+                result.p999_latency_nanoseconds ? std::to_string(result.p999_latency_nanoseconds) : "";
+        switch (format)
+        {
+            case output_format::table:
+                std::printf(
+                        "%-56s %14llu %12.2f %14.0f %14.3f %12s %12s\n", name.c_str(),
+                        (unsigned long long) result.operations,
+                        result.nanoseconds_per_operation, result.operations_per_second,
+                        result.allocations_per_operation,
+                        resident_set.empty() ? "-" : resident_set.c_str(),
+                        p999_latency.empty() ? "-" : p999_latency.c_str()
+                );
+                break;
+            case output_format::csv:
+                std::printf(
+                        "%s,%llu,%.3f,%.0f,%.4f,%s,%s\n", name.c_str(),
+                        (unsigned long long) result.operations,
+                        result.nanoseconds_per_operation, result.operations_per_second,
+                        result.allocations_per_operation, resident_set.c_str(), p999_latency.c_str()
+                );
+                break;
+            case output_format::json:
+                std::printf(
+                        "%s\n  {\"case\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.3f, "
+                        "\"ops_per_s\": %.0f, \"allocs_per_op\": %.4f, \"rss_kib\": %s, \"p999_ns\": %s}",
+                        first ? "" : ",", name.c_str(),
+                        (unsigned long long) result.operations,
+                        result.nanoseconds_per_operation, result.operations_per_second,
+                        result.allocations_per_operation,
+                        resident_set.empty() ? "null" : resident_set.c_str(),
+                        p999_latency.empty() ? "null" : p999_latency.c_str()
+                );
+                break;
+        }
+        std::fflush(stdout);
+    }
+    
+    void print_footer(output_format format)
+    {
+        if (format == output_format::json) std::printf("\n]\n");
+    }
+}
+
+/**
+ * Usage: bench [--format=table|csv|json] [--min-time-ms=N] [name filter]
+ * Runs every registered case whose name contains the filter,
+ * each one until a single run lasts at least N milliseconds (200 by default).
+ * The rss column is the peak resident set size sampled by the case, or empty if it samples none.
+ * The p99.9 column is the 99.9th percentile of the latencies recorded by the case, or empty if it records none.
+ */
+int main(int argc, char **argv)
+{
+    output_format format = output_format::table;
+    std::chrono::nanoseconds minimum_duration(std::chrono::milliseconds(200));
+    std::string filter;
+    for (int index = 1; index < argc; ++index)
+    {
+        const std::string argument(argv[index]);
+        if (argument == "--format=table") format = output_format::table;
+        else if (argument == "--format=csv") format = output_format::csv;
+        else if (argument == "--format=json") format = output_format::json;
+        else if (argument.rfind("--min-time-ms=", 0) == 0)
+            minimum_duration = std::chrono::milliseconds(std::strtoull(argument.c_str() + 14, nullptr, 10));
+        else if (argument.rfind("--", 0) == 0)
+        {
+            std::fprintf(stderr, "usage: %s [--format=table|csv|json] [--min-time-ms=N] [filter]\n", argv[0]);
+            return 2;
+        }
+        else filter = argument;
+    }
+    
+    print_header(format);
+    bool first = true;
+    for (auto &[name, function]: registered_cases())
+    {
+        if (name.find(filter) == std::string::npos) continue;
+        print_result(format, name, measure(function, minimum_duration), first);
+        first = false;
+    }
+    print_footer(format);
+    return 0;
+}
@@ -0,0 +1,66 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__c67bcfd1_58a4_4c20_aa85_8d95c0b662ef__bench_hpp
+#define HEADER_GUARD__c67bcfd1_58a4_4c20_aa85_8d95c0b662ef__bench_hpp
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace bench
+{
+    /**
+     * A benchmark case runs its operation the given number of times
+     * and returns how many operations it actually performed.
+     */
+    using case_function = std::function<std::uint64_t(std::uint64_t iterations)>;
+    
+    /**
+     * Number of calls of the global operator new since program start.
+     * The counter is shared by all threads.
+     */
+    std::uint64_t allocation_count() noexcept;
+    
+    /**
+     * Records the current resident set size of the process.
+     * The largest size recorded during the last run of a case is reported with it.
+     */
+    void sample_resident_set() noexcept;
+    
+    /**
+     * Records the latency of one operation of the current case.
+     * The 99.9th percentile of the latencies recorded during the last run of a case is reported with it.
+     * @param nanoseconds
+     */
+    void record_latency(std::uint64_t nanoseconds);
+    
+    /**
+     * Registers a benchmark case at static initialization time
+     */
+    class registrar final
+    {
+    public:
+        registrar(const std::string &name, case_function function);
+    };
+    
+    /**
+     * Runs function(thread_index) on thread_count threads
+     * which are released together, and returns when all of them have finished.
+     */
+    void run_threads(unsigned thread_count, const std::function<void(unsigned)> &function);
+    
+    /**
+     * Prevents the compiler from optimizing away a computed value
+     * @tparam value_t
+     * @param value
+     */
+    template<typename value_t>
+    inline void do_not_optimize(const value_t &value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+}
+
+#endif //HEADER_GUARD__c67bcfd1_58a4_4c20_aa85_8d95c0b662ef__bench_hpp
@@ -0,0 +1,65 @@
+//
+// Created in October 2026
+//
+
+#include <cstdint>
+#include <string>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    
+    enum class access_path
+    {
+        weak_ptr, owner_dereference, owner_borrow
+    };
+    
+    /**
+     * The thread owning the content modifies it, or reads it when const_access,
+     * through a weak_ptr, through operator* of the owner or through borrow
+     */
+    void register_borrow_case(const std::string &name, access_path path, bool const_access)
+    {
+        bench::registrar(
+                "borrow/" + name + (const_access ? "/const_view" : "/view"),
+                [path, const_access](std::uint64_t iterations)
+                {
+                    auto object = variable_util::make_referable_unique<std::int64_t>(0);
+                    const referable_unique<std::int64_t> &const_object = object;
+                    referable_unique<std::int64_t>::weak_ptr weak(object);
+                    for (std::uint64_t i = 0; i < iterations; ++i)
+                    {
+                        switch (path)
+                        {
+                            case access_path::weak_ptr:
+                                if (const_access) bench::do_not_optimize(**weak.get_const_view());
+                                else **weak.get_view() += i;
+                                break;
+                            case access_path::owner_dereference:
+                                if (const_access) bench::do_not_optimize(***const_object);
+                                else ***object += i;
+                                break;
+                            case access_path::owner_borrow:
+                                if (const_access) bench::do_not_optimize(*const_object.borrow_const());
+                                else *object.borrow() += i;
+                                break;
+                        }
+                    }
+                    return iterations;
+                }
+        );
+    }
+    
+    const bool borrow_cases_registered = (
+            register_borrow_case("weak_ptr", access_path::weak_ptr, false),
+            register_borrow_case("weak_ptr", access_path::weak_ptr, true),
+            register_borrow_case("owner_dereference", access_path::owner_dereference, false),
+            register_borrow_case("owner_dereference", access_path::owner_dereference, true),
+            register_borrow_case("owner_borrow", access_path::owner_borrow, false),
+            register_borrow_case("owner_borrow", access_path::owner_borrow, true),
+            true
+    );
+}
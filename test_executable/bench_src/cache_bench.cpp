@@ -0,0 +1,84 @@
+//
+// Created in October 2026
+//
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    using variable_util::handle_cache;
+    
+    ///Objects resolved over and over by every worker, within the default capacity of handle_cache
+    constexpr std::uint32_t object_count = 256;
+    
+    const unsigned thread_counts[] = {1, 4};
+    
+    std::vector<referable_unique<std::uint64_t>> &shared_objects()
+    {
+        static std::vector<referable_unique<std::uint64_t>> objects = []()
+        {
+            std::vector<referable_unique<std::uint64_t>> created;
+            created.reserve(object_count);
+            for (std::uint32_t i = 0; i < object_count; ++i)
+                created.push_back(variable_util::make_referable_unique<std::uint64_t>(i));
+            return created;
+        }();
+        return objects;
+    }
+    
+    /**
+     * Workers hold a weak_ptr to every object and take a const_view of one of them per operation,
+     * through the weak_ptr or through the handle_cache of the thread
+     */
+    void register_cache_cases(const std::string &name, bool cached)
+    {
+        for (unsigned thread_count: thread_counts)
+        {
+            bench::registrar(
+                    "cache/" + name + "/threads:" + std::to_string(thread_count),
+                    [thread_count, cached](std::uint64_t iterations)
+                    {
+                        const std::uint64_t per_thread = iterations / thread_count + 1;
+                        bench::run_threads(
+                                thread_count,
+                                [&](unsigned thread_index)
+                                {
+                                    std::vector<referable_unique<std::uint64_t>::weak_ptr> references;
+                                    references.reserve(object_count);
+                                    for (auto &object: shared_objects()) references.emplace_back(object);
+                                    auto &cache = handle_cache<std::uint64_t>::local();
+                                    for (std::uint64_t i = 0; i < per_thread; ++i)
+                                    {
+                                        auto &reference = references[(i * 41 + thread_index) % object_count];
+                                        if (cached)
+                                        {
+                                            auto content_view = cache.get_const_view(reference);
+                                            bench::do_not_optimize(**content_view);
+                                        }
+                                        else
+                                        {
+                                            auto content_view = reference.get_const_view();
+                                            bench::do_not_optimize(**content_view);
+                                        }
+                                    }
+                                    cache.clear();
+                                }
+                        );
+                        return per_thread * thread_count;
+                    }
+            );
+        }
+    }
+    
+    const bool cache_cases_registered = (
+            register_cache_cases("weak_ptr", false),
+            register_cache_cases("handle_cache", true),
+            true
+    );
+}
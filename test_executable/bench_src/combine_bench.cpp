@@ -0,0 +1,86 @@
+//
+// Created in October 2026
+//
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    
+    const unsigned thread_counts[] = {2, 4, 8, 16, 32, 64};
+    
+    ///Keys of the map case, so that its working set spans many cache lines
+    constexpr std::uint64_t key_count = 4096;
+    
+    using counter_content = std::int64_t;
+    using map_content = std::unordered_map<std::uint64_t, std::uint64_t>;
+    
+    inline void modify(counter_content &content, std::uint64_t i) noexcept
+    {
+        content += i;
+    }
+    
+    inline void modify(map_content &content, std::uint64_t i)
+    {
+        content[i * 2654435761u % key_count] += i;
+    }
+    
+    enum class write_path
+    {
+        view, apply
+    };
+    
+    /**
+     * Every operation modifies the content, through a view or through weak_ptr::apply
+     * @tparam content_t counter_content or map_content
+     */
+    template<typename content_t>
+    void register_combine_cases(const std::string &name, write_path path)
+    {
+        for (unsigned thread_count: thread_counts)
+        {
+            bench::registrar(
+                    "combine/" + name + (path == write_path::view ? "/view" : "/apply") +
+                    "/threads:" + std::to_string(thread_count),
+                    [thread_count, path](std::uint64_t iterations)
+                    {
+                        referable_unique<content_t> object(
+                                std::in_place, variable_util::referable_tag(), variable_util::referable_tag()
+                        );
+                        const std::uint64_t per_thread = iterations / thread_count + 1;
+                        bench::run_threads(
+                                thread_count,
+                                [&](unsigned)
+                                {
+                                    typename referable_unique<content_t>::weak_ptr weak(object);
+                                    for (std::uint64_t i = 0; i < per_thread; ++i)
+                                    {
+                                        if (path == write_path::view)
+                                        {
+                                            auto content_view = weak.get_view();
+                                            modify(**content_view, i);
+                                        }
+                                        else weak.apply([i](content_t &content) { modify(content, i); });
+                                    }
+                                }
+                        );
+                        return per_thread * thread_count;
+                    }
+            );
+        }
+    }
+    
+    const bool combine_cases_registered = (
+            register_combine_cases<counter_content>("counter", write_path::view),
+            register_combine_cases<counter_content>("counter", write_path::apply),
+            register_combine_cases<map_content>("map", write_path::view),
+            register_combine_cases<map_content>("map", write_path::apply),
+            true
+    );
+}
@@ -0,0 +1,157 @@
+//
+// Created in October 2026
+//
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    
+    struct payload
+    {
+        std::uint64_t values[4];
+        
+        explicit payload(std::uint64_t seed) : values{seed, seed + 1, seed + 2, seed + 3}
+        {}
+    };
+    
+    bench::registrar raw_pointer_construction(
+            "construction/raw_pointer",
+            [](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    referable_unique<payload> object(new payload(i));
+                    bench::do_not_optimize(object);
+                }
+                return iterations;
+            }
+    );
+    
+    bench::registrar raw_pointer_lvalue_construction(
+            "construction/raw_pointer_lvalue",
+            [](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    payload *content = new payload(i);
+                    referable_unique<payload> object(content);
+                    bench::do_not_optimize(object);
+                }
+                return iterations;
+            }
+    );
+    
+    bench::registrar unique_ptr_construction(
+            "construction/unique_ptr",
+            [](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    referable_unique<payload> object(std::make_unique<payload>(i));
+                    bench::do_not_optimize(object);
+                }
+                return iterations;
+            }
+    );
+    
+    bench::registrar shared_ptr_construction(
+            "construction/shared_ptr",
+            [](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    referable_unique<payload> object(std::make_shared<payload>(i));
+                    bench::do_not_optimize(object);
+                }
+                return iterations;
+            }
+    );
+    
+    bench::registrar in_place_construction(
+            "construction/make_referable_unique",
+            [](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    auto object = variable_util::make_referable_unique<payload>(i);
+                    bench::do_not_optimize(object);
+                }
+                return iterations;
+            }
+    );
+    
+    bench::registrar tagged_in_place_construction(
+            "construction/make_tagged_referable_unique",
+            [](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    auto object = variable_util::make_tagged_referable_unique<payload>(i, 0, i);
+                    bench::do_not_optimize(object);
+                }
+                return iterations;
+            }
+    );
+    
+    bench::registrar string_tagged_in_place_construction(
+            "construction/make_tagged_referable_unique/string_tags",
+            [](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    auto object = variable_util::make_tagged_referable_unique<payload>(
+                            "order-0000000001", "pending", i
+                    );
+                    bench::do_not_optimize(object);
+                }
+                return iterations;
+            }
+    );
+    
+    bench::registrar allocator_construction(
+            "construction/allocate_referable_unique",
+            [](std::uint64_t iterations)
+            {
+                const std::allocator<payload> allocator;
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    auto object = variable_util::allocate_referable_unique<payload>(allocator, i);
+                    bench::do_not_optimize(object);
+                }
+                return iterations;
+            }
+    );
+    
+    bench::registrar atomic_construction(
+            "construction/atomic",
+            [](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    referable_unique<std::atomic<std::uint64_t>> object(i);
+                    bench::do_not_optimize(object);
+                }
+                return iterations;
+            }
+    );
+    
+    bench::registrar rcu_construction(
+            "construction/rcu",
+            [](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    auto object = variable_util::make_referable_unique<payload, variable_util::rcu_policy>(i);
+                    bench::do_not_optimize(object);
+                }
+                return iterations;
+            }
+    );
+}
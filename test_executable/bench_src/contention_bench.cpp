@@ -0,0 +1,72 @@
+//
+// Created in October 2026
+//
+
+#include <cstdint>
+#include <string>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    
+    struct config
+    {
+        std::uint64_t values[8];
+    };
+    
+    const unsigned thread_counts[] = {1, 2, 4, 8};
+    
+    /**
+     * Every thread accesses one shared object through its own weak_ptr,
+     * one operation in write_interval takes a view and the others a const_view
+     * @tparam lock_policy lock policy of the shared object
+     */
+    template<typename lock_policy>
+    void register_contention_cases(const std::string &name, std::uint64_t write_interval)
+    {
+        for (unsigned thread_count: thread_counts)
+        {
+            bench::registrar(
+                    "contention/" + name + "/threads:" + std::to_string(thread_count),
+                    [thread_count, write_interval](std::uint64_t iterations)
+                    {
+                        auto object = variable_util::make_referable_unique<config, lock_policy>(config{});
+                        const typename referable_unique<config, lock_policy>::weak_ptr weak(object);
+                        const std::uint64_t per_thread = iterations / thread_count + 1;
+                        bench::run_threads(
+                                thread_count,
+                                [&](unsigned)
+                                {
+                                    typename referable_unique<config, lock_policy>::weak_ptr local(weak);
+                                    for (std::uint64_t i = 0; i < per_thread; ++i)
+                                    {
+                                        if (i % write_interval == 0)
+                                        {
+                                            auto view = local.get_view();
+                                            ++(*view)->values[0];
+                                        }
+                                        else
+                                        {
+                                            auto const_view = local.get_const_view();
+                                            bench::do_not_optimize((*const_view)->values[0]);
+                                        }
+                                    }
+                                }
+                        );
+                        return per_thread * thread_count;
+                    }
+            );
+        }
+    }
+    
+    const bool contention_cases_registered = (
+            register_contention_cases<std::shared_timed_mutex>("get_view", 1),
+            register_contention_cases<std::shared_timed_mutex>("mixed_1_in_8", 8),
+            register_contention_cases<variable_util::futex_shared_mutex>("futex/get_view", 1),
+            register_contention_cases<variable_util::futex_shared_mutex>("futex/mixed_1_in_8", 8),
+            true
+    );
+}
@@ -0,0 +1,75 @@
+//
+// Created in October 2026
+//
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    using variable_util::sharded_counter_policy;
+    
+    const unsigned thread_counts[] = {1, 2, 4, 8, 16, 32, 64};
+    
+    using plain_counter = referable_unique<std::atomic<std::uint64_t>>;
+    using sharded_counter = referable_unique<std::atomic<std::uint64_t>, sharded_counter_policy>;
+    
+    inline void increment(const plain_counter::weak_ptr &counter) noexcept
+    {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    inline void increment(const sharded_counter::weak_ptr &counter) noexcept
+    {
+        counter.add(1);
+    }
+    
+    /**
+     * Every thread increments one shared counter through its own weak_ptr,
+     * and one operation in read_interval reads the counter
+     * @tparam counter_t referable_unique<std::atomic<std::uint64_t>, lock_policy>
+     */
+    template<typename counter_t>
+    void register_counter_cases(const std::string &name, std::uint64_t read_interval)
+    {
+        for (unsigned thread_count: thread_counts)
+        {
+            bench::registrar(
+                    "counter/" + name + "/threads:" + std::to_string(thread_count),
+                    [thread_count, read_interval](std::uint64_t iterations)
+                    {
+                        counter_t counter(std::uint64_t(0));
+                        const typename counter_t::weak_ptr weak(counter);
+                        const std::uint64_t per_thread = iterations / thread_count + 1;
+                        bench::run_threads(
+                                thread_count,
+                                [&](unsigned)
+                                {
+                                    const typename counter_t::weak_ptr local(weak);
+                                    for (std::uint64_t i = 1; i <= per_thread; ++i)
+                                    {
+                                        if (i % read_interval == 0) bench::do_not_optimize(*local.load());
+                                        else increment(local);
+                                    }
+                                }
+                        );
+                        bench::do_not_optimize(*counter);
+                        return per_thread * thread_count;
+                    }
+            );
+        }
+    }
+    
+    const bool counter_cases_registered = (
+            register_counter_cases<plain_counter>("atomic/increment", UINT64_MAX),
+            register_counter_cases<sharded_counter>("sharded/increment", UINT64_MAX),
+            register_counter_cases<plain_counter>("atomic/read_1_in_1024", 1024),
+            register_counter_cases<sharded_counter>("sharded/read_1_in_1024", 1024),
+            true
+    );
+}
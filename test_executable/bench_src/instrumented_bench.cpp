@@ -0,0 +1,111 @@
+//
+// Created in October 2026
+//
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    using variable_util::instrumented_mutex;
+    using variable_util::referable_tag;
+    
+    struct counter
+    {
+        std::uint64_t value;
+    };
+    
+    const unsigned thread_counts[] = {1, 4};
+    
+    /**
+     * Every thread accesses one shared object through its own weak_ptr,
+     * taking a view if write is true and a const_view otherwise
+     * @tparam lock_policy lock policy of the shared object
+     */
+    template<typename lock_policy>
+    void register_access_cases(const std::string &name, bool write)
+    {
+        for (unsigned thread_count: thread_counts)
+        {
+            bench::registrar(
+                    "instrumented/" + name + "/threads:" + std::to_string(thread_count),
+                    [thread_count, write](std::uint64_t iterations)
+                    {
+                        auto object = variable_util::make_tagged_referable_unique<counter, lock_policy>(
+                                referable_tag(), referable_tag("bench"), counter{0}
+                        );
+                        const typename referable_unique<counter, lock_policy>::weak_ptr weak(object);
+                        const std::uint64_t per_thread = iterations / thread_count + 1;
+                        bench::run_threads(
+                                thread_count,
+                                [&](unsigned)
+                                {
+                                    typename referable_unique<counter, lock_policy>::weak_ptr local(weak);
+                                    for (std::uint64_t i = 0; i < per_thread; ++i)
+                                    {
+                                        if (write)
+                                        {
+                                            auto view = local.get_view();
+                                            ++(*view)->value;
+                                        }
+                                        else
+                                        {
+                                            auto const_view = local.get_const_view();
+                                            bench::do_not_optimize((*const_view)->value);
+                                        }
+                                    }
+                                }
+                        );
+                        return per_thread * thread_count;
+                    }
+            );
+        }
+    }
+    
+    /**
+     * Cost of one snapshot of top_count records among object_count instrumented objects
+     */
+    void register_snapshot_case(std::size_t object_count, std::size_t top_count)
+    {
+        bench::registrar(
+                "instrumented/snapshot/objects:" + std::to_string(object_count) +
+                "/top:" + std::to_string(top_count),
+                [object_count, top_count](std::uint64_t iterations)
+                {
+                    using instrumented_referable = referable_unique<counter, instrumented_mutex<>>;
+                    std::vector<instrumented_referable> objects;
+                    objects.reserve(object_count);
+                    for (std::size_t index = 0; index < object_count; ++index)
+                    {
+                        objects.push_back(
+                                variable_util::make_tagged_referable_unique<counter, instrumented_mutex<>>(
+                                        referable_tag(), referable_tag("object"), counter{index}
+                                )
+                        );
+                        instrumented_referable::weak_ptr weak(objects.back());
+                        ++(*weak.get_view())->value;
+                    }
+                    for (std::uint64_t i = 0; i < iterations; ++i)
+                    {
+                        auto hottest = variable_util::lock_statistics::instance().snapshot(top_count);
+                        bench::do_not_optimize(hottest.size());
+                    }
+                    return iterations;
+                }
+        );
+    }
+    
+    const bool instrumented_cases_registered = (
+            register_access_cases<std::shared_timed_mutex>("plain/get_view", true),
+            register_access_cases<instrumented_mutex<>>("enabled/get_view", true),
+            register_access_cases<std::shared_timed_mutex>("plain/get_const_view", false),
+            register_access_cases<instrumented_mutex<>>("enabled/get_const_view", false),
+            register_snapshot_case(1000, 10),
+            true
+    );
+}
@@ -0,0 +1,88 @@
+//
+// Created in October 2026
+//
+
+#include <cstdint>
+#include <string>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    
+    struct payload
+    {
+        std::uint64_t values[4];
+        
+        explicit payload(std::uint64_t seed) : values{seed, seed + 1, seed + 2, seed + 3}
+        {}
+    };
+    
+    ///The same payload embedding its reference counts, content_guard and tags
+    struct intrusive_payload : variable_util::referable_base<>
+    {
+        std::uint64_t values[4];
+        
+        explicit intrusive_payload(std::uint64_t seed) : values{seed, seed + 1, seed + 2, seed + 3}
+        {}
+    };
+    
+    /**
+     * Construction with make_referable_unique, copies of a weak_ptr
+     * and get_view through a weak_ptr, for the separate Container and for the intrusive content
+     * @tparam content_t payload or intrusive_payload
+     */
+    template<typename content_t>
+    void register_intrusive_cases(const std::string &name)
+    {
+        bench::registrar(
+                "intrusive/" + name + "/construction",
+                [](std::uint64_t iterations)
+                {
+                    for (std::uint64_t i = 0; i < iterations; ++i)
+                    {
+                        auto object = variable_util::make_referable_unique<content_t>(i);
+                        bench::do_not_optimize(object);
+                    }
+                    return iterations;
+                }
+        );
+        bench::registrar(
+                "intrusive/" + name + "/weak_ptr_copy",
+                [](std::uint64_t iterations)
+                {
+                    auto object = variable_util::make_referable_unique<content_t>(0);
+                    const typename referable_unique<content_t>::weak_ptr weak(object);
+                    for (std::uint64_t i = 0; i < iterations; ++i)
+                    {
+                        typename referable_unique<content_t>::weak_ptr copy(weak);
+                        bench::do_not_optimize(copy);
+                    }
+                    return iterations;
+                }
+        );
+        bench::registrar(
+                "intrusive/" + name + "/get_view",
+                [](std::uint64_t iterations)
+                {
+                    auto object = variable_util::make_referable_unique<content_t>(0);
+                    typename referable_unique<content_t>::weak_ptr weak(object);
+                    for (std::uint64_t i = 0; i < iterations; ++i)
+                    {
+                        auto content_view = weak.get_view();
+                        (*content_view)->values[0] += i;
+                    }
+                    bench::do_not_optimize(object->values[0]);
+                    return iterations;
+                }
+        );
+    }
+    
+    const bool intrusive_cases_registered = (
+            register_intrusive_cases<payload>("container"),
+            register_intrusive_cases<intrusive_payload>("referable_base"),
+            true
+    );
+}
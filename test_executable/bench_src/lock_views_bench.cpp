@@ -0,0 +1,90 @@
+//
+// Created in October 2026
+//
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    
+    constexpr std::uint64_t account_count = 16;
+    
+    const unsigned thread_counts[] = {1, 2, 4, 8};
+    
+    /**
+     * Every thread moves balance between two accounts chosen from account_count,
+     * so that concurrent transfers lock overlapping pairs in both directions.
+     * @tparam transfer_t callable with (from weak_ptr, to weak_ptr) performing one transfer
+     */
+    template<typename transfer_t>
+    void register_transfer_cases(const std::string &name, transfer_t transfer)
+    {
+        for (unsigned thread_count: thread_counts)
+        {
+            bench::registrar(
+                    "lock_views/" + name + "/threads:" + std::to_string(thread_count),
+                    [thread_count, transfer](std::uint64_t iterations)
+                    {
+                        std::vector<referable_unique<std::int64_t>> accounts;
+                        std::vector<referable_unique<std::int64_t>::weak_ptr> weak_accounts;
+                        accounts.reserve(account_count);
+                        weak_accounts.reserve(account_count);
+                        for (std::uint64_t i = 0; i < account_count; ++i)
+                        {
+                            accounts.push_back(variable_util::make_referable_unique<std::int64_t>(1000));
+                            weak_accounts.emplace_back(accounts.back());
+                        }
+                        const std::uint64_t per_thread = iterations / thread_count + 1;
+                        bench::run_threads(
+                                thread_count,
+                                [&](unsigned thread_index)
+                                {
+                                    for (std::uint64_t i = 0; i < per_thread; ++i)
+                                    {
+                                        const std::uint64_t mixed = (i + thread_index) * 0x9e3779b97f4a7c15ull;
+                                        const std::uint64_t from = (mixed >> 60) % account_count;
+                                        const std::uint64_t to = (from + 1 + ((mixed >> 32) % (account_count - 1))) %
+                                                                 account_count;
+                                        transfer(weak_accounts[from], weak_accounts[to]);
+                                    }
+                                }
+                        );
+                        return per_thread * thread_count;
+                    }
+            );
+        }
+    }
+    
+    const bool transfer_cases_registered = (
+            register_transfer_cases(
+                    "ordered",
+                    [](const referable_unique<std::int64_t>::weak_ptr &from,
+                       const referable_unique<std::int64_t>::weak_ptr &to)
+                    {
+                        auto views = variable_util::lock_views(from, to);
+                        --*std::get<0>(*views);
+                        ++*std::get<1>(*views);
+                    }
+            ),
+            register_transfer_cases(
+                    "timed_back_off",
+                    [](const referable_unique<std::int64_t>::weak_ptr &from,
+                       const referable_unique<std::int64_t>::weak_ptr &to)
+                    {
+                        if (auto views = variable_util::lock_views(std::chrono::milliseconds(10), from, to); views)
+                        {
+                            --*std::get<0>(*views);
+                            ++*std::get<1>(*views);
+                        }
+                    }
+            ),
+            true
+    );
+}
@@ -0,0 +1,137 @@
+//
+// Created in October 2026
+//
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    using variable_util::referable_pool;
+    
+    constexpr std::uint32_t object_count = 65536;
+    
+    ///Number of references held by the memory cases, several per object
+    constexpr std::uint32_t reference_count = 1 << 20;
+    
+    ///Multiplicative step which visits the objects out of allocation order
+    constexpr std::uint64_t lookup_stride = 40503;
+    
+    ///Objects held by referable_unique, one allocation each
+    std::vector<referable_unique<std::uint64_t>> &unique_objects()
+    {
+        static std::vector<referable_unique<std::uint64_t>> objects = []()
+        {
+            std::vector<referable_unique<std::uint64_t>> created;
+            created.reserve(object_count);
+            for (std::uint32_t i = 0; i < object_count; ++i)
+                created.push_back(variable_util::make_referable_unique<std::uint64_t>(i));
+            return created;
+        }();
+        return objects;
+    }
+    
+    referable_pool<std::uint64_t> &pool_objects()
+    {
+        static referable_pool<std::uint64_t> pool(object_count);
+        return pool;
+    }
+    
+    std::vector<referable_pool<std::uint64_t>::handle> &pool_handles()
+    {
+        static std::vector<referable_pool<std::uint64_t>::handle> handles = []()
+        {
+            std::vector<referable_pool<std::uint64_t>::handle> created;
+            created.reserve(object_count);
+            for (std::uint32_t i = 0; i < object_count; ++i) created.push_back(pool_objects().emplace(i));
+            return created;
+        }();
+        return handles;
+    }
+    
+    /**
+     * Hold reference_count references and report the resident set with them.
+     * Objects are created before the references, so the difference between the two cases
+     * is the size of the references and the refcount traffic of copying them.
+     */
+    const bool memory_cases_registered = (
+            bench::registrar(
+                    "pool/memory/weak_ptr",
+                    [](std::uint64_t iterations)
+                    {
+                        auto &objects = unique_objects();
+                        for (std::uint64_t round = 0; round < iterations; round += reference_count)
+                        {
+                            std::vector<referable_unique<std::uint64_t>::weak_ptr> references;
+                            references.reserve(reference_count);
+                            for (std::uint32_t i = 0; i < reference_count; ++i)
+                                references.emplace_back(objects[i % object_count]);
+                            bench::sample_resident_set();
+                            bench::do_not_optimize(references.data());
+                        }
+                        return (iterations + reference_count - 1) / reference_count * reference_count;
+                    }
+            ),
+            bench::registrar(
+                    "pool/memory/handle",
+                    [](std::uint64_t iterations)
+                    {
+                        auto &handles = pool_handles();
+                        for (std::uint64_t round = 0; round < iterations; round += reference_count)
+                        {
+                            std::vector<referable_pool<std::uint64_t>::handle> references;
+                            references.reserve(reference_count);
+                            for (std::uint32_t i = 0; i < reference_count; ++i)
+                                references.push_back(handles[i % object_count]);
+                            bench::sample_resident_set();
+                            bench::do_not_optimize(references.data());
+                        }
+                        return (iterations + reference_count - 1) / reference_count * reference_count;
+                    }
+            ),
+            true
+    );
+    
+    /**
+     * Resolve a reference to a const_view and read the content,
+     * visiting the objects in an order which defeats the prefetcher
+     */
+    const bool lookup_cases_registered = (
+            bench::registrar(
+                    "pool/lookup/weak_ptr",
+                    [](std::uint64_t iterations)
+                    {
+                        std::vector<referable_unique<std::uint64_t>::weak_ptr> references;
+                        references.reserve(object_count);
+                        for (auto &object: unique_objects()) references.emplace_back(object);
+                        for (std::uint64_t i = 0; i < iterations; ++i)
+                        {
+                            auto content_view = references[i * lookup_stride % object_count].get_const_view();
+                            bench::do_not_optimize(**content_view);
+                        }
+                        return iterations;
+                    }
+            ),
+            bench::registrar(
+                    "pool/lookup/handle",
+                    [](std::uint64_t iterations)
+                    {
+                        auto &pool = pool_objects();
+                        const auto &references = pool_handles();
+                        for (std::uint64_t i = 0; i < iterations; ++i)
+                        {
+                            auto content_view = pool.try_get_const_view(references[i * lookup_stride % object_count]);
+                            bench::do_not_optimize(**content_view);
+                        }
+                        return iterations;
+                    }
+            ),
+            true
+    );
+}
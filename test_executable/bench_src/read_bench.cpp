@@ -0,0 +1,81 @@
+//
+// Created in October 2026
+//
+
+#include <cstdint>
+#include <string>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    
+    struct config
+    {
+        std::uint64_t values[8];
+    };
+    
+    const unsigned reader_thread_counts[] = {1, 2, 4, 8};
+    
+    /**
+     * Every thread reads one shared config through its own weak_ptr
+     * @tparam lock_policy lock policy of the shared config
+     * @tparam read_t callable with (weak_ptr &) performing one read
+     */
+    template<typename lock_policy = std::shared_timed_mutex, typename read_t>
+    void register_read_cases(const std::string &name, read_t read)
+    {
+        for (unsigned thread_count: reader_thread_counts)
+        {
+            bench::registrar(
+                    "read/" + name + "/threads:" + std::to_string(thread_count),
+                    [thread_count, read](std::uint64_t iterations)
+                    {
+                        auto object = variable_util::make_referable_unique<config, lock_policy>(config{});
+                        const typename referable_unique<config, lock_policy>::weak_ptr weak(object);
+                        const std::uint64_t per_thread = iterations / thread_count + 1;
+                        bench::run_threads(
+                                thread_count,
+                                [&](unsigned)
+                                {
+                                    typename referable_unique<config, lock_policy>::weak_ptr local(weak);
+                                    for (std::uint64_t i = 0; i < per_thread; ++i) read(local);
+                                }
+                        );
+                        return per_thread * thread_count;
+                    }
+            );
+        }
+    }
+    
+    const bool read_cases_registered = (
+            register_read_cases(
+                    "get_const_view",
+                    [](referable_unique<config>::weak_ptr &weak)
+                    {
+                        auto const_view = weak.get_const_view();
+                        bench::do_not_optimize((*const_view)->values[0]);
+                    }
+            ),
+            register_read_cases(
+                    "seqlock",
+                    [](referable_unique<config>::weak_ptr &weak)
+                    {
+                        bench::do_not_optimize(
+                                weak.read([](const config &snapshot) { return snapshot.values[0]; })
+                        );
+                    }
+            ),
+            register_read_cases<variable_util::rcu_policy>(
+                    "rcu_get_const_view",
+                    [](referable_unique<config, variable_util::rcu_policy>::weak_ptr &weak)
+                    {
+                        auto const_view = weak.get_const_view();
+                        bench::do_not_optimize((*const_view)->values[0]);
+                    }
+            ),
+            true
+    );
+}
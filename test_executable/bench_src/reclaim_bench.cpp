@@ -0,0 +1,102 @@
+//
+// Created in October 2026
+//
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    using variable_util::deferred_reclaimer;
+    
+    ///Content whose destructor frees entry_count blocks
+    struct large_content
+    {
+        std::vector<std::unique_ptr<std::uint64_t>> entries;
+        
+        explicit large_content(std::size_t entry_count)
+        {
+            entries.reserve(entry_count);
+            for (std::size_t i = 0; i < entry_count; ++i) entries.push_back(std::make_unique<std::uint64_t>(i));
+        }
+    };
+    
+    constexpr std::size_t entry_count = 16384;
+    
+    ///One request in replace_interval also replaces the content, releasing the previous one
+    constexpr std::uint64_t replace_interval = 64;
+    
+    enum class reclaim_mode
+    {
+        synchronous, drain_between_requests, background_thread
+    };
+    
+    /**
+     * Requests update the content through a view and record their latency.
+     * The replacement content is built before the request is timed,
+     * so the timed part of a replacing request is the release of the previous content.
+     */
+    void register_reclaim_case(const std::string &name, reclaim_mode mode)
+    {
+        bench::registrar(
+                "reclaim/" + name,
+                [mode](std::uint64_t iterations)
+                {
+                    auto make_content = [mode]()
+                    {
+                        return mode == reclaim_mode::synchronous ?
+                               variable_util::make_referable_unique<large_content>(entry_count) :
+                               variable_util::make_deferred_referable_unique<large_content>(entry_count);
+                    };
+                    deferred_reclaimer &reclaimer = deferred_reclaimer::instance();
+                    if (mode == reclaim_mode::background_thread) reclaimer.start();
+                    /// owners are held by std::unique_ptr rather than std::optional,
+                    /// which GCC reports as maybe uninitialized once the loop is inlined
+                    auto live = std::make_unique<referable_unique<large_content>>(make_content());
+                    std::unique_ptr<referable_unique<large_content>> next;
+                    for (std::uint64_t i = 0; i < iterations; ++i)
+                    {
+                        const bool replacing = i % replace_interval == replace_interval - 1;
+                        if (replacing) next = std::make_unique<referable_unique<large_content>>(make_content());
+                        const auto start = std::chrono::steady_clock::now();
+                        {
+                            referable_unique<large_content>::weak_ptr weak(*live);
+                            auto content_view = weak.get_view();
+                            *(*content_view)->entries[i % entry_count] += i;
+                        }
+                        if (replacing)
+                        {
+                            /// only the release of the content is timed, the moved from owner is freed later
+                            referable_unique<large_content> released(std::move(*live));
+                        }
+                        const auto stop = std::chrono::steady_clock::now();
+                        if (replacing) live = std::move(next);
+                        bench::record_latency(
+                                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                        stop - start
+                                ).count()
+                        );
+                        if (replacing && mode == reclaim_mode::drain_between_requests) reclaimer.drain();
+                    }
+                    live.reset();
+                    if (mode == reclaim_mode::background_thread) reclaimer.stop();
+                    reclaimer.drain();
+                    return iterations;
+                }
+        );
+    }
+    
+    const bool reclaim_cases_registered = (
+            register_reclaim_case("synchronous", reclaim_mode::synchronous),
+            register_reclaim_case("deferred/drain_between_requests", reclaim_mode::drain_between_requests),
+            register_reclaim_case("deferred/background_thread", reclaim_mode::background_thread),
+            true
+    );
+}
@@ -0,0 +1,178 @@
+//
+// Created in October 2026
+//
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    using variable_util::referable_tag;
+    
+    struct order
+    {
+        std::uint64_t values[4];
+        
+        explicit order(std::uint64_t seed) : values{seed, seed + 1, seed + 2, seed + 3}
+        {}
+    };
+    
+    const unsigned thread_counts[] = {1, 2, 4, 8, 16, 32, 64};
+    
+    ///Live objects kept by each thread, the oldest one expires on every insertion
+    constexpr std::uint64_t live_per_thread = 16;
+    
+    ///One operation in lookup_ratio inserts, the others look up
+    constexpr std::uint64_t lookup_ratio = 8;
+    
+    inline std::uint64_t id_of(std::uint64_t thread_index, std::uint64_t serial) noexcept
+    {
+        return (thread_index << 32) | serial;
+    }
+    
+    /**
+     * Id of a recently inserted object of some thread, or of an expired one
+     */
+    inline std::uint64_t lookup_id(std::uint64_t i, unsigned thread_count, std::uint64_t serial) noexcept
+    {
+        const std::uint64_t mixed = i * 0x9e3779b97f4a7c15ull;
+        const std::uint64_t target_serial = serial > live_per_thread * 2 ?
+                                            serial - (mixed >> 59) : serial;
+        return id_of((mixed >> 32) % thread_count, target_serial);
+    }
+    
+    /**
+     * Every thread inserts objects with fresh ids, expires its oldest object
+     * and looks up ids of every thread in between.
+     * @tparam store_t storage with insert(serial, id), expire(slot) and lookup(id) for one thread
+     */
+    template<typename store_t>
+    void register_registry_cases(const std::string &name)
+    {
+        for (unsigned thread_count: thread_counts)
+        {
+            bench::registrar(
+                    "registry/" + name + "/threads:" + std::to_string(thread_count),
+                    [thread_count](std::uint64_t iterations)
+                    {
+                        const std::uint64_t per_thread = iterations / thread_count + 1;
+                        bench::run_threads(
+                                thread_count,
+                                [&](unsigned thread_index)
+                                {
+                                    store_t store;
+                                    std::uint64_t serial = 0;
+                                    for (std::uint64_t i = 0; i < per_thread; ++i)
+                                    {
+                                        if (i % lookup_ratio == 0)
+                                        {
+                                            store.insert(serial % live_per_thread, id_of(thread_index, serial));
+                                            ++serial;
+                                        }
+                                        else
+                                            bench::do_not_optimize(
+                                                    store.lookup(lookup_id(i, thread_count, serial))
+                                            );
+                                    }
+                                }
+                        );
+                        return per_thread * thread_count;
+                    }
+            );
+        }
+    }
+    
+    ///Objects registered to referable_registry by their constructors
+    class registry_store final
+    {
+    private:
+        using registry = variable_util::referable_registry<order, std::shared_timed_mutex>;
+        
+        std::unique_ptr<referable_unique<order>> live[live_per_thread];
+    
+    public:
+        void insert(std::uint64_t slot, std::uint64_t id)
+        {
+            live[slot] = std::make_unique<referable_unique<order>>(
+                    variable_util::make_tagged_referable_unique<order>(id, referable_tag(), id)
+            );
+        }
+        
+        bool lookup(std::uint64_t id)
+        {
+            return registry::instance().find(id).has_value();
+        }
+    };
+    
+    ///The hand-written index the registry replaces, one unordered_map under a global mutex
+    class global_mutex_store final
+    {
+    private:
+        struct index
+        {
+            std::mutex guard;
+            std::unordered_map<std::uint64_t, referable_unique<order>::weak_ptr> entries;
+        };
+        
+        static index &shared_index()
+        {
+            static index instance;
+            return instance;
+        }
+        
+        std::unique_ptr<referable_unique<order>> live[live_per_thread];
+        std::uint64_t live_ids[live_per_thread] = {};
+    
+    public:
+        void insert(std::uint64_t slot, std::uint64_t id)
+        {
+            index &target = shared_index();
+            if (live[slot])
+            {
+                std::lock_guard<std::mutex> index_lock(target.guard);
+                target.entries.erase(live_ids[slot]);
+            }
+            live[slot] = std::make_unique<referable_unique<order>>(
+                    variable_util::make_referable_unique<order>(id)
+            );
+            live_ids[slot] = id;
+            std::lock_guard<std::mutex> index_lock(target.guard);
+            target.entries.try_emplace(id, *live[slot]);
+        }
+        
+        bool lookup(std::uint64_t id)
+        {
+            index &target = shared_index();
+            std::lock_guard<std::mutex> index_lock(target.guard);
+            if (auto found = target.entries.find(id); found != target.entries.end())
+            {
+                referable_unique<order>::weak_ptr handle(found->second);
+                return true;
+            }
+            return false;
+        }
+        
+        ~global_mutex_store()
+        {
+            index &target = shared_index();
+            std::lock_guard<std::mutex> index_lock(target.guard);
+            for (std::uint64_t slot = 0; slot < live_per_thread; ++slot)
+            {
+                if (live[slot]) target.entries.erase(live_ids[slot]);
+            }
+        }
+    };
+    
+    const bool registry_cases_registered = (
+            register_registry_cases<global_mutex_store>("global_mutex_map"),
+            register_registry_cases<registry_store>("referable_registry"),
+            true
+    );
+}
@@ -0,0 +1,106 @@
+//
+// Created in October 2026
+//
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    
+    ///Routes of the table, looked up by every read
+    using route_table = std::unordered_map<std::uint64_t, std::uint64_t>;
+    
+    constexpr std::uint64_t route_count = 4096;
+    
+    ///One operation in write_interval replaces a route through a view
+    constexpr std::uint64_t write_interval = 4096;
+    
+    const unsigned thread_counts[] = {1, 4, 16};
+    
+    /**
+     * Pin the calling thread to one CPU, spreading consecutive thread indexes over the CPUs
+     * so that threads of a run land on every NUMA node
+     */
+    void pin_thread(unsigned thread_index)
+    {
+#if defined(__linux__)
+        const unsigned cpu_count = std::max(1u, std::thread::hardware_concurrency());
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(thread_index % cpu_count, &cpu_set);
+        sched_setaffinity(0, sizeof(cpu_set), &cpu_set);
+#else
+        (void) thread_index;
+#endif
+    }
+    
+    route_table make_routes()
+    {
+        route_table routes;
+        for (std::uint64_t key = 0; key < route_count; ++key) routes.emplace(key, key * 2654435761u);
+        return routes;
+    }
+    
+    /**
+     * Read-mostly lookups in a shared route table from threads pinned across the CPUs
+     * @tparam lock_policy
+     */
+    template<typename lock_policy>
+    void register_replicated_cases(const std::string &name)
+    {
+        for (unsigned thread_count: thread_counts)
+        {
+            bench::registrar(
+                    "replicated/" + name + "/threads:" + std::to_string(thread_count),
+                    [thread_count](std::uint64_t iterations)
+                    {
+                        referable_unique<route_table, lock_policy> object(
+                                std::in_place, variable_util::referable_tag(), variable_util::referable_tag(),
+                                make_routes()
+                        );
+                        const std::uint64_t per_thread = iterations / thread_count + 1;
+                        bench::run_threads(
+                                thread_count,
+                                [&](unsigned thread_index)
+                                {
+                                    pin_thread(thread_index);
+                                    typename referable_unique<route_table, lock_policy>::weak_ptr weak(object);
+                                    for (std::uint64_t i = 0; i < per_thread; ++i)
+                                    {
+                                        const std::uint64_t key = (i * 40503 + thread_index) % route_count;
+                                        if (i % write_interval == write_interval - 1)
+                                        {
+                                            auto content_view = weak.get_view();
+                                            (**content_view)[key] = i;
+                                        }
+                                        else
+                                        {
+                                            auto content_view = weak.get_const_view();
+                                            bench::do_not_optimize((*content_view)->find(key)->second);
+                                        }
+                                    }
+                                }
+                        );
+                        return per_thread * thread_count;
+                    }
+            );
+        }
+    }
+    
+    const bool replicated_cases_registered = (
+            register_replicated_cases<VARIABLE_UTIL_DEFAULT_LOCK_POLICY>("shared"),
+            register_replicated_cases<variable_util::numa_replicated_policy<>>("numa_replicated"),
+            true
+    );
+}
@@ -0,0 +1,146 @@
+//
+// Created in October 2026
+//
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    using variable_util::referable_tag;
+    
+    ///Trivially copyable content of word_count words
+    template<std::size_t word_count>
+    struct record
+    {
+        std::array<std::uint64_t, word_count> words;
+    };
+    
+    ///Objects of one snapshot
+    constexpr std::uint32_t object_count = 16384;
+    
+    ///Rebuild an object the way a restart without snapshot would, from its index
+    template<std::size_t word_count>
+    referable_unique<record<word_count>> reconstruct(std::uint32_t index)
+    {
+        record<word_count> content{};
+        std::uint64_t word = index;
+        for (auto &current: content.words) current = word = word * 6364136223846793005ull + 1442695040888963407ull;
+        return variable_util::make_tagged_referable_unique<record<word_count>>(
+                referable_tag(index), referable_tag("snapshot bench record"), content
+        );
+    }
+    
+    template<std::size_t word_count>
+    std::vector<referable_unique<record<word_count>>> &source_objects()
+    {
+        static std::vector<referable_unique<record<word_count>>> objects = []()
+        {
+            std::vector<referable_unique<record<word_count>>> created;
+            created.reserve(object_count);
+            for (std::uint32_t i = 0; i < object_count; ++i) created.push_back(reconstruct<word_count>(i));
+            return created;
+        }();
+        return objects;
+    }
+    
+    ///Snapshot file of source_objects, written once and removed at exit
+    template<std::size_t word_count>
+    const std::string &snapshot_path()
+    {
+        struct snapshot_file final
+        {
+            std::string path;
+            
+            inline explicit snapshot_file() :
+                    path(std::string(std::getenv("TMPDIR") ? std::getenv("TMPDIR") : "/tmp") +
+                         "/variable_util_snapshot_bench_" + std::to_string(word_count) + ".bin")
+            {
+                variable_util::write_referable_snapshot(path, source_objects<word_count>());
+            }
+            
+            inline ~snapshot_file()
+            {
+                std::remove(path.c_str());
+            }
+        };
+        static snapshot_file file;
+        return file.path;
+    }
+    
+    /**
+     * Startup cost per tagged object: rebuilding every object, against restoring them from a snapshot file
+     * with untouched pages or reading one word of every object after restoring.
+     * The snapshot file stays in the page cache, so the restore cases do not include disk reads.
+     */
+    template<std::size_t word_count>
+    void register_snapshot_cases()
+    {
+        const std::string size = "/bytes:" + std::to_string(sizeof(record<word_count>));
+        bench::registrar(
+                "snapshot/reconstruct" + size,
+                [](std::uint64_t iterations)
+                {
+                    for (std::uint64_t round = 0; round < iterations; round += object_count)
+                    {
+                        std::vector<referable_unique<record<word_count>>> objects;
+                        objects.reserve(object_count);
+                        for (std::uint32_t i = 0; i < object_count; ++i)
+                            objects.push_back(reconstruct<word_count>(i));
+                        bench::do_not_optimize(objects.data());
+                    }
+                    return (iterations + object_count - 1) / object_count * object_count;
+                }
+        );
+        bench::registrar(
+                "snapshot/write" + size,
+                [](std::uint64_t iterations)
+                {
+                    const std::string &path = snapshot_path<word_count>();
+                    for (std::uint64_t round = 0; round < iterations; round += object_count)
+                        variable_util::write_referable_snapshot(path, source_objects<word_count>());
+                    return (iterations + object_count - 1) / object_count * object_count;
+                }
+        );
+        bench::registrar(
+                "snapshot/restore" + size,
+                [](std::uint64_t iterations)
+                {
+                    const std::string &path = snapshot_path<word_count>();
+                    for (std::uint64_t round = 0; round < iterations; round += object_count)
+                    {
+                        auto objects = variable_util::restore_referable_snapshot<record<word_count>>(path);
+                        bench::do_not_optimize(objects.data());
+                    }
+                    return (iterations + object_count - 1) / object_count * object_count;
+                }
+        );
+        bench::registrar(
+                "snapshot/restore_and_read" + size,
+                [](std::uint64_t iterations)
+                {
+                    const std::string &path = snapshot_path<word_count>();
+                    for (std::uint64_t round = 0; round < iterations; round += object_count)
+                    {
+                        auto objects = variable_util::restore_referable_snapshot<record<word_count>>(path);
+                        for (auto &object: objects) bench::do_not_optimize(object->words[0]);
+                    }
+                    return (iterations + object_count - 1) / object_count * object_count;
+                }
+        );
+    }
+    
+    const bool snapshot_cases_registered = (
+            register_snapshot_cases<128>(),
+            register_snapshot_cases<2048>(),
+            true
+    );
+}
@@ -0,0 +1,99 @@
+//
+// Created in October 2026
+//
+
+#include <cstdint>
+#include <string>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    
+    ///Trivially copyable, but std::atomic of it is not lock-free on common targets
+    struct pair_content
+    {
+        std::uint64_t first, second;
+    };
+    
+    const unsigned thread_counts[] = {1, 4};
+    
+    ///One operation in write_ratio takes a view, the others a const_view
+    constexpr std::uint64_t write_ratio = 16;
+    
+    inline void modify(std::int64_t &content, std::uint64_t i) noexcept
+    {
+        content += i;
+    }
+    
+    inline void modify(pair_content &content, std::uint64_t i) noexcept
+    {
+        content.first += i;
+        content.second += i;
+    }
+    
+    inline std::uint64_t observe(const std::int64_t &content) noexcept
+    {
+        return content;
+    }
+    
+    inline std::uint64_t observe(const pair_content &content) noexcept
+    {
+        return content.first ^ content.second;
+    }
+    
+    /**
+     * Read-mostly access through weak_ptr with the mutex of VARIABLE_UTIL_DEFAULT_LOCK_POLICY
+     * and with the storage picked by storage_policy_t
+     * @tparam content_t std::int64_t or pair_content
+     * @tparam lock_policy
+     */
+    template<typename content_t, typename lock_policy>
+    void register_storage_cases(const std::string &name)
+    {
+        for (unsigned thread_count: thread_counts)
+        {
+            bench::registrar(
+                    "storage/" + name + "/threads:" + std::to_string(thread_count),
+                    [thread_count](std::uint64_t iterations)
+                    {
+                        referable_unique<content_t, lock_policy> object(
+                                std::in_place, variable_util::referable_tag(), variable_util::referable_tag()
+                        );
+                        const std::uint64_t per_thread = iterations / thread_count + 1;
+                        bench::run_threads(
+                                thread_count,
+                                [&](unsigned)
+                                {
+                                    typename referable_unique<content_t, lock_policy>::weak_ptr weak(object);
+                                    for (std::uint64_t i = 0; i < per_thread; ++i)
+                                    {
+                                        if (i % write_ratio == 0)
+                                        {
+                                            auto content_view = weak.get_view();
+                                            modify(**content_view, i);
+                                        }
+                                        else
+                                        {
+                                            auto content_view = weak.get_const_view();
+                                            bench::do_not_optimize(observe(**content_view));
+                                        }
+                                    }
+                                }
+                        );
+                        return per_thread * thread_count;
+                    }
+            );
+        }
+    }
+    
+    const bool storage_cases_registered = (
+            register_storage_cases<std::int64_t, VARIABLE_UTIL_DEFAULT_LOCK_POLICY>("int64/mutex"),
+            register_storage_cases<std::int64_t, variable_util::storage_policy_t<std::int64_t>>("int64/automatic"),
+            register_storage_cases<pair_content, VARIABLE_UTIL_DEFAULT_LOCK_POLICY>("pair/mutex"),
+            register_storage_cases<pair_content, variable_util::storage_policy_t<pair_content>>("pair/automatic"),
+            true
+    );
+}
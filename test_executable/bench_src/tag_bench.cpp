@@ -0,0 +1,75 @@
+//
+// Created in October 2026
+//
+
+#include <any>
+#include <cstdint>
+#include <string>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_tag;
+    
+    bench::registrar referable_tag_construction(
+            "tag/construct/referable_tag/16_bytes",
+            [](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    referable_tag tag("order-0000000001");
+                    bench::do_not_optimize(tag);
+                }
+                return iterations;
+            }
+    );
+    
+    bench::registrar any_construction(
+            "tag/construct/std::any/16_bytes",
+            [](std::uint64_t iterations)
+            {
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    std::any tag(std::string("order-0000000001"));
+                    bench::do_not_optimize(tag);
+                }
+                return iterations;
+            }
+    );
+    
+    bench::registrar referable_tag_comparison(
+            "tag/compare/referable_tag",
+            [](std::uint64_t iterations)
+            {
+                const referable_tag tag("order-0000000001"), another(std::string("order-0000000001"));
+                std::uint64_t equal_count = 0;
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    bench::do_not_optimize(tag);
+                    equal_count += (tag == another);
+                }
+                bench::do_not_optimize(equal_count);
+                return iterations;
+            }
+    );
+    
+    bench::registrar any_comparison(
+            "tag/compare/std::any",
+            [](std::uint64_t iterations)
+            {
+                const std::any tag(std::string("order-0000000001")), another(std::string("order-0000000001"));
+                std::uint64_t equal_count = 0;
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    bench::do_not_optimize(tag);
+                    const auto *string = std::any_cast<std::string>(&tag);
+                    const auto *another_string = std::any_cast<std::string>(&another);
+                    equal_count += (string && another_string && *string == *another_string);
+                }
+                bench::do_not_optimize(equal_count);
+                return iterations;
+            }
+    );
+}
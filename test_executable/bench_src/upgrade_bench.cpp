@@ -0,0 +1,119 @@
+//
+// Created in October 2026
+//
+
+#include <cstdint>
+#include <string>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    using variable_util::futex_shared_mutex;
+    
+    struct inventory
+    {
+        std::uint64_t counts[8];
+    };
+    
+    using shared_inventory = referable_unique<inventory, futex_shared_mutex>;
+    
+    const unsigned thread_counts[] = {1, 2, 4, 8};
+    
+    ///One operation in decision_interval reads, decides and maybe writes, the others only read
+    constexpr std::uint64_t decision_interval = 8;
+    
+    ///One decision in write_interval decides to write
+    constexpr std::uint64_t write_interval = 4;
+    
+    inline std::uint64_t read_work(const inventory &content) noexcept
+    {
+        std::uint64_t total = 0;
+        for (std::uint64_t count: content.counts) total += count;
+        return total;
+    }
+    
+    inline bool decide(const inventory &content, std::uint64_t i) noexcept
+    {
+        bench::do_not_optimize(read_work(content));
+        return i % (decision_interval * write_interval) == 0;
+    }
+    
+    ///Take the exclusive lock up front for every decision
+    struct exclusive_up_front
+    {
+        static void decide_and_write(shared_inventory::weak_ptr &weak, std::uint64_t i)
+        {
+            auto view = weak.get_view();
+            if (decide(**view, i)) ++(*view)->counts[i % 8];
+        }
+    };
+    
+    ///Decide under a const_view, then relock exclusively and decide again
+    struct relock
+    {
+        static void decide_and_write(shared_inventory::weak_ptr &weak, std::uint64_t i)
+        {
+            if (!decide(**weak.get_const_view(), i)) return;
+            auto view = weak.get_view();
+            if (decide(**view, i)) ++(*view)->counts[i % 8];
+        }
+    };
+    
+    ///Decide under an upgradable_view, promoted only to write
+    struct upgradable
+    {
+        static void decide_and_write(shared_inventory::weak_ptr &weak, std::uint64_t i)
+        {
+            auto upgradable_view = weak.get_upgradable_view();
+            if (!decide(**upgradable_view, i)) return;
+            auto view = upgradable_view->upgrade();
+            ++view->counts[i % 8];
+        }
+    };
+    
+    /**
+     * Every thread mostly reads one shared object through const_views,
+     * and reads, decides and maybe writes with strategy_t in between
+     * @tparam strategy_t exclusive_up_front, relock or upgradable
+     */
+    template<typename strategy_t>
+    void register_upgrade_cases(const std::string &name)
+    {
+        for (unsigned thread_count: thread_counts)
+        {
+            bench::registrar(
+                    "upgrade/" + name + "/threads:" + std::to_string(thread_count),
+                    [thread_count](std::uint64_t iterations)
+                    {
+                        shared_inventory object =
+                                variable_util::make_referable_unique<inventory, futex_shared_mutex>(inventory{});
+                        const shared_inventory::weak_ptr weak(object);
+                        const std::uint64_t per_thread = iterations / thread_count + 1;
+                        bench::run_threads(
+                                thread_count,
+                                [&](unsigned thread_index)
+                                {
+                                    shared_inventory::weak_ptr local(weak);
+                                    for (std::uint64_t i = thread_index; i < per_thread + thread_index; ++i)
+                                    {
+                                        if (i % decision_interval == 0) strategy_t::decide_and_write(local, i);
+                                        else bench::do_not_optimize(read_work(**local.get_const_view()));
+                                    }
+                                }
+                        );
+                        return per_thread * thread_count;
+                    }
+            );
+        }
+    }
+    
+    const bool upgrade_cases_registered = (
+            register_upgrade_cases<exclusive_up_front>("exclusive_up_front"),
+            register_upgrade_cases<relock>("relock"),
+            register_upgrade_cases<upgradable>("upgradable"),
+            true
+    );
+}
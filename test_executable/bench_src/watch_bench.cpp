@@ -0,0 +1,102 @@
+//
+// Created in October 2026
+//
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    
+    enum class watch_mode
+    {
+        wait_for_change, subscribe, poll
+    };
+    
+    ///Interval between two get_const_view of the polling watcher
+    constexpr std::chrono::microseconds poll_interval(1000);
+    
+    inline std::uint64_t now_nanoseconds() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+        ).count();
+    }
+    
+    /**
+     * A writer publishes one change at a time and waits until the watcher has seen it.
+     * The recorded latency is from the release of the view to the watcher noticing the change.
+     */
+    void register_watch_case(const std::string &name, watch_mode mode)
+    {
+        bench::registrar(
+                "watch/" + name,
+                [mode](std::uint64_t iterations)
+                {
+                    auto object = variable_util::make_referable_unique<std::uint64_t>(0);
+                    referable_unique<std::uint64_t>::weak_ptr weak(object);
+                    std::atomic<std::uint64_t> released_at(0), acknowledged(0);
+                    auto acknowledge = [&](std::uint64_t change)
+                    {
+                        bench::record_latency(now_nanoseconds() - released_at.load(std::memory_order_acquire));
+                        acknowledged.store(change, std::memory_order_release);
+                    };
+                    const variable_util::subscription watcher_subscription(
+                            mode == watch_mode::subscribe ? weak.subscribe(acknowledge) : variable_util::subscription()
+                    );
+                    bench::run_threads(
+                            mode == watch_mode::subscribe ? 1 : 2,
+                            [&](unsigned thread_index)
+                            {
+                                if (thread_index == 0)
+                                {
+                                    for (std::uint64_t change = 1; change <= iterations; ++change)
+                                    {
+                                        {
+                                            auto content_view = weak.get_view();
+                                            **content_view = change;
+                                            released_at.store(now_nanoseconds(), std::memory_order_release);
+                                        }
+                                        while (acknowledged.load(std::memory_order_acquire) != change)
+                                            std::this_thread::yield();
+                                    }
+                                }
+                                else if (mode == watch_mode::wait_for_change)
+                                {
+                                    std::uint64_t version = *weak.version();
+                                    for (std::uint64_t change = 1; change <= iterations; ++change)
+                                    {
+                                        version = weak.wait_for_change(version).version();
+                                        acknowledge(change);
+                                    }
+                                }
+                                else
+                                {
+                                    for (std::uint64_t change = 1; change <= iterations;)
+                                    {
+                                        std::this_thread::sleep_for(poll_interval);
+                                        auto content_view = weak.get_const_view();
+                                        if (**content_view == change) acknowledge(change++);
+                                    }
+                                }
+                            }
+                    );
+                    return iterations;
+                }
+        );
+    }
+    
+    const bool watch_cases_registered = (
+            register_watch_case("wait_for_change", watch_mode::wait_for_change),
+            register_watch_case("subscribe", watch_mode::subscribe),
+            register_watch_case("poll_1ms", watch_mode::poll),
+            true
+    );
+}
@@ -0,0 +1,165 @@
+//
+// Created in October 2026
+//
+
+#include <atomic>
+#include <cstdint>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    
+    bench::registrar weak_ptr_copy(
+            "weak_ptr/copy",
+            [](std::uint64_t iterations)
+            {
+                auto object = variable_util::make_referable_unique<std::uint64_t>(0);
+                const referable_unique<std::uint64_t>::weak_ptr weak(object);
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    referable_unique<std::uint64_t>::weak_ptr copy(weak);
+                    bench::do_not_optimize(copy);
+                }
+                return iterations;
+            }
+    );
+    
+    bench::registrar weak_ptr_assign(
+            "weak_ptr/assign",
+            [](std::uint64_t iterations)
+            {
+                auto object = variable_util::make_referable_unique<std::uint64_t>(0);
+                auto another_object = variable_util::make_referable_unique<std::uint64_t>(1);
+                const referable_unique<std::uint64_t>::weak_ptr weak(object), another_weak(another_object);
+                referable_unique<std::uint64_t>::weak_ptr target(weak);
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    target = (i & 1) ? weak : another_weak;
+                    bench::do_not_optimize(target);
+                }
+                return iterations;
+            }
+    );
+    
+    bench::registrar atomic_weak_ptr_load(
+            "atomic/weak_ptr/load",
+            [](std::uint64_t iterations)
+            {
+                referable_unique<std::atomic<std::uint64_t>> object(std::uint64_t(0));
+                referable_unique<std::atomic<std::uint64_t>>::weak_ptr weak(object);
+                for (std::uint64_t i = 0; i < iterations; ++i) bench::do_not_optimize(*weak);
+                return iterations;
+            }
+    );
+    
+    bench::registrar atomic_weak_ptr_store(
+            "atomic/weak_ptr/store",
+            [](std::uint64_t iterations)
+            {
+                referable_unique<std::atomic<std::uint64_t>> object(std::uint64_t(0));
+                referable_unique<std::atomic<std::uint64_t>>::weak_ptr weak(object);
+                for (std::uint64_t i = 0; i < iterations; ++i) bench::do_not_optimize(weak = i);
+                return iterations;
+            }
+    );
+    
+    bench::registrar atomic_owner_load(
+            "atomic/owner/load",
+            [](std::uint64_t iterations)
+            {
+                const referable_unique<std::atomic<std::uint64_t>> object(std::uint64_t(0));
+                for (std::uint64_t i = 0; i < iterations; ++i) bench::do_not_optimize(*object);
+                return iterations;
+            }
+    );
+    
+    bench::registrar atomic_owner_store(
+            "atomic/owner/store",
+            [](std::uint64_t iterations)
+            {
+                referable_unique<std::atomic<std::uint64_t>> object(std::uint64_t(0));
+                for (std::uint64_t i = 0; i < iterations; ++i) bench::do_not_optimize(object = i);
+                return iterations;
+            }
+    );
+    
+    bench::registrar atomic_owner_store_relaxed(
+            "atomic/owner/store_relaxed",
+            [](std::uint64_t iterations)
+            {
+                referable_unique<std::atomic<std::uint64_t>> object(std::uint64_t(0));
+                for (std::uint64_t i = 0; i < iterations; ++i) object.store(i, std::memory_order_relaxed);
+                bench::do_not_optimize(*object);
+                return iterations;
+            }
+    );
+    
+    bench::registrar atomic_owner_fetch_add_relaxed(
+            "atomic/owner/fetch_add_relaxed",
+            [](std::uint64_t iterations)
+            {
+                referable_unique<std::atomic<std::uint64_t>> object(std::uint64_t(0));
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                    bench::do_not_optimize(object.fetch_add(1, std::memory_order_relaxed));
+                return iterations;
+            }
+    );
+    
+    bench::registrar atomic_weak_ptr_fetch_add_relaxed(
+            "atomic/weak_ptr/fetch_add_relaxed",
+            [](std::uint64_t iterations)
+            {
+                referable_unique<std::atomic<std::uint64_t>> object(std::uint64_t(0));
+                const referable_unique<std::atomic<std::uint64_t>>::weak_ptr weak(object);
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                    bench::do_not_optimize(weak.fetch_add(1, std::memory_order_relaxed));
+                return iterations;
+            }
+    );
+    
+    ///4 read-modify-writes per operation, each locking the control block
+    bench::registrar atomic_weak_ptr_separate_4(
+            "atomic/weak_ptr/separate_4",
+            [](std::uint64_t iterations)
+            {
+                referable_unique<std::atomic<std::uint64_t>> object(std::uint64_t(0));
+                const referable_unique<std::atomic<std::uint64_t>>::weak_ptr weak(object);
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    weak.fetch_add(1, std::memory_order_relaxed);
+                    weak.fetch_or(2, std::memory_order_relaxed);
+                    weak.fetch_and(~std::uint64_t(4), std::memory_order_relaxed);
+                    bench::do_not_optimize(weak.fetch_sub(1, std::memory_order_relaxed));
+                }
+                return iterations;
+            }
+    );
+    
+    ///the same 4 read-modify-writes locking the control block once
+    bench::registrar atomic_weak_ptr_batch_4(
+            "atomic/weak_ptr/batch_4",
+            [](std::uint64_t iterations)
+            {
+                referable_unique<std::atomic<std::uint64_t>> object(std::uint64_t(0));
+                const referable_unique<std::atomic<std::uint64_t>>::weak_ptr weak(object);
+                for (std::uint64_t i = 0; i < iterations; ++i)
+                {
+                    bench::do_not_optimize(
+                            weak.batch(
+                                    [](std::atomic<std::uint64_t> &content)
+                                    {
+                                        content.fetch_add(1, std::memory_order_relaxed);
+                                        content.fetch_or(2, std::memory_order_relaxed);
+                                        content.fetch_and(~std::uint64_t(4), std::memory_order_relaxed);
+                                        return content.fetch_sub(1, std::memory_order_relaxed);
+                                    }
+                            )
+                    );
+                }
+                return iterations;
+            }
+    );
+}
@@ -0,0 +1,202 @@
+//
+// Created in October 2026
+//
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "variable_util/variable_util.hpp"
+#include "bench.hpp"
+
+namespace
+{
+    using variable_util::referable_unique;
+    using variable_util::awaitable_mutex;
+    
+    struct account
+    {
+        std::uint64_t balance;
+    };
+    
+    using shared_account = referable_unique<account, awaitable_mutex<>>;
+    
+    ///Work done while the view is held, so that waiters queue up behind a slow writer
+    inline void hold_work(account &content) noexcept
+    {
+        for (unsigned step = 0; step < 64; ++step) bench::do_not_optimize(content.balance += step);
+    }
+    
+    /**
+     * Fixed pool of executor threads running posted functions in order
+     */
+    class thread_pool final
+    {
+    private:
+        std::mutex queue_guard;
+        std::condition_variable queue_changed;
+        std::deque<std::function<void()>> queue;
+        bool stopping = false;
+        std::vector<std::thread> workers;
+    
+    public:
+        explicit thread_pool(unsigned worker_count)
+        {
+            for (unsigned index = 0; index < worker_count; ++index)
+            {
+                workers.emplace_back(
+                        [this]()
+                        {
+                            while (true)
+                            {
+                                std::function<void()> function;
+                                {
+                                    std::unique_lock<std::mutex> queue_lock(queue_guard);
+                                    queue_changed.wait(queue_lock, [this]() { return stopping || !queue.empty(); });
+                                    if (queue.empty()) return;
+                                    function = std::move(queue.front());
+                                    queue.pop_front();
+                                }
+                                function();
+                            }
+                        }
+                );
+            }
+        }
+        
+        ~thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> queue_lock(queue_guard);
+                stopping = true;
+            }
+            queue_changed.notify_all();
+            for (auto &worker: workers) worker.join();
+        }
+        
+        void post(std::function<void()> function)
+        {
+            {
+                std::lock_guard<std::mutex> queue_lock(queue_guard);
+                queue.push_back(std::move(function));
+            }
+            queue_changed.notify_one();
+        }
+    };
+    
+    ///Coroutine started eagerly and destroyed when it finishes
+    struct detached_task
+    {
+        struct promise_type
+        {
+            detached_task get_return_object() noexcept
+            {
+                return {};
+            }
+            
+            std::suspend_never initial_suspend() noexcept
+            {
+                return {};
+            }
+            
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+            
+            void return_void() noexcept
+            {}
+            
+            void unhandled_exception() noexcept
+            {
+                std::terminate();
+            }
+        };
+    };
+    
+    detached_task update_account(
+            const shared_account::weak_ptr &weak, thread_pool &pool,
+            std::uint64_t update_count, std::atomic<std::uint64_t> &finished_count
+    )
+    {
+        const auto executor = [&pool](std::function<void()> function) { pool.post(std::move(function)); };
+        for (std::uint64_t i = 0; i < update_count; ++i)
+        {
+            auto result = co_await weak.async_view(executor);
+            hold_work(**result);
+        }
+        finished_count.fetch_add(1, std::memory_order_release);
+    }
+    
+    constexpr unsigned executor_thread_count = 4;
+    
+    /**
+     * waiter_count coroutines on executor_thread_count threads update one shared account
+     */
+    void register_coroutine_case(std::uint64_t waiter_count)
+    {
+        bench::registrar(
+                "coroutine/async_view/coroutines:" + std::to_string(waiter_count),
+                [waiter_count](std::uint64_t iterations)
+                {
+                    shared_account object = variable_util::make_referable_unique<account, awaitable_mutex<>>(
+                            account{0}
+                    );
+                    const shared_account::weak_ptr weak(object);
+                    const std::uint64_t per_waiter = iterations / waiter_count + 1;
+                    std::atomic<std::uint64_t> finished_count(0);
+                    {
+                        thread_pool pool(executor_thread_count);
+                        for (std::uint64_t index = 0; index < waiter_count; ++index)
+                            pool.post([&]() { update_account(weak, pool, per_waiter, finished_count); });
+                        while (finished_count.load(std::memory_order_acquire) < waiter_count)
+                            std::this_thread::yield();
+                    }
+                    return per_waiter * waiter_count;
+                }
+        );
+    }
+    
+    /**
+     * waiter_count threads blocking in get_view update one shared account
+     */
+    void register_blocking_case(unsigned waiter_count)
+    {
+        bench::registrar(
+                "coroutine/blocking_get_view/threads:" + std::to_string(waiter_count),
+                [waiter_count](std::uint64_t iterations)
+                {
+                    shared_account object = variable_util::make_referable_unique<account, awaitable_mutex<>>(
+                            account{0}
+                    );
+                    const shared_account::weak_ptr weak(object);
+                    const std::uint64_t per_waiter = iterations / waiter_count + 1;
+                    bench::run_threads(
+                            waiter_count,
+                            [&](unsigned)
+                            {
+                                shared_account::weak_ptr local(weak);
+                                for (std::uint64_t i = 0; i < per_waiter; ++i) hold_work(**local.get_view());
+                            }
+                    );
+                    return per_waiter * waiter_count;
+                }
+        );
+    }
+    
+    const bool coroutine_cases_registered = (
+            register_coroutine_case(100),
+            register_coroutine_case(10000),
+            register_blocking_case(100),
+            register_blocking_case(10000),
+            true
+    );
+}
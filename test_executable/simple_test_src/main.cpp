@@ -1,7 +1,455 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
 #include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "variable_util/variable_util.hpp"
+
+namespace
+{
+    int failure_count = 0;
+    
+    void check(bool condition, const char *description)
+    {
+        if (condition) return;
+        std::cerr << "failed: " << description << std::endl;
+        ++failure_count;
+    }
+    
+    ///@return whether function throws exception_t
+    template<typename exception_t, typename function_t>
+    bool throws(function_t &&function)
+    {
+        try
+        {
+            function();
+        }
+        catch (const exception_t &)
+        {
+            return true;
+        }
+        return false;
+    }
+    
+    struct intrusive_content : variable_util::referable_base<>
+    {
+        static inline int destroyed_count = 0;
+        
+        std::string text;
+        
+        inline explicit intrusive_content(std::string initial_text) : text(std::move(initial_text))
+        {}
+        
+        inline ~intrusive_content()
+        {
+            ++destroyed_count;
+        }
+    };
+    
+    ///weak_ptrs of an intrusive content outlive the content and report it as expired
+    void intrusive_weak_ptr_outlives_content()
+    {
+        using owner_type = variable_util::referable_unique<intrusive_content>;
+        std::optional<owner_type> owner;
+        owner.emplace(variable_util::make_tagged_referable_unique<intrusive_content>(
+                variable_util::referable_tag(7u), variable_util::referable_tag("intrusive"), "content"
+        ));
+        owner_type::weak_ptr weak(*owner), copied_weak(weak);
+        check((bool) weak, "weak_ptr of a live content is valid");
+        {
+            auto viewed = weak.try_get_const_view();
+            check(viewed && (*viewed)->text == "content", "const_view of a live content");
+        }
+        
+        ///A view keeps the content alive after the owner is gone
+        auto kept_view = weak.try_get_view();
+        owner.reset();
+        check(intrusive_content::destroyed_count == 0, "a view keeps the content alive");
+        check((bool) weak, "weak_ptr is valid while a view is alive");
+        {
+            ///Destroy the view, which destroys the content
+            auto released_view = std::move(kept_view);
+        }
+        check(intrusive_content::destroyed_count == 1, "the content is destroyed with the last view");
+        
+        check(!weak && !copied_weak, "weak_ptrs of a destroyed content are invalid");
+        check(weak.try_get_view().get_status() == variable_util::access_status::expired,
+              "try_get_view of a destroyed content");
+        check(!copied_weak.try_lock_const_view(), "try_lock_const_view of a destroyed content");
+        check(!weak.id() && !weak.label(), "tags of a destroyed content");
+        copied_weak = weak;
+        check(!copied_weak, "copy of a weak_ptr of a destroyed content");
+        check(intrusive_content::destroyed_count == 1, "the content is destroyed once");
+    }
+    
+    ///Views created and read through every lock policy
+    template<typename lock_policy>
+    void lock_policy_round_trip(const char *description)
+    {
+        auto owner = variable_util::make_referable_unique<int, lock_policy>(1);
+        typename variable_util::referable_unique<int, lock_policy>::weak_ptr weak(owner);
+        {
+            auto content_view = weak.get_view();
+            **content_view = 2;
+        }
+        auto content_const_view = weak.get_const_view();
+        check(**content_const_view == 2, description);
+    }
+    
+    ///Every path of a generic weak_ptr reports expiry once the owner is destroyed, even when read pinned it
+    void generic_weak_ptr_expires_with_owner()
+    {
+        using owner_type = variable_util::referable_unique<int>;
+        std::optional<owner_type> owner;
+        owner.emplace(variable_util::make_tagged_referable_unique<int>(
+                variable_util::referable_tag("generic"), variable_util::referable_tag(2u), 5
+        ));
+        owner_type::weak_ptr weak(*owner);
+        check(weak.read([](const int &content) { return content; }) == std::optional<int>(5),
+              "read of a live content");
+        check(weak.id() == std::optional<variable_util::referable_tag>(variable_util::referable_tag("generic")),
+              "id of a live content");
+        
+        auto kept_view = weak.try_get_view();
+        owner.reset();
+        check(**kept_view == 5, "a view keeps the content alive");
+        check(!weak, "weak_ptr of a destroyed owner is invalid while a view is alive");
+        check(!weak.id() && !weak.label() && !weak.version(), "tags of a destroyed owner");
+        check(!weak.read([](const int &content) { return content; }), "read of a destroyed owner");
+        check(weak.try_get_const_view().get_status() == variable_util::access_status::expired,
+              "try_get_const_view of a destroyed owner");
+        check(weak.try_lock_view().get_status() == variable_util::access_status::expired,
+              "try_lock_view of a destroyed owner");
+        check(throws<std::bad_weak_ptr>([&weak]() { weak.get_view(); }), "get_view of a destroyed owner");
+        check(throws<std::bad_weak_ptr>([&weak]() { weak.get_const_view(); }), "get_const_view of a destroyed owner");
+        check(throws<std::bad_weak_ptr>([&weak]() { variable_util::lock_views(weak); }),
+              "lock_views of a destroyed owner");
+        check(!weak.apply([](int &content) { return ++content; }), "apply to a destroyed owner");
+        check(!weak.subscribe([](std::uint64_t) {}), "subscribe to a destroyed owner");
+        check(weak.wait_for_change(0).get_status() == variable_util::change_status::expired,
+              "wait_for_change of a destroyed owner");
+        kept_view.to_optional().reset();
+        check(!weak, "weak_ptr of a destroyed content");
+    }
+    
+    ///weak_ptrs of the rcu and lock-free specializations report expiry once the owner is destroyed
+    void specialized_weak_ptrs_expire_with_owner()
+    {
+        using rcu_owner_type = variable_util::referable_unique<std::string, variable_util::rcu_policy>;
+        std::optional<rcu_owner_type> rcu_owner;
+        rcu_owner.emplace(std::make_unique<std::string>("rcu"));
+        rcu_owner_type::weak_ptr rcu_weak(*rcu_owner);
+        check(rcu_weak.get_const_view() && **rcu_weak.get_const_view() == "rcu", "const_view of a live rcu content");
+        rcu_owner.reset();
+        check(!rcu_weak && !rcu_weak.id() && !rcu_weak.get_const_view(), "rcu weak_ptr of a destroyed owner");
+        check(rcu_weak.try_get_view().get_status() == variable_util::access_status::expired,
+              "rcu try_get_view of a destroyed owner");
+        check(throws<std::bad_weak_ptr>([&rcu_weak]() { rcu_weak.get_view(); }),
+              "rcu get_view of a destroyed owner");
+        
+        struct wide_content
+        {
+            std::int64_t values[4];
+        };
+        using seqlock_owner_type = variable_util::referable_unique<wide_content, variable_util::seqlock_policy>;
+        std::optional<seqlock_owner_type> seqlock_owner;
+        seqlock_owner.emplace(variable_util::make_referable_unique<wide_content, variable_util::seqlock_policy>(
+                wide_content{{1, 2, 3, 4}}
+        ));
+        seqlock_owner_type::weak_ptr seqlock_weak(*seqlock_owner);
+        {
+            auto content_view = seqlock_weak.get_view();
+            (*content_view)->values[3] = 5;
+        }
+        check(seqlock_weak.read([](const wide_content &content) { return content.values[3]; }) ==
+              std::optional<std::int64_t>(5), "seqlock read of a published view");
+        seqlock_owner.reset();
+        check(!seqlock_weak && !seqlock_weak.read([](const wide_content &) {}),
+              "seqlock weak_ptr of a destroyed owner");
+        check(seqlock_weak.try_get_const_view().get_status() == variable_util::access_status::expired,
+              "seqlock try_get_const_view of a destroyed owner");
+        check(throws<std::bad_weak_ptr>([&seqlock_weak]() { seqlock_weak.get_const_view(); }),
+              "seqlock get_const_view of a destroyed owner");
+    }
+    
+    ///The try_ family reports acquired, contended and timed_out without throwing
+    void access_result_statuses()
+    {
+        using owner_type = variable_util::referable_unique<int, variable_util::futex_shared_mutex>;
+        auto owner = variable_util::make_referable_unique<int, variable_util::futex_shared_mutex>(1);
+        owner_type::weak_ptr weak(owner);
+        auto acquired = weak.try_get_view();
+        check(acquired.get_status() == variable_util::access_status::acquired && acquired, "try_get_view acquires");
+        check(weak.try_lock_const_view().get_status() == variable_util::access_status::contended,
+              "try_lock_const_view while a view is held");
+        check(weak.try_get_view(std::chrono::milliseconds(1)).get_status() == variable_util::access_status::timed_out,
+              "timed try_get_view while a view is held");
+        check(!weak.try_lock_view().to_optional(), "a failed result holds no view");
+        acquired.to_optional().reset();
+        check(weak.try_lock_view().get_status() == variable_util::access_status::acquired,
+              "try_lock_view once the view is released");
+    }
+    
+    ///lock_views takes overlapping sets in any order without deadlock and rejects duplicates
+    void lock_views_without_deadlock()
+    {
+        using owner_type = variable_util::referable_unique<int>;
+        auto first = variable_util::make_referable_unique<int>(0);
+        auto second = variable_util::make_referable_unique<int>(0);
+        owner_type::weak_ptr first_weak(first), second_weak(second);
+        constexpr int round_count = 2000;
+        std::thread reversed(
+                [&]()
+                {
+                    for (int round = 0; round < round_count; ++round)
+                    {
+                        auto views = variable_util::lock_views(second_weak, first_weak);
+                        ++*std::get<0>(*views);
+                        ++*std::get<1>(*views);
+                    }
+                }
+        );
+        for (int round = 0; round < round_count; ++round)
+        {
+            auto views = variable_util::lock_views(first_weak, second_weak);
+            ++*std::get<0>(*views);
+            ++*std::get<1>(*views);
+        }
+        reversed.join();
+        check(*first.borrow_const() == 2 * round_count && *second.borrow_const() == 2 * round_count,
+              "lock_views in both orders");
+        check(throws<std::invalid_argument>([&]() { variable_util::lock_views(first_weak, first_weak); }),
+              "lock_views of the same content twice");
+        check(first_weak.try_lock_view(), "lock_views releases every guard after a rejection");
+    }
+    
+    ///upgradable_view coexists with const_views and is promoted or demoted without releasing the guard
+    void upgradable_view_promotion()
+    {
+        using owner_type = variable_util::referable_unique<int, variable_util::futex_shared_mutex>;
+        auto owner = variable_util::make_referable_unique<int, variable_util::futex_shared_mutex>(1);
+        owner_type::weak_ptr weak(owner);
+        auto upgradable = weak.get_upgradable_view();
+        {
+            auto reader = weak.try_lock_const_view();
+            check(reader && **reader == 1, "const_view coexists with an upgradable_view");
+            check(weak.try_lock_upgradable_view().get_status() == variable_util::access_status::contended,
+                  "upgradable_views exclude each other");
+            check(!upgradable->try_upgrade(), "try_upgrade while a const_view is held");
+        }
+        auto promoted = upgradable->upgrade();
+        check(throws<std::logic_error>([&upgradable]() { upgradable->upgrade(); }), "upgrade of a promoted view");
+        check(throws<std::logic_error>([&upgradable]() { upgradable->downgrade(); }), "downgrade of a promoted view");
+        check(!upgradable->try_upgrade(), "try_upgrade of a promoted view");
+        *promoted = 2;
+        auto demoted = promoted.downgrade();
+        check(*demoted == 2 && weak.try_lock_const_view(), "view downgraded to a const_view");
+        check(weak.try_lock_view().get_status() == variable_util::access_status::contended,
+              "a downgraded view still excludes views");
+    }
+    
+    ///Erased objects of a pool are detected through stale handles, also after their slot is reused
+    void pool_stale_handles()
+    {
+        variable_util::referable_pool<int> pool(16);
+        const auto stale = pool.emplace(1);
+        check(!pool.expired(stale) && pool.size() == 1, "handle of a live object");
+        check(pool.erase(stale) && !pool.erase(stale), "an object is erased once");
+        const auto reused = pool.emplace(2);
+        check(reused != stale && pool.expired(stale) && !pool.expired(reused), "a reused slot gets a new generation");
+        check(pool.try_get_view(stale).get_status() == variable_util::access_status::expired,
+              "try_get_view of a stale handle");
+        check(throws<std::bad_weak_ptr>([&]() { pool.get_const_view(stale); }), "get_const_view of a stale handle");
+        check(**pool.get_view(reused) == 2, "view of the object in the reused slot");
+        check(pool.expired(variable_util::referable_pool<int>::handle()), "a default handle refers to nothing");
+    }
+    
+    ///apply returns copies of the results, apply_batch runs its functions in order and stops at a failure
+    void apply_results()
+    {
+        using owner_type = variable_util::referable_unique<int>;
+        auto owner = variable_util::make_referable_unique<int>(1);
+        owner_type::weak_ptr weak(owner);
+        check(weak.apply([](int &content) { return content += 1; }) == std::optional<int>(2), "apply returns a value");
+        auto referenced = weak.apply([](int &content) -> int & { return content; });
+        static_assert(std::is_same_v<decltype(referenced), std::optional<int>>, "referenced results are copied");
+        check(referenced == std::optional<int>(2), "apply copies a referenced result");
+        check(weak.apply([](int &content) { content *= 10; }), "apply of a void function");
+        
+        std::vector<std::function<void(int &)>> batch{
+                [](int &content) { content += 1; },
+                [](int &content) { content *= 2; }
+        };
+        check(weak.apply_batch(batch.begin(), batch.end()) && *owner.borrow_const() == 42, "apply_batch runs in order");
+        batch.insert(batch.begin() + 1, [](int &) { throw std::runtime_error("batch failure"); });
+        check(throws<std::runtime_error>([&]() { weak.apply_batch(batch.begin(), batch.end()); }),
+              "apply_batch rethrows a failure");
+        check(*owner.borrow_const() == 43, "apply_batch stops at a failure");
+    }
+    
+    ///wait_for_change and subscribe follow the views released after the version seen
+    void change_notifications()
+    {
+        using owner_type = variable_util::referable_unique<int>;
+        std::optional<owner_type> owner;
+        owner.emplace(variable_util::make_referable_unique<int>(0));
+        owner_type::weak_ptr weak(*owner);
+        const std::uint64_t initial_version = *weak.version();
+        check(weak.wait_for_change(initial_version, std::chrono::milliseconds(1)).get_status() ==
+              variable_util::change_status::timed_out, "wait_for_change without a change");
+        
+        std::atomic<int> notified_count{0};
+        auto subscription = weak.subscribe([&notified_count](std::uint64_t) { ++notified_count; });
+        check((bool) subscription, "subscribe to a live content");
+        std::thread writer(
+                [&weak]()
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    **weak.get_view() = 1;
+                }
+        );
+        const auto changed = weak.wait_for_change(initial_version);
+        writer.join();
+        check(changed && changed.version() == initial_version + 1, "wait_for_change wakes on a released view");
+        check(notified_count == 1, "subscribers are notified of a released view");
+        subscription.reset();
+        **weak.get_view() = 2;
+        check(notified_count == 1, "a reset subscription is not notified");
+        
+        const std::uint64_t last_version = *weak.version();
+        std::thread destroyer(
+                [&owner]()
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    owner.reset();
+                }
+        );
+        const auto expired = weak.wait_for_change(last_version);
+        destroyer.join();
+        check(expired.get_status() == variable_util::change_status::expired,
+              "wait_for_change wakes when the owner is destroyed");
+    }
+    
+    ///The first live object registered with an id keeps it
+    void registry_duplicate_ids()
+    {
+        using owner_type = variable_util::referable_unique<int, variable_util::spin_shared_mutex>;
+        using registry_type = variable_util::referable_registry<int, variable_util::spin_shared_mutex>;
+        const variable_util::referable_tag id("duplicate");
+        std::optional<owner_type> first;
+        first.emplace(variable_util::make_tagged_referable_unique<int, variable_util::spin_shared_mutex>(
+                id, variable_util::referable_tag(), 1
+        ));
+        auto second = variable_util::make_tagged_referable_unique<int, variable_util::spin_shared_mutex>(
+                id, variable_util::referable_tag(), 2
+        );
+        auto found = registry_type::instance().find(id);
+        check(found && **found->get_const_view() == 1, "find returns the first object with an id");
+        check(registry_type::instance().size() == 1, "a duplicate id is not registered");
+        first.reset();
+        check(!registry_type::instance().contains(id) && !registry_type::instance().find(id),
+              "a duplicate is not registered once the first object is destroyed");
+        check(second.id() == id, "the duplicate keeps its id");
+    }
+
+#if defined(__linux__)
+    
+    /**
+     * Overwrite a field of the header of a snapshot file, try to restore it, then put the field back
+     * @return whether restore_referable_snapshot rejected the file
+     */
+    bool rejects_patched_header(const std::string &path, std::size_t offset, std::uint64_t value)
+    {
+        std::FILE *file = std::fopen(path.c_str(), "r+b");
+        if (!file) return false;
+        std::uint64_t original = 0;
+        std::fseek(file, static_cast<long>(offset), SEEK_SET);
+        std::fread(&original, sizeof(original), 1, file);
+        std::fseek(file, static_cast<long>(offset), SEEK_SET);
+        std::fwrite(&value, sizeof(value), 1, file);
+        std::fflush(file);
+        const bool rejected = throws<std::runtime_error>(
+                [&path]() { variable_util::restore_referable_snapshot<std::int64_t>(path); }
+        );
+        std::fseek(file, static_cast<long>(offset), SEEK_SET);
+        std::fwrite(&original, sizeof(original), 1, file);
+        std::fclose(file);
+        return rejected;
+    }
+    
+    ///Snapshots restore the written contents and tags, and corrupted headers are rejected
+    void snapshot_round_trip()
+    {
+        using owner_type = variable_util::referable_unique<std::int64_t>;
+        const std::string path = "simple_test_snapshot.bin";
+        {
+            std::vector<owner_type> owners;
+            owners.push_back(variable_util::make_tagged_referable_unique<std::int64_t>(
+                    variable_util::referable_tag("snapshot first"), variable_util::referable_tag(1u), 10
+            ));
+            owners.push_back(variable_util::make_referable_unique<std::int64_t>(20));
+            check(variable_util::write_referable_snapshot(path, owners) == 2, "snapshot writes every content");
+        }
+        {
+            auto restored = variable_util::restore_referable_snapshot<std::int64_t>(path);
+            check(restored.size() == 2 && *restored[0].borrow_const() == 10 && *restored[1].borrow_const() == 20,
+                  "snapshot restores the contents");
+            check(restored.size() == 2 && restored[0].id() == variable_util::referable_tag("snapshot first") &&
+                  restored[0].label() == variable_util::referable_tag(1u) && restored[1].id().empty(),
+                  "snapshot restores the tags");
+        }
+        
+        check(throws<std::runtime_error>(
+                [&path]() { variable_util::restore_referable_snapshot<std::int32_t>(path); }
+        ), "snapshot of a content type of another size is rejected");
+        using header_type = variable_util::snapshot_header;
+        ///An offset close to 2^64 wraps around when added to the size of the contents
+        check(rejects_patched_header(path, offsetof(header_type, content_offset), ~std::uint64_t(7)),
+              "snapshot with a wrapping content offset is rejected");
+        check(rejects_patched_header(path, offsetof(header_type, content_offset), 0),
+              "snapshot with contents overlapping the header is rejected");
+        check(rejects_patched_header(path, offsetof(header_type, count), std::uint64_t(1) << 60),
+              "snapshot with a corrupted count is rejected");
+        check(rejects_patched_header(path, offsetof(header_type, string_size), ~std::uint64_t(0)),
+              "snapshot with a corrupted string size is rejected");
+        check(variable_util::restore_referable_snapshot<std::int64_t>(path).size() == 2,
+              "snapshot is restored again once its header is repaired");
+        std::remove(path.c_str());
+    }
+
+#endif
+}
 
 int main()
 {
+    lock_policy_round_trip<std::shared_timed_mutex>("std::shared_timed_mutex");
+    lock_policy_round_trip<std::mutex>("std::mutex");
+    lock_policy_round_trip<variable_util::spin_shared_mutex>("spin_shared_mutex");
+    lock_policy_round_trip<variable_util::futex_shared_mutex>("futex_shared_mutex");
+    lock_policy_round_trip<variable_util::null_mutex>("null_mutex");
+    generic_weak_ptr_expires_with_owner();
+    intrusive_weak_ptr_outlives_content();
+    specialized_weak_ptrs_expire_with_owner();
+    access_result_statuses();
+    lock_views_without_deadlock();
+    upgradable_view_promotion();
+    pool_stale_handles();
+    apply_results();
+    change_notifications();
+    registry_duplicate_ids();
+#if defined(__linux__)
+    snapshot_round_trip();
+#endif
+    if (failure_count != 0) return 1;
     std::cout << "Hello, World!" << std::endl;
     return 0;
 }
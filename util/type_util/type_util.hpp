@@ -5,6 +5,7 @@
 #ifndef HEADER_GUARD__74c56d18_4654_4070_90bf_5ba396cbc172__type_util_hpp
 #define HEADER_GUARD__74c56d18_4654_4070_90bf_5ba396cbc172__type_util_hpp
 
+#include <atomic>
 #include <type_traits>
 
 namespace type_util
@@ -13,18 +14,18 @@ namespace type_util
      * @see https://cloud.tencent.com/developer/article/1433593
      * @see https://www.zhihu.com/question/34929124
      * @tparam instance_class
-     * @tparam template_to_check
+     * @tparam template_to_check class template with any number of type parameters
      */
     template<
             typename instance_class,
-            template<typename> class template_to_check
+            template<typename...> class template_to_check
     >
     class is_class_template_instance
     {
     private:
-        template<typename template_parameters>
+        template<typename ...template_parameters>
         static constexpr std::true_type check(
-                template_to_check<template_parameters> &&
+                template_to_check<template_parameters...> &&
         )
         {
             return std::true_type();
@@ -39,6 +40,52 @@ namespace type_util
     public:
         static constexpr bool value = decltype(check(std::declval<instance_class>()))::value;
     };
+    
+    /**
+     * Finds the instance of template_to_check which instance_class is or publicly derives from.
+     * type is void when there is none.
+     * @tparam instance_class
+     * @tparam template_to_check class template with any number of type parameters
+     */
+    template<
+            typename instance_class,
+            template<typename...> class template_to_check
+    >
+    class class_template_instance_base
+    {
+    private:
+        template<typename ...template_parameters>
+        static constexpr template_to_check<template_parameters...> *check(
+                template_to_check<template_parameters...> *
+        )
+        {
+            return nullptr;
+        }
+        
+        static constexpr void *check(...)
+        {
+            return nullptr;
+        }
+    
+    public:
+        using type = std::remove_pointer_t<decltype(check(std::declval<std::add_pointer_t<instance_class>>()))>;
+        static constexpr bool value = !std::is_void<type>::value;
+    };
+    
+    /**
+     * Whether std::atomic<T> exists and never falls back to a lock.
+     * std::atomic<T> is only instantiated for trivially copyable T.
+     * @tparam T
+     */
+    template<typename T, bool = std::is_trivially_copyable<T>::value && std::is_copy_constructible<T>::value>
+    struct is_always_lock_free : std::false_type
+    {
+    };
+    
+    template<typename T>
+    struct is_always_lock_free<T, true> : std::bool_constant<std::atomic<T>::is_always_lock_free>
+    {
+    };
 }
 
 #endif //HEADER_GUARD__74c56d18_4654_4070_90bf_5ba396cbc172__type_util_hpp
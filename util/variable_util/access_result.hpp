@@ -0,0 +1,90 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__9d1f5e3b_4a72_4c06_8e2b_c3a71f06d948__access_result_hpp
+#define HEADER_GUARD__9d1f5e3b_4a72_4c06_8e2b_c3a71f06d948__access_result_hpp
+
+#include "variable_util_includes.h"
+
+/**
+ * Outcome of the try_ family of weak_ptr
+ */
+enum class access_status : std::uint8_t
+{
+    ///The view has been created
+    acquired,
+    ///The content has been destroyed
+    expired,
+    ///The guard was not acquired before the timeout
+    timed_out,
+    ///The guard was held by another thread and the caller did not wait
+    contended
+};
+
+/**
+ * A view or a const_view, or the reason why it could not be created.
+ * Returned by the try_ family of weak_ptr, which never throws std::bad_weak_ptr.
+ * @tparam view_t view or const_view of a referable_unique
+ */
+template<typename view_t>
+class access_result final
+{
+private:
+    std::optional<view_t> content_view;
+    access_status status;
+    
+    inline explicit access_result(const access_result &) = delete;
+    
+    inline access_result &operator=(const access_result &) = delete;
+    
+    inline access_result &operator=(access_result &&) = delete;
+
+public:
+    ///Failed result
+    inline explicit access_result(access_status failure) noexcept :
+            content_view(), status(failure)
+    {}
+    
+    ///Successful result
+    inline explicit access_result(view_t &&acquired_view) :
+            content_view(std::in_place, std::move(acquired_view)), status(access_status::acquired)
+    {}
+    
+    /// Move constructor
+    inline access_result(access_result &&original) :
+            content_view(std::move(original.content_view)), status(original.status)
+    {}
+    
+    inline access_status get_status() const noexcept
+    {
+        return status;
+    }
+    
+    ///is the view acquired
+    inline operator bool() const noexcept
+    {
+        return status == access_status::acquired;
+    }
+    
+    inline view_t &operator*() noexcept
+    {
+        return *content_view;
+    }
+    
+    inline view_t *operator->() noexcept
+    {
+        return &*content_view;
+    }
+    
+    /**
+     * @return the view as returned by get_view or get_const_view,
+     * empty unless the status is acquired
+     */
+    inline std::optional<view_t> &to_optional() noexcept
+    {
+        return content_view;
+    }
+};
+
+#endif //HEADER_GUARD__9d1f5e3b_4a72_4c06_8e2b_c3a71f06d948__access_result_hpp
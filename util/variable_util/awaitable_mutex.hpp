@@ -0,0 +1,424 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__7f2c9d14_3a8e_4b61_b5d0_9e46a1c83f27__awaitable_mutex_hpp
+#define HEADER_GUARD__7f2c9d14_3a8e_4b61_b5d0_9e46a1c83f27__awaitable_mutex_hpp
+
+#include "variable_util_includes.h"
+
+/**
+ * Whether lock_policy can queue coroutines,
+ * which enables weak_ptr::async_view and weak_ptr::async_const_view
+ * @tparam lock_policy
+ */
+template<typename lock_policy, typename = void>
+struct is_awaitable_lock : std::false_type
+{
+};
+
+#if defined(__cpp_impl_coroutine)
+
+/**
+ * A coroutine suspended by co_await weak_ptr::async_view or weak_ptr::async_const_view
+ */
+class awaitable_waiter
+{
+private:
+    std::atomic<bool> settled{false};
+
+public:
+    std::coroutine_handle<> handle;
+    ///Written by the thread which settles the waiter, before the coroutine is resumed
+    access_status status = access_status::acquired;
+    
+    virtual ~awaitable_waiter() = default;
+    
+    /**
+     * Only one of the guard acquisition and the timeout settles a waiter,
+     * the one which does resumes the coroutine
+     * @return whether the calling thread has settled the waiter
+     */
+    inline bool settle() noexcept
+    {
+        bool expected = false;
+        return settled.compare_exchange_strong(expected, true, std::memory_order_acq_rel);
+    }
+    
+    inline bool is_settled() const noexcept
+    {
+        return settled.load(std::memory_order_acquire);
+    }
+    
+    ///Try again to acquire the guard through the executor, called after the guard has been released
+    virtual void retry() = 0;
+    
+    ///Give up waiting, called by awaitable_timer when the timeout has passed
+    virtual void expire() = 0;
+};
+
+/**
+ * Process wide timer of the timed async_view and async_const_view.
+ * Its thread is started on first use and never stops.
+ */
+class awaitable_timer final
+{
+private:
+    std::mutex timer_guard;
+    std::condition_variable deadline_changed;
+    std::multimap<std::chrono::steady_clock::time_point, std::weak_ptr<awaitable_waiter>> deadlines;
+    bool started = false;
+    
+    inline awaitable_timer() = default;
+    
+    inline explicit awaitable_timer(const awaitable_timer &) = delete;
+    
+    inline awaitable_timer &operator=(const awaitable_timer &) = delete;
+    
+    inline void run()
+    {
+        std::unique_lock<std::mutex> timer_lock(timer_guard);
+        while (true)
+        {
+            if (deadlines.empty())
+            {
+                deadline_changed.wait(timer_lock);
+                continue;
+            }
+            const auto earliest = deadlines.begin();
+            if (earliest->first > std::chrono::steady_clock::now())
+            {
+                deadline_changed.wait_until(timer_lock, earliest->first);
+                continue;
+            }
+            std::weak_ptr<awaitable_waiter> expired_waiter(std::move(earliest->second));
+            deadlines.erase(earliest);
+            timer_lock.unlock();
+            /// a waiter resumed before its deadline has usually been destroyed already
+            if (auto waiter = expired_waiter.lock(); waiter) waiter->expire();
+            timer_lock.lock();
+        }
+    }
+
+public:
+    inline static awaitable_timer &instance()
+    {
+        static awaitable_timer *const timer = new awaitable_timer();
+        return *timer;
+    }
+    
+    /**
+     * @param deadline
+     * @param waiter expired at deadline unless it has been settled before
+     */
+    inline void schedule(std::chrono::steady_clock::time_point deadline, std::weak_ptr<awaitable_waiter> waiter)
+    {
+        std::lock_guard<std::mutex> timer_lock(timer_guard);
+        if (!started)
+        {
+            std::thread(&awaitable_timer::run, this).detach();
+            started = true;
+        }
+        const bool earliest = deadlines.empty() || deadline < deadlines.begin()->first;
+        deadlines.emplace(deadline, std::move(waiter));
+        if (earliest) deadline_changed.notify_one();
+    }
+};
+
+/**
+ * Lock policy which forwards to mutex_t
+ * and queues the coroutines waiting in async_view and async_const_view,
+ * so that they are retried through their executor whenever the guard is released.
+ * Blocking views and coroutines can be mixed on the same object.
+ * @tparam mutex_t wrapped lock, std::shared_timed_mutex, spin_shared_mutex, std::mutex ...
+ */
+template<typename mutex_t = std::shared_timed_mutex>
+class awaitable_mutex final
+{
+private:
+    mutex_t mutex;
+    std::mutex waiter_guard;
+    std::vector<std::shared_ptr<awaitable_waiter>> waiters;
+    /**
+     * Queued waiters plus those checking the guard in acquire_or_enqueue,
+     * so that unlock only takes waiter_guard when a coroutine may be waiting
+     */
+    std::atomic<std::size_t> waiter_count{0};
+    
+    inline explicit awaitable_mutex(const awaitable_mutex &) = delete;
+    
+    inline awaitable_mutex &operator=(const awaitable_mutex &) = delete;
+    
+    ///Hand every queued waiter to its executor
+    inline void wake()
+    {
+        /// pairs with the fence of acquire_or_enqueue,
+        /// either this thread sees the waiter or the waiter sees the guard released
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiter_count.load(std::memory_order_relaxed) == 0) return;
+        std::vector<std::shared_ptr<awaitable_waiter>> woken;
+        {
+            std::lock_guard<std::mutex> waiter_lock(waiter_guard);
+            woken.swap(waiters);
+            waiter_count.fetch_sub(woken.size(), std::memory_order_relaxed);
+        }
+        for (auto &waiter: woken) waiter->retry();
+    }
+
+public:
+    inline awaitable_mutex() = default;
+    
+    inline void lock()
+    {
+        mutex.lock();
+    }
+    
+    inline bool try_lock()
+    {
+        return mutex.try_lock();
+    }
+    
+    template<class Rep, class Period>
+    inline bool try_lock_for(const std::chrono::duration<Rep, Period> &timeout_duration)
+    {
+        return mutex.try_lock_for(timeout_duration);
+    }
+    
+    template<class Clock, class Duration>
+    inline bool try_lock_until(const std::chrono::time_point<Clock, Duration> &timeout_time)
+    {
+        return mutex.try_lock_until(timeout_time);
+    }
+    
+    inline void unlock()
+    {
+        mutex.unlock();
+        wake();
+    }
+    
+    template<typename shared_mutex_t = mutex_t, typename = std::enable_if_t<lock_traits<shared_mutex_t>::is_shared>>
+    inline void lock_shared()
+    {
+        mutex.lock_shared();
+    }
+    
+    template<typename shared_mutex_t = mutex_t, typename = std::enable_if_t<lock_traits<shared_mutex_t>::is_shared>>
+    inline bool try_lock_shared()
+    {
+        return mutex.try_lock_shared();
+    }
+    
+    template<class Rep, class Period>
+    inline bool try_lock_shared_for(const std::chrono::duration<Rep, Period> &timeout_duration)
+    {
+        return mutex.try_lock_shared_for(timeout_duration);
+    }
+    
+    template<class Clock, class Duration>
+    inline bool try_lock_shared_until(const std::chrono::time_point<Clock, Duration> &timeout_time)
+    {
+        return mutex.try_lock_shared_until(timeout_time);
+    }
+    
+    template<typename shared_mutex_t = mutex_t, typename = std::enable_if_t<lock_traits<shared_mutex_t>::is_shared>>
+    inline void unlock_shared()
+    {
+        mutex.unlock_shared();
+        wake();
+    }
+    
+    /**
+     * @param shared whether to lock shared, exclusive-only locks always lock exclusively
+     * @return whether the guard has been acquired without waiting
+     */
+    inline bool try_acquire(bool shared)
+    {
+        if constexpr (lock_traits<mutex_t>::is_shared)
+            return shared ? mutex.try_lock_shared() : mutex.try_lock();
+        else
+            return mutex.try_lock();
+    }
+    
+    ///Release the guard acquired by try_acquire or acquire_or_enqueue
+    inline void release(bool shared)
+    {
+        if constexpr (lock_traits<mutex_t>::is_shared)
+        {
+            if (shared) unlock_shared();
+            else unlock();
+        }
+        else unlock();
+    }
+    
+    /**
+     * Acquire the guard, or queue waiter to be retried when the guard is released
+     * @param waiter
+     * @param shared whether to lock shared
+     * @return whether the guard has been acquired
+     */
+    inline bool acquire_or_enqueue(const std::shared_ptr<awaitable_waiter> &waiter, bool shared)
+    {
+        std::lock_guard<std::mutex> waiter_lock(waiter_guard);
+        waiter_count.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (try_acquire(shared))
+        {
+            waiter_count.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        waiters.push_back(waiter);
+        return false;
+    }
+    
+    ///Remove waiter from the queue if it is still queued
+    inline void cancel(const awaitable_waiter *waiter)
+    {
+        std::lock_guard<std::mutex> waiter_lock(waiter_guard);
+        auto found = std::find_if(
+                waiters.begin(), waiters.end(),
+                [waiter](const std::shared_ptr<awaitable_waiter> &queued) { return queued.get() == waiter; }
+        );
+        if (found == waiters.end()) return;
+        waiters.erase(found);
+        waiter_count.fetch_sub(1, std::memory_order_relaxed);
+    }
+};
+
+template<typename mutex_t>
+struct is_awaitable_lock<awaitable_mutex<mutex_t>> : std::true_type
+{
+};
+
+/**
+ * Waiter of the guard of one object, resumed through executor_t.
+ * It keeps the Container of the object alive, so the guard outlives every queued waiter.
+ * @tparam guard_t awaitable_mutex<mutex_t>
+ * @tparam executor_t callable with a nullary function, which it must invoke later on any thread
+ */
+template<typename guard_t, typename executor_t>
+class awaitable_waiter_of final :
+        public awaitable_waiter, public std::enable_shared_from_this<awaitable_waiter_of<guard_t, executor_t>>
+{
+private:
+    std::shared_ptr<void> guard_owner;
+    guard_t &guard;
+    executor_t executor;
+
+public:
+    const bool shared;
+    
+    inline explicit awaitable_waiter_of(
+            std::shared_ptr<void> owner, guard_t &content_guard, executor_t &&waiter_executor, bool shared_lock
+    ) :
+            guard_owner(std::move(owner)), guard(content_guard),
+            executor(std::move(waiter_executor)), shared(shared_lock)
+    {}
+    
+    inline void retry() override
+    {
+        executor(
+                [self = this->shared_from_this()]()
+                {
+                    if (self->is_settled() || !self->guard.acquire_or_enqueue(self, self->shared)) return;
+                    if (self->settle()) self->handle.resume();
+                    /// the timeout has resumed the coroutine meanwhile
+                    else self->guard.release(self->shared);
+                }
+        );
+    }
+    
+    inline void expire() override
+    {
+        if (!settle()) return;
+        guard.cancel(this);
+        status = access_status::timed_out;
+        executor([self = this->shared_from_this()]() { self->handle.resume(); });
+    }
+};
+
+/**
+ * Awaitable returned by weak_ptr::async_view and weak_ptr::async_const_view.
+ * co_await yields access_result<view_t>, whose status is acquired, expired or timed_out.
+ * @tparam view_t view or const_view
+ * @tparam lock_t lock type held by view_t
+ * @tparam content_t content type
+ * @tparam container_t Container of the content, whose content_guard is an awaitable_mutex
+ * @tparam executor_t callable with a nullary function, which it must invoke later on any thread
+ */
+template<typename view_t, typename lock_t, typename content_t, typename container_t, typename executor_t>
+class view_awaiter final
+{
+private:
+    using guard_t = decltype(std::declval<container_t &>().content_guard);
+    
+    std::shared_ptr<content_t> content_shared_ptr;
+    std::shared_ptr<container_t> container_shared_ptr;
+    std::optional<executor_t> executor;
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    const bool shared;
+    std::shared_ptr<awaitable_waiter> waiter;
+    access_status status;
+    
+    inline explicit view_awaiter(const view_awaiter &) = delete;
+    
+    inline view_awaiter &operator=(const view_awaiter &) = delete;
+
+public:
+    inline explicit view_awaiter(
+            std::shared_ptr<content_t> &&content, std::shared_ptr<container_t> &&container,
+            executor_t &&view_executor, bool shared_lock,
+            std::optional<std::chrono::steady_clock::time_point> timeout_time
+    ) :
+            content_shared_ptr(std::move(content)), container_shared_ptr(std::move(container)),
+            executor(std::in_place, std::move(view_executor)), deadline(timeout_time),
+            shared(shared_lock), waiter(), status(access_status::expired)
+    {}
+    
+    ///Ready without suspending when the content has expired or the guard is free
+    inline bool await_ready()
+    {
+        if (!content_shared_ptr || !container_shared_ptr) return true;
+        if (container_shared_ptr->content_guard.try_acquire(shared))
+        {
+            status = access_status::acquired;
+            return true;
+        }
+        return false;
+    }
+    
+    inline bool await_suspend(std::coroutine_handle<> handle)
+    {
+        guard_t &guard = container_shared_ptr->content_guard;
+        auto queued = std::make_shared<awaitable_waiter_of<guard_t, executor_t>>(
+                container_shared_ptr, guard, std::move(*executor), shared
+        );
+        queued->handle = handle;
+        waiter = queued;
+        /// once queued, the coroutine may be resumed by another thread before this function returns,
+        /// so only locals are used afterwards
+        const std::optional<std::chrono::steady_clock::time_point> timeout_time = deadline;
+        if (guard.acquire_or_enqueue(queued, shared))
+        {
+            queued->settle();
+            return false;
+        }
+        if (timeout_time) awaitable_timer::instance().schedule(*timeout_time, queued);
+        return true;
+    }
+    
+    inline access_result<view_t> await_resume()
+    {
+        if (waiter) status = waiter->status;
+        if (status != access_status::acquired) return access_result<view_t>(status);
+        return access_result<view_t>(
+                view_t(
+                        std::move(content_shared_ptr), std::move(container_shared_ptr),
+                        lock_t(container_shared_ptr->content_guard, std::adopt_lock)
+                )
+        );
+    }
+};
+
+#endif
+
+#endif //HEADER_GUARD__7f2c9d14_3a8e_4b61_b5d0_9e46a1c83f27__awaitable_mutex_hpp
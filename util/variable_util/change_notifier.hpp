@@ -0,0 +1,307 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__71e0c4a9_3b5d_4f82_9c16_e8a2d5f03b97__change_notifier_hpp
+#define HEADER_GUARD__71e0c4a9_3b5d_4f82_9c16_e8a2d5f03b97__change_notifier_hpp
+
+#include "variable_util_includes.h"
+
+/**
+ * Outcome of weak_ptr::wait_for_change
+ */
+enum class change_status : std::uint8_t
+{
+    ///The version differs from the one passed by the caller
+    changed,
+    ///The version did not change before the timeout
+    timed_out,
+    ///The owner has been destroyed
+    expired
+};
+
+/**
+ * Result of weak_ptr::wait_for_change, the status and the version observed last
+ */
+class change_result final
+{
+private:
+    change_status status;
+    std::uint64_t observed_version;
+
+public:
+    inline explicit change_result(change_status result_status, std::uint64_t version) noexcept :
+            status(result_status), observed_version(version)
+    {}
+    
+    inline change_status get_status() const noexcept
+    {
+        return status;
+    }
+    
+    ///@return the version to pass to the next wait_for_change, meaningless when expired
+    inline std::uint64_t version() const noexcept
+    {
+        return observed_version;
+    }
+    
+    ///has the version changed
+    inline operator bool() const noexcept
+    {
+        return status == change_status::changed;
+    }
+};
+
+/**
+ * Wakes the threads waiting for a change of a content and runs its subscribers.
+ * Notified after a view has released content_guard, only if the view saw a watcher while it held content_guard,
+ * so that views of unwatched contents never write to the notifier.
+ * The subscriber list is only allocated by the first subscription.
+ * Subscribers run without any lock of the notifier, on a snapshot of the list,
+ * so a callback may subscribe, unsubscribe or destroy its own subscription.
+ */
+class change_notifier final
+{
+private:
+    struct subscriber final
+    {
+        const std::uint64_t id;
+        const std::function<void(std::uint64_t)> callback;
+        ///Cleared by unsubscribe, callbacks are not started afterwards
+        std::atomic<bool> subscribed;
+        ///Calls of callback in progress on any thread
+        std::atomic<std::uint32_t> running_count;
+        
+        inline explicit subscriber(
+                std::uint64_t subscriber_id, std::function<void(std::uint64_t)> &&subscriber_callback
+        ) :
+                id(subscriber_id), callback(std::move(subscriber_callback)), subscribed(true), running_count(0)
+        {}
+    };
+    
+    using subscriber_vector = std::vector<std::shared_ptr<subscriber>>;
+    
+    struct subscriber_list final
+    {
+        std::mutex guard;
+        ///Replaced on every change, notifications keep the snapshot they started with
+        std::shared_ptr<const subscriber_vector> entries = std::make_shared<const subscriber_vector>();
+        std::uint64_t next_id = 0;
+    };
+    
+    ///A callback running on this thread, so that unsubscribe called by it does not wait for itself
+    struct running_frame final
+    {
+        const subscriber *running;
+        const running_frame *outer;
+    };
+    
+    static inline thread_local const running_frame *innermost_frame = nullptr;
+    
+    ///Futex word, bumped by every notification and by expiry
+    std::atomic<std::uint32_t> sequence;
+    futex_waiting waiting;
+    std::atomic<subscriber_list *> subscribers;
+    ///Subscribers and threads inside weak_ptr::wait_for_change
+    std::atomic<std::uint32_t> watcher_count;
+    
+    inline explicit change_notifier(const change_notifier &) = delete;
+    
+    inline change_notifier &operator=(const change_notifier &) = delete;
+
+public:
+    inline explicit change_notifier() noexcept : sequence(0), waiting(), subscribers(nullptr), watcher_count(0)
+    {}
+    
+    inline ~change_notifier()
+    {
+        delete subscribers.load(std::memory_order_acquire);
+    }
+    
+    ///@return the futex word to pass to wait, read before checking the condition waited for
+    inline std::uint32_t observe() const noexcept
+    {
+        return sequence.load(std::memory_order_seq_cst);
+    }
+    
+    /**
+     * Block until notified after observe returned observed, or until timeout.
+     * Spurious wake-ups are allowed, callers must recheck their condition.
+     */
+    inline void wait(std::uint32_t observed, std::optional<std::chrono::nanoseconds> timeout_duration) noexcept
+    {
+        waiting.wait(sequence, observed, timeout_duration);
+    }
+    
+    /**
+     * Read by a view while it holds content_guard exclusively.
+     * Waiters register while they hold content_guard shared,
+     * so either the view sees the waiter or the waiter sees the version published by the view.
+     * @return whether a notification would reach anybody
+     */
+    inline bool watched() const noexcept
+    {
+        return watcher_count.load(std::memory_order_relaxed) != 0;
+    }
+    
+    ///Called by a waiter holding content_guard shared, before it reads the version
+    inline void add_watcher() noexcept
+    {
+        watcher_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    inline void remove_watcher() noexcept
+    {
+        watcher_count.fetch_sub(1, std::memory_order_relaxed);
+    }
+    
+    ///Wake the waiting threads without running the subscribers, used on expiry
+    inline void wake() noexcept
+    {
+        sequence.fetch_add(1, std::memory_order_seq_cst);
+        waiting.wake(sequence);
+    }
+    
+    /**
+     * Wake the waiting threads and run every subscriber with version.
+     * Called without content_guard held exclusively, from the destructor of a view,
+     * so exceptions thrown by callbacks are caught and dropped and the other subscribers still run.
+     * @param version
+     */
+    inline void notify(std::uint64_t version) noexcept
+    {
+        wake();
+        subscriber_list *const list = subscribers.load(std::memory_order_acquire);
+        if (!list) return;
+        std::shared_ptr<const subscriber_vector> snapshot;
+        {
+            std::lock_guard<std::mutex> subscriber_lock(list->guard);
+            snapshot = list->entries;
+        }
+        for (const std::shared_ptr<subscriber> &each: *snapshot)
+        {
+            /// seq_cst on both sides: either unsubscribe sees this call, or this call sees it unsubscribed
+            each->running_count.fetch_add(1, std::memory_order_seq_cst);
+            if (each->subscribed.load(std::memory_order_seq_cst))
+            {
+                const running_frame frame{each.get(), innermost_frame};
+                innermost_frame = &frame;
+                try
+                {
+                    each->callback(version);
+                }
+                catch (...)
+                {
+                }
+                innermost_frame = frame.outer;
+            }
+            each->running_count.fetch_sub(1, std::memory_order_release);
+        }
+    }
+    
+    /**
+     * @param callback callable with std::uint64_t, the version after the change
+     * @return id to pass to unsubscribe
+     */
+    inline std::uint64_t subscribe(std::function<void(std::uint64_t)> &&callback)
+    {
+        subscriber_list *list = subscribers.load(std::memory_order_acquire);
+        if (!list)
+        {
+            auto created = std::make_unique<subscriber_list>();
+            if (subscribers.compare_exchange_strong(list, created.get(), std::memory_order_acq_rel))
+                list = created.release();
+        }
+        std::lock_guard<std::mutex> subscriber_lock(list->guard);
+        auto changed = std::make_shared<subscriber_vector>(*list->entries);
+        changed->push_back(std::make_shared<subscriber>(list->next_id, std::move(callback)));
+        list->entries = std::move(changed);
+        add_watcher();
+        return list->next_id++;
+    }
+    
+    /**
+     * Waits for the calls of the callback in progress on other threads,
+     * so the callback is never called after it returns, except by the calls it is nested in
+     * when the callback unsubscribes itself.
+     * @param id returned by subscribe
+     */
+    inline void unsubscribe(std::uint64_t id)
+    {
+        subscriber_list *const list = subscribers.load(std::memory_order_acquire);
+        if (!list) return;
+        std::shared_ptr<subscriber> removed;
+        {
+            std::lock_guard<std::mutex> subscriber_lock(list->guard);
+            auto changed = std::make_shared<subscriber_vector>();
+            changed->reserve(list->entries->size());
+            for (const std::shared_ptr<subscriber> &each: *list->entries)
+            {
+                if (each->id == id) removed = each;
+                else changed->push_back(each);
+            }
+            if (!removed) return;
+            list->entries = std::move(changed);
+            remove_watcher();
+        }
+        removed->subscribed.store(false, std::memory_order_seq_cst);
+        std::uint32_t nested_count = 0;
+        for (const running_frame *frame = innermost_frame; frame; frame = frame->outer)
+            if (frame->running == removed.get()) ++nested_count;
+        for (unsigned retry_count = 0;
+             removed->running_count.load(std::memory_order_seq_cst) > nested_count; ++retry_count)
+        {
+            if (retry_count < 64) cpu_relax();
+            else std::this_thread::yield();
+        }
+    }
+};
+
+/**
+ * Subscription returned by weak_ptr::subscribe, which unsubscribes on destruction.
+ * It does not keep the content alive.
+ */
+class subscription final
+{
+private:
+    std::weak_ptr<change_notifier> notifier_weak_ptr;
+    std::uint64_t subscription_id;
+    
+    inline explicit subscription(const subscription &) = delete;
+    
+    inline subscription &operator=(const subscription &) = delete;
+
+public:
+    ///Empty subscription, returned for an expired content
+    inline explicit subscription() noexcept : notifier_weak_ptr(), subscription_id(0)
+    {}
+    
+    inline explicit subscription(const std::shared_ptr<change_notifier> &notifier, std::uint64_t id) noexcept :
+            notifier_weak_ptr(notifier), subscription_id(id)
+    {}
+    
+    /// Move constructor
+    inline subscription(subscription &&original) noexcept :
+            notifier_weak_ptr(std::move(original.notifier_weak_ptr)), subscription_id(original.subscription_id)
+    {}
+    
+    inline ~subscription()
+    {
+        reset();
+    }
+    
+    ///is the callback subscribed
+    inline operator bool() const noexcept
+    {
+        return !notifier_weak_ptr.expired();
+    }
+    
+    ///Unsubscribe now
+    inline void reset()
+    {
+        if (auto notifier = notifier_weak_ptr.lock(); notifier) notifier->unsubscribe(subscription_id);
+        notifier_weak_ptr.reset();
+    }
+};
+
+#endif //HEADER_GUARD__71e0c4a9_3b5d_4f82_9c16_e8a2d5f03b97__change_notifier_hpp
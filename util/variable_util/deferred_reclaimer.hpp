@@ -0,0 +1,213 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__9d4e1b7c_36a2_4f85_b0c9_e27a5f18d3b6__deferred_reclaimer_hpp
+#define HEADER_GUARD__9d4e1b7c_36a2_4f85_b0c9_e27a5f18d3b6__deferred_reclaimer_hpp
+
+#include "variable_util_includes.h"
+
+/**
+ * Tag selecting the constructor of referable_unique
+ * whose content is destroyed by deferred_reclaimer
+ */
+struct deferred_destruction_t final
+{
+    inline explicit deferred_destruction_t() = default;
+};
+
+inline constexpr deferred_destruction_t deferred_destruction{};
+
+/**
+ * Destroys expired contents away from the threads releasing them.
+ * A content constructed with deferred_destruction is queued here
+ * when its owner and its last view are gone, and destroyed by the background thread
+ * started with start() or by a thread calling drain().
+ * The queue holds at most capacity() contents. When it is full
+ * the releasing thread destroys the content itself, so the memory held by the queue is bounded.
+ * Contents still queued are destroyed when the process exits.
+ * Destructors of such contents must be safe to run on any thread.
+ */
+class deferred_reclaimer final
+{
+private:
+    struct retired_object
+    {
+        void *pointer;
+        
+        void (*deleter)(void *);
+    };
+    
+    static constexpr std::size_t default_capacity = 4096;
+    
+    std::mutex queue_guard;
+    std::condition_variable queue_condition;
+    std::vector<retired_object> queue;
+    std::size_t queue_capacity;
+    ///stopping: the background thread exits once the queue is empty
+    ///shut_down: set at exit, contents retired later are destroyed at once
+    bool stopping, shut_down;
+    std::thread background_thread;
+    
+    inline deferred_reclaimer() : queue_capacity(default_capacity), stopping(false), shut_down(false)
+    {
+        std::atexit([]() { instance().shutdown(); });
+    }
+    
+    inline explicit deferred_reclaimer(const deferred_reclaimer &) = delete;
+    
+    inline deferred_reclaimer &operator=(const deferred_reclaimer &) = delete;
+    
+    /**
+     * Loop of the background thread.
+     * On Linux the thread is scheduled as SCHED_IDLE,
+     * so that destructors only take CPU time which no other thread wants.
+     */
+    inline void run()
+    {
+#if defined(__linux__)
+        const sched_param idle_parameter{};
+        sched_setscheduler(0, SCHED_IDLE, &idle_parameter);
+#endif
+        std::vector<retired_object> expired_objects;
+        std::unique_lock<std::mutex> queue_lock(queue_guard);
+        while (true)
+        {
+            queue_condition.wait(queue_lock, [this]() { return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+            expired_objects.swap(queue);
+            queue_lock.unlock();
+            /// deleters may retire other contents, so they run without queue_guard
+            for (auto &expired: expired_objects) expired.deleter(expired.pointer);
+            expired_objects.clear();
+            queue_lock.lock();
+        }
+    }
+    
+    ///Stop the background thread and destroy everything queued, called at exit
+    inline void shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> queue_lock(queue_guard);
+            shut_down = true;
+        }
+        stop();
+        drain();
+    }
+
+public:
+    /**
+     * The instance is never destroyed,
+     * so that contents released during static destruction can still be retired.
+     */
+    inline static deferred_reclaimer &instance()
+    {
+        static deferred_reclaimer *const reclaimer = new deferred_reclaimer();
+        return *reclaimer;
+    }
+    
+    /**
+     * Queue pointer to be destroyed with deleter,
+     * or destroy it at once when the queue is full, cannot grow or the process is exiting.
+     * Called by the deleters of std::shared_ptr, so it never throws.
+     * @param pointer
+     * @param deleter
+     */
+    inline void retire(void *pointer, void (*deleter)(void *)) noexcept
+    {
+        bool queued = false, background = false;
+        {
+            std::lock_guard<std::mutex> queue_lock(queue_guard);
+            if (!shut_down && queue.size() < queue_capacity)
+            {
+                try
+                {
+                    queue.push_back(retired_object{pointer, deleter});
+                    queued = true;
+                    background = background_thread.joinable();
+                }
+                catch (const std::bad_alloc &)
+                {
+                    /// destroyed below on the calling thread, as if the queue were full
+                }
+            }
+        }
+        if (!queued) deleter(pointer);
+        else if (background) queue_condition.notify_one();
+    }
+    
+    /**
+     * Destroy every queued content on the calling thread
+     * @return number of destroyed contents
+     */
+    inline std::size_t drain()
+    {
+        std::size_t destroyed_count = 0;
+        std::vector<retired_object> expired_objects;
+        while (true)
+        {
+            {
+                std::lock_guard<std::mutex> queue_lock(queue_guard);
+                if (queue.empty()) return destroyed_count;
+                expired_objects.swap(queue);
+            }
+            for (auto &expired: expired_objects) expired.deleter(expired.pointer);
+            destroyed_count += expired_objects.size();
+            expired_objects.clear();
+        }
+    }
+    
+    /**
+     * Start the background thread destroying queued contents, if it is not running
+     */
+    inline void start()
+    {
+        std::lock_guard<std::mutex> queue_lock(queue_guard);
+        if (shut_down || background_thread.joinable()) return;
+        stopping = false;
+        background_thread = std::thread([this]() { run(); });
+    }
+    
+    /**
+     * Stop the background thread after it has emptied the queue.
+     * Must not be called by a destructor running on the background thread
+     * or concurrently with start().
+     */
+    inline void stop()
+    {
+        std::thread stopped_thread;
+        {
+            std::lock_guard<std::mutex> queue_lock(queue_guard);
+            stopping = true;
+            stopped_thread.swap(background_thread);
+        }
+        queue_condition.notify_all();
+        if (stopped_thread.joinable()) stopped_thread.join();
+    }
+    
+    ///@return maximum number of queued contents
+    inline std::size_t capacity()
+    {
+        std::lock_guard<std::mutex> queue_lock(queue_guard);
+        return queue_capacity;
+    }
+    
+    /**
+     * Contents already queued are kept when capacity is lowered
+     * @param capacity maximum number of queued contents, 0 destroys every content at once
+     */
+    inline void set_capacity(std::size_t capacity)
+    {
+        std::lock_guard<std::mutex> queue_lock(queue_guard);
+        queue_capacity = capacity;
+    }
+    
+    ///@return number of queued contents
+    inline std::size_t pending()
+    {
+        std::lock_guard<std::mutex> queue_lock(queue_guard);
+        return queue.size();
+    }
+};
+
+#endif //HEADER_GUARD__9d4e1b7c_36a2_4f85_b0c9_e27a5f18d3b6__deferred_reclaimer_hpp
@@ -0,0 +1,310 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__0c38bd3a_b68a_451c_9618_18e587dc85a2__epoch_hpp
+#define HEADER_GUARD__0c38bd3a_b68a_451c_9618_18e587dc85a2__epoch_hpp
+
+#include "variable_util_includes.h"
+
+/**
+ * Epoch based reclamation shared by the whole process.
+ * Readers pin the current global epoch with epoch_guard,
+ * which only writes a record owned by the calling thread.
+ * A retired object is destroyed after the global epoch has advanced twice,
+ * because no reader pinned before its retirement can remain by then.
+ * Each thread collects its retired objects when it leaves its outermost epoch_guard
+ * and every collect_interval retirements, or on every retirement once it holds more than
+ * limbo_object_limit objects or limbo_byte_limit bytes. retire never blocks, as it may be called
+ * while holding a lock a reader is waiting for. Retired memory is therefore bounded by the limits
+ * plus what a thread retires during two epochs, which only last as long as the longest epoch_guard.
+ * The domain is never destroyed, so that threads exiting during static destruction can still release their records.
+ */
+class epoch_domain final
+{
+private:
+    struct retired_object
+    {
+        void *pointer;
+        
+        void (*deleter)(void *);
+        
+        std::uint64_t epoch;
+        
+        ///Bytes reported to retire, counted against limbo_byte_limit
+        std::size_t size;
+    };
+    
+    struct alignas(64) thread_record
+    {
+        ///0 while the thread is quiescent, otherwise the global epoch it has pinned
+        std::atomic<std::uint64_t> pinned_epoch{0};
+        std::atomic<bool> in_use{true};
+        thread_record *next = nullptr;
+        
+        ///Following members are only accessed by the thread owning this record
+        unsigned nesting = 0;
+        ///Set while collect runs deleters, which may leave epoch guards of their own
+        bool collecting = false;
+        std::vector<retired_object> limbo;
+        std::size_t limbo_bytes = 0;
+    };
+    
+    /**
+     * Registration of the calling thread.
+     * On thread exit the record is released and its limbo is handed over as orphans.
+     */
+    class thread_handle final
+    {
+    public:
+        thread_record *const record;
+        
+        inline explicit thread_handle(epoch_domain &domain) : record(domain.acquire_record())
+        {}
+        
+        inline ~thread_handle()
+        {
+            instance().release_record(record);
+        }
+    };
+    
+    ///Retired objects are collected every collect_interval retirements of a thread
+    static constexpr std::size_t collect_interval = 64;
+    ///Retired objects of a thread beyond which every retire collects
+    static constexpr std::size_t limbo_object_limit = 256;
+    static constexpr std::size_t limbo_byte_limit = std::size_t(4) << 20;
+    
+    std::atomic<std::uint64_t> global_epoch{1};
+    std::atomic<thread_record *> records{nullptr};
+    std::mutex orphan_guard;
+    std::vector<retired_object> orphans;
+    
+    inline epoch_domain() = default;
+    
+    inline explicit epoch_domain(const epoch_domain &) = delete;
+    
+    inline epoch_domain &operator=(const epoch_domain &) = delete;
+    
+    inline thread_record *acquire_record()
+    {
+        for (thread_record *record = records.load(std::memory_order_acquire); record; record = record->next)
+        {
+            bool in_use = false;
+            if (!record->in_use.load(std::memory_order_relaxed) &&
+                record->in_use.compare_exchange_strong(in_use, true, std::memory_order_acquire))
+                return record;
+        }
+        thread_record *record = new thread_record();
+        record->next = records.load(std::memory_order_relaxed);
+        while (!records.compare_exchange_weak(
+                record->next, record, std::memory_order_release, std::memory_order_relaxed
+        ));
+        return record;
+    }
+    
+    inline void release_record(thread_record *record)
+    {
+        {
+            std::lock_guard<std::mutex> orphan_lock(orphan_guard);
+            orphans.insert(orphans.end(), record->limbo.begin(), record->limbo.end());
+        }
+        record->limbo.clear();
+        record->limbo_bytes = 0;
+        record->nesting = 0;
+        record->pinned_epoch.store(0, std::memory_order_relaxed);
+        record->in_use.store(false, std::memory_order_release);
+    }
+    
+    inline thread_record &local_record()
+    {
+        static thread_local thread_handle handle(*this);
+        return *handle.record;
+    }
+    
+    ///Advance the global epoch if every pinned thread has observed it
+    inline void try_advance() noexcept
+    {
+        std::uint64_t epoch = global_epoch.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (thread_record *record = records.load(std::memory_order_acquire); record; record = record->next)
+        {
+            const std::uint64_t pinned_epoch = record->pinned_epoch.load(std::memory_order_relaxed);
+            if (pinned_epoch != 0 && pinned_epoch != epoch) return;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        global_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_release);
+    }
+    
+    /**
+     * Move the objects of retired_objects which are safe to destroy into expired_objects
+     * @param retired_objects
+     * @param expired_objects
+     * @param epoch current global epoch
+     * @return bytes of the objects moved
+     */
+    static inline std::size_t take_expired(
+            std::vector<retired_object> &retired_objects,
+            std::vector<retired_object> &expired_objects,
+            std::uint64_t epoch
+    )
+    {
+        auto first_alive = std::partition(
+                retired_objects.begin(), retired_objects.end(),
+                [epoch](const retired_object &retired) { return retired.epoch + 2 <= epoch; }
+        );
+        std::size_t expired_bytes = 0;
+        for (auto retired = retired_objects.begin(); retired != first_alive; ++retired)
+            expired_bytes += retired->size;
+        expired_objects.insert(expired_objects.end(), retired_objects.begin(), first_alive);
+        retired_objects.erase(retired_objects.begin(), first_alive);
+        return expired_bytes;
+    }
+    
+    ///@return is the limbo of record beyond limbo_object_limit or limbo_byte_limit
+    static inline bool over_limit(const thread_record &record) noexcept
+    {
+        return record.limbo.size() > limbo_object_limit || record.limbo_bytes > limbo_byte_limit;
+    }
+
+public:
+    /**
+     * The domain is never destroyed, like referable_registry,
+     * so objects retired but not yet destroyed at exit are left to the operating system.
+     * @return the domain of the process
+     */
+    inline static epoch_domain &instance()
+    {
+        /// a union member is not destroyed, and unlike a heap pointer its address is known on the reader path
+        union never_destroyed
+        {
+            epoch_domain domain;
+            
+            inline never_destroyed() : domain()
+            {}
+            
+            inline ~never_destroyed()
+            {}
+        };
+        static never_destroyed holder;
+        return holder.domain;
+    }
+    
+    ///Pin the current epoch, nested calls only count
+    inline void enter() noexcept
+    {
+        thread_record &record = local_record();
+        if (record.nesting++ == 0)
+        {
+            record.pinned_epoch.store(global_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+    
+    ///Unpin when leaving the outermost critical section, then collect the objects retired by this thread
+    inline void leave() noexcept
+    {
+        thread_record &record = local_record();
+        if (--record.nesting == 0)
+        {
+            record.pinned_epoch.store(0, std::memory_order_release);
+            if (!record.limbo.empty() && !record.collecting) collect();
+        }
+    }
+    
+    /**
+     * Destroy pointer with deleter once no pinned reader can still reach it.
+     * pointer must already be unreachable for readers entering from now on.
+     * Never waits for readers, so it may be called while holding locks.
+     * @param pointer
+     * @param deleter
+     * @param size bytes held by pointer, counted against limbo_byte_limit
+     */
+    inline void retire(void *pointer, void (*deleter)(void *), std::size_t size = 0)
+    {
+        thread_record &record = local_record();
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        record.limbo.push_back(
+                retired_object{pointer, deleter, global_epoch.load(std::memory_order_relaxed), size}
+        );
+        record.limbo_bytes += size;
+        if (record.collecting) return;
+        if (record.limbo.size() % collect_interval == 0 || over_limit(record)) collect();
+    }
+    
+    /**
+     * Try to advance the global epoch and destroy the expired objects
+     * retired by the calling thread or left by exited threads.
+     */
+    inline void collect()
+    {
+        thread_record &record = local_record();
+        try_advance();
+        const std::uint64_t epoch = global_epoch.load(std::memory_order_acquire);
+        std::vector<retired_object> expired_objects;
+        record.limbo_bytes -= take_expired(record.limbo, expired_objects, epoch);
+        if (std::unique_lock<std::mutex> orphan_lock(orphan_guard, std::try_to_lock);orphan_lock)
+        {
+            take_expired(orphans, expired_objects, epoch);
+        }
+        /// deleters may retire other objects, so they run after the limbo is updated
+        const bool nested = record.collecting;
+        record.collecting = true;
+        for (auto &expired: expired_objects) expired.deleter(expired.pointer);
+        record.collecting = nested;
+    }
+    
+    /**
+     * Block until the objects retired by the calling thread
+     * and by exited threads have been destroyed.
+     * Must not be called while the calling thread holds an epoch_guard.
+     */
+    inline void synchronize()
+    {
+        while (true)
+        {
+            collect();
+            bool has_orphan;
+            {
+                std::lock_guard<std::mutex> orphan_lock(orphan_guard);
+                has_orphan = !orphans.empty();
+            }
+            if (local_record().limbo.empty() && !has_orphan) return;
+            std::this_thread::yield();
+        }
+    }
+};
+
+/**
+ * Critical section of epoch_domain.
+ * Objects reachable when the guard is created stay alive until it is destroyed.
+ * The guard belongs to the thread which created it and must be destroyed by that thread.
+ */
+class epoch_guard final
+{
+private:
+    bool pinned;
+    
+    inline explicit epoch_guard(const epoch_guard &) = delete;
+    
+    inline epoch_guard &operator=(const epoch_guard &) = delete;
+    
+    inline epoch_guard &operator=(epoch_guard &&) = delete;
+
+public:
+    inline epoch_guard() noexcept : pinned(true)
+    {
+        epoch_domain::instance().enter();
+    }
+    
+    inline epoch_guard(epoch_guard &&original) noexcept : pinned(original.pinned)
+    {
+        original.pinned = false;
+    }
+    
+    inline ~epoch_guard()
+    {
+        if (pinned) epoch_domain::instance().leave();
+    }
+};
+
+#endif //HEADER_GUARD__0c38bd3a_b68a_451c_9618_18e587dc85a2__epoch_hpp
@@ -0,0 +1,222 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__5b8e0f27_9c3d_4e61_a4f2_7d19c6b03e85__flat_combining_hpp
+#define HEADER_GUARD__5b8e0f27_9c3d_4e61_a4f2_7d19c6b03e85__flat_combining_hpp
+
+#include "variable_util_includes.h"
+
+/**
+ * A mutation published to a combining_queue.
+ * The request lives on the stack of the publishing thread,
+ * which does not return before completed is set.
+ * @tparam T content type
+ */
+template<typename T>
+class combining_request
+{
+private:
+    template<typename> friend
+    class combining_queue;
+    
+    ///Runs the mutation, exceptions are stored in failure
+    void (*const run)(combining_request &, T &) noexcept;
+    
+    combining_request *next;
+    
+    std::atomic<bool> completed;
+    
+    inline explicit combining_request(const combining_request &) = delete;
+    
+    inline combining_request &operator=(const combining_request &) = delete;
+
+protected:
+    std::exception_ptr failure;
+    
+    inline explicit combining_request(void (*run_request)(combining_request &, T &) noexcept) noexcept :
+            run(run_request), next(nullptr), completed(false), failure()
+    {}
+
+public:
+    inline bool is_completed() const noexcept
+    {
+        return completed.load(std::memory_order_acquire);
+    }
+    
+    ///Rethrow the exception thrown by the mutation, called by the publishing thread once completed
+    inline void rethrow_failure() const
+    {
+        if (failure) std::rethrow_exception(failure);
+    }
+};
+
+/**
+ * A combining_request running function(content), which keeps the result for the publishing thread
+ * @tparam T content type
+ * @tparam function_t callable with T &
+ */
+template<typename T, typename function_t>
+class apply_request final : public combining_request<T>
+{
+private:
+    using result_type = std::invoke_result_t<function_t, T &>;
+    ///A reference into the content would outlive content_guard, so the referred object is copied instead
+    using stored_type = std::remove_cv_t<std::remove_reference_t<result_type>>;
+    
+    function_t &function;
+
+public:
+    ///Empty for function returning void
+    std::optional<std::conditional_t<std::is_void_v<result_type>, bool, stored_type>> result;
+    
+    inline explicit apply_request(function_t &request_function) noexcept :
+            combining_request<T>(&apply_request::run_request), function(request_function), result()
+    {}
+
+private:
+    static inline void run_request(combining_request<T> &request, T &content) noexcept
+    {
+        apply_request &self = static_cast<apply_request &>(request);
+        try
+        {
+            if constexpr (std::is_void_v<result_type>) std::invoke(self.function, content);
+            else self.result.emplace(std::invoke(self.function, content));
+        }
+        catch (...)
+        {
+            self.failure = std::current_exception();
+        }
+    }
+};
+
+/**
+ * A combining_request running every function of [first, last) in order.
+ * A throwing function stops the batch.
+ * @tparam T content type
+ * @tparam iterator_t input iterator of callables with T &
+ */
+template<typename T, typename iterator_t>
+class apply_batch_request final : public combining_request<T>
+{
+private:
+    iterator_t first, last;
+
+public:
+    inline explicit apply_batch_request(iterator_t batch_first, iterator_t batch_last) noexcept :
+            combining_request<T>(&apply_batch_request::run_request), first(batch_first), last(batch_last)
+    {}
+
+private:
+    static inline void run_request(combining_request<T> &request, T &content) noexcept
+    {
+        apply_batch_request &self = static_cast<apply_batch_request &>(request);
+        try
+        {
+            for (iterator_t current = self.first; current != self.last; ++current) std::invoke(*current, content);
+        }
+        catch (...)
+        {
+            self.failure = std::current_exception();
+        }
+    }
+};
+
+/**
+ * Flat combining of mutations.
+ * Threads publish requests with a single CAS, and the thread holding content_guard exclusively
+ * runs all the published requests in one critical section,
+ * so the content stays in the cache of one core instead of following the lock.
+ * @tparam T content type
+ */
+template<typename T>
+class combining_queue final
+{
+private:
+    ///Published requests, the most recent first
+    std::atomic<combining_request<T> *> pending;
+    
+    inline explicit combining_queue(const combining_queue &) = delete;
+    
+    inline combining_queue &operator=(const combining_queue &) = delete;
+
+public:
+    ///Retries of combine_or_wait before it blocks on content_guard
+    static constexpr unsigned spin_limit = 1024;
+    
+    inline explicit combining_queue() noexcept : pending(nullptr)
+    {}
+    
+    inline bool empty() const noexcept
+    {
+        return pending.load(std::memory_order_acquire) == nullptr;
+    }
+    
+    inline void publish(combining_request<T> &request) noexcept
+    {
+        combining_request<T> *head = pending.load(std::memory_order_relaxed);
+        do request.next = head;
+        while (!pending.compare_exchange_weak(head, &request, std::memory_order_release, std::memory_order_relaxed));
+    }
+    
+    /**
+     * Called with content_guard locked exclusively.
+     * Runs every published request in publication order, including those published meanwhile.
+     * @param content
+     */
+    inline void run_pending(T &content) noexcept
+    {
+        while (pending.load(std::memory_order_relaxed))
+        {
+            combining_request<T> *head = pending.exchange(nullptr, std::memory_order_acquire);
+            combining_request<T> *ordered = nullptr;
+            while (head)
+            {
+                combining_request<T> *const next = head->next;
+                head->next = ordered;
+                ordered = head;
+                head = next;
+            }
+            while (ordered)
+            {
+                /// the request is gone as soon as completed is set
+                combining_request<T> *const next = ordered->next;
+                ordered->run(*ordered, content);
+                ordered->completed.store(true, std::memory_order_release);
+                ordered = next;
+            }
+        }
+    }
+    
+    /**
+     * Wait until request has been run by the holder of content_guard,
+     * or become the combiner when content_guard is free.
+     * Blocks on content_guard after spin_limit retries, so a long-living view does not keep it spinning.
+     * @tparam unique_lock_type exclusive lock of content_guard
+     * @tparam lock_policy
+     * @tparam combine_t nullary callable running the pending requests, called with content_guard locked
+     * @param request published request
+     * @param content_guard
+     * @param combine
+     */
+    template<typename unique_lock_type, typename lock_policy, typename combine_t>
+    static inline void combine_or_wait(
+            const combining_request<T> &request, lock_policy &content_guard, combine_t &&combine
+    )
+    {
+        for (unsigned retry_count = 0; !request.is_completed(); ++retry_count)
+        {
+            if (unique_lock_type content_guard_lock(content_guard, std::try_to_lock); content_guard_lock)
+                combine();
+            else if (retry_count < 64) cpu_relax();
+            else if (retry_count < spin_limit) std::this_thread::yield();
+            else
+            {
+                unique_lock_type blocking_lock(content_guard);
+                combine();
+            }
+        }
+    }
+};
+
+#endif //HEADER_GUARD__5b8e0f27_9c3d_4e61_a4f2_7d19c6b03e85__flat_combining_hpp
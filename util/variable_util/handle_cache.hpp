@@ -0,0 +1,404 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__d6f41b83_2e9a_47c5_8b0d_5a3e92c71f04__handle_cache_hpp
+#define HEADER_GUARD__d6f41b83_2e9a_47c5_8b0d_5a3e92c71f04__handle_cache_hpp
+
+#include "variable_util_includes.h"
+
+/**
+ * Per-thread cache of pinned referable_unique<T, lock_policy> contents.
+ * The first access through a weak_ptr pins the content with one std::shared_ptr copy,
+ * later accesses find the pin by address and skip every reference count,
+ * checking only the retired flag which the owner sets when it is destroyed.
+ * The least recently used pins beyond capacity are released, except those with a live view.
+ * The destruction of a pinned content is delayed past the destruction of its owner:
+ * the pin is only released when an access finds it retired, when a sweep runs,
+ * every sweep_interval accesses of the thread or on an explicit call, when it is evicted or cleared,
+ * or when the thread exits.
+ * Views of the cache must be destroyed by the thread which took them, before it exits.
+ * @tparam T non-const content type
+ * @tparam lock_policy
+ */
+template<typename T, typename lock_policy = VARIABLE_UTIL_DEFAULT_LOCK_POLICY>
+class handle_cache final
+{
+private:
+    using referable_unique_type = referable_unique<T, lock_policy>;
+    using weak_ptr_type = typename referable_unique_type::weak_ptr;
+    using Container = typename referable_unique_type::Container;
+    using unique_lock_type = typename lock_traits<lock_policy>::unique_lock_type;
+    using shared_lock_type = typename lock_traits<lock_policy>::shared_lock_type;
+    
+    struct pin final
+    {
+        std::shared_ptr<T> content;
+        std::shared_ptr<Container> container;
+        ///Live views of this pin, which is not released before they are destroyed
+        std::size_t view_count;
+    };
+    
+    ///Most recently used first
+    std::list<pin> pins;
+    std::unordered_map<const Container *, typename std::list<pin>::iterator> pin_index;
+    std::size_t pin_capacity;
+    ///Accesses since the last sweep
+    std::size_t access_count;
+    
+    inline explicit handle_cache(const handle_cache &) = delete;
+    
+    inline handle_cache &operator=(const handle_cache &) = delete;
+    
+    inline explicit handle_cache() : pins(), pin_index(), pin_capacity(default_capacity), access_count(0)
+    {}
+
+public:
+    static constexpr std::size_t default_capacity = 256;
+    
+    ///Accesses between two sweeps of the retired pins
+    static constexpr std::size_t sweep_interval = 1024;
+    
+    ///@return the cache of the calling thread
+    static inline handle_cache &local()
+    {
+        static thread_local handle_cache cache;
+        return cache;
+    }
+    
+    class const_view final
+    {
+    private:
+        friend class handle_cache;
+        
+        pin *pinned;
+        typename referable_unique_type::borrowed_const_view borrowed;
+        
+        ///Disable default constructor
+        inline explicit const_view() = delete;
+        
+        ///Disable copy constructor
+        inline explicit const_view(const const_view &) = delete;
+        
+        inline const const_view &operator=(const const_view &) = delete;
+        
+        inline const const_view &operator=(const_view &&) = delete;
+        
+        ///Constructor used by handle_cache
+        inline explicit const_view(pin &content_pin, shared_lock_type &&content_lock) noexcept :
+                pinned(&content_pin),
+                borrowed(*content_pin.content, *content_pin.container, std::move(content_lock))
+        {
+            ++pinned->view_count;
+        }
+    
+    public:
+        /// Move constructor
+        inline explicit const_view(const_view &&original) :
+                pinned(original.pinned), borrowed(std::move(original.borrowed))
+        {
+            original.pinned = nullptr;
+        }
+        
+        inline ~const_view()
+        {
+            if (pinned) --pinned->view_count;
+        }
+        
+        ///is this view valid
+        inline operator bool() const
+        {
+            return (bool) borrowed;
+        }
+        
+        ///@return id of the content
+        inline const referable_tag &id() const noexcept
+        {
+            return borrowed.id();
+        }
+        
+        ///@return label of the content
+        inline const referable_tag &label() const noexcept
+        {
+            return borrowed.label();
+        }
+        
+        inline const T &operator*()
+        {
+            return *borrowed;
+        }
+        
+        inline const T *operator->()
+        {
+            return borrowed.operator->();
+        }
+    };
+    
+    class view final
+    {
+    private:
+        friend class handle_cache;
+        
+        pin *pinned;
+        typename referable_unique_type::borrowed_view borrowed;
+        
+        ///Disable default constructor
+        inline explicit view() = delete;
+        
+        ///Disable copy constructor
+        inline explicit view(const view &) = delete;
+        
+        inline const view &operator=(const view &) = delete;
+        
+        inline const view &operator=(view &&) = delete;
+        
+        ///Constructor used by handle_cache
+        inline explicit view(pin &content_pin, unique_lock_type &&content_lock) noexcept :
+                pinned(&content_pin),
+                borrowed(*content_pin.content, *content_pin.container, std::move(content_lock))
+        {
+            ++pinned->view_count;
+        }
+    
+    public:
+        /// Move constructor
+        inline explicit view(view &&original) :
+                pinned(original.pinned), borrowed(std::move(original.borrowed))
+        {
+            original.pinned = nullptr;
+        }
+        
+        inline ~view()
+        {
+            if (pinned) --pinned->view_count;
+        }
+        
+        ///is this view valid
+        inline operator bool() const
+        {
+            return (bool) borrowed;
+        }
+        
+        ///@return id of the content
+        inline const referable_tag &id() const noexcept
+        {
+            return borrowed.id();
+        }
+        
+        ///@return label of the content
+        inline const referable_tag &label() const noexcept
+        {
+            return borrowed.label();
+        }
+        
+        inline T &operator*()
+        {
+            return *borrowed;
+        }
+        
+        inline T *operator->()
+        {
+            return borrowed.operator->();
+        }
+        
+        inline T &operator=(const T &t)
+        {
+            return borrowed = t;
+        }
+    };
+    
+    inline std::size_t capacity() const noexcept
+    {
+        return pin_capacity;
+    }
+    
+    /**
+     * Pins beyond the new capacity are released at once, except those with a live view
+     * @param capacity
+     */
+    inline void set_capacity(std::size_t capacity)
+    {
+        pin_capacity = capacity;
+        evict();
+    }
+    
+    ///@return number of pins
+    inline std::size_t size() const noexcept
+    {
+        return pins.size();
+    }
+    
+    /**
+     * Release the pins of contents whose owner has been destroyed, except those with a live view
+     * @return number of released pins
+     */
+    inline std::size_t sweep()
+    {
+        access_count = 0;
+        std::size_t released_count = 0;
+        for (auto current = pins.begin(); current != pins.end();)
+        {
+            if (current->view_count || !current->container->retired.load(std::memory_order_acquire)) ++current;
+            else
+            {
+                current = release(current);
+                ++released_count;
+            }
+        }
+        return released_count;
+    }
+    
+    ///Release every pin without a live view
+    inline void clear()
+    {
+        for (auto current = pins.begin(); current != pins.end();)
+        {
+            if (current->view_count) ++current;
+            else current = release(current);
+        }
+    }
+    
+    /**
+     * Release the pin of the content of weak unless a view of it is alive
+     * @param weak
+     */
+    inline void unpin(const weak_ptr_type &weak)
+    {
+        if (auto found = find(weak); found != pins.end() && !found->view_count) release(found);
+    }
+    
+    /**
+     * @return std::optional<const_view>
+     * @throw std::bad_weak_ptr when the content has expired
+     */
+    inline std::optional<const_view> get_const_view(const weak_ptr_type &weak)
+    {
+        if (access_result<const_view> result = try_get_const_view(weak); result)
+            return std::move(result.to_optional());
+        throw std::bad_weak_ptr();
+    }
+    
+    /**
+     * @return std::optional<view>
+     * @throw std::bad_weak_ptr when the content has expired
+     */
+    inline std::optional<view> get_view(const weak_ptr_type &weak)
+    {
+        if (access_result<view> result = try_get_view(weak); result) return std::move(result.to_optional());
+        throw std::bad_weak_ptr();
+    }
+    
+    /**
+     * Blocking version of get_const_view which reports expiry instead of throwing
+     * @return access_status::acquired or access_status::expired
+     */
+    inline access_result<const_view> try_get_const_view(const weak_ptr_type &weak)
+    {
+        return try_acquire<const_view, shared_lock_type>(weak, access_status::acquired);
+    }
+    
+    /**
+     * Create a const_view only if the content can be locked without waiting
+     * @return access_status::acquired, access_status::expired or access_status::contended
+     */
+    inline access_result<const_view> try_lock_const_view(const weak_ptr_type &weak)
+    {
+        return try_acquire<const_view, shared_lock_type>(weak, access_status::contended, std::try_to_lock);
+    }
+    
+    /**
+     * Blocking version of get_view which reports expiry instead of throwing
+     * @return access_status::acquired or access_status::expired
+     */
+    inline access_result<view> try_get_view(const weak_ptr_type &weak)
+    {
+        return try_acquire<view, unique_lock_type>(weak, access_status::acquired);
+    }
+    
+    /**
+     * Create a view only if the content can be locked without waiting
+     * @return access_status::acquired, access_status::expired or access_status::contended
+     */
+    inline access_result<view> try_lock_view(const weak_ptr_type &weak)
+    {
+        return try_acquire<view, unique_lock_type>(weak, access_status::contended, std::try_to_lock);
+    }
+
+private:
+    ///@return the pin of the content of weak, or pins.end()
+    inline typename std::list<pin>::iterator find(const weak_ptr_type &weak)
+    {
+        const auto indexed = pin_index.find(weak.container_raw_ptr);
+        if (indexed == pin_index.end()) return pins.end();
+        const std::shared_ptr<Container> &pinned_container = indexed->second->container;
+        if (pinned_container.owner_before(weak.container_weak_ptr) ||
+            weak.container_weak_ptr.owner_before(pinned_container))
+            return pins.end();
+        return indexed->second;
+    }
+    
+    ///@return the pin following the released one
+    inline typename std::list<pin>::iterator release(typename std::list<pin>::iterator released)
+    {
+        pin_index.erase(released->container.get());
+        return pins.erase(released);
+    }
+    
+    ///Release the least recently used pins without a live view until size is within capacity
+    inline void evict()
+    {
+        for (auto current = pins.end(); current != pins.begin() && pins.size() > pin_capacity;)
+        {
+            --current;
+            if (!current->view_count) current = release(current);
+        }
+    }
+    
+    /**
+     * Find or create the pin of the content of weak and lock it
+     * @tparam view_type view or const_view
+     * @tparam lock_type guard type held by view_type
+     * @param failure status returned when the lock is not owned after construction
+     * @param lock_args std::try_to_lock or nothing
+     */
+    template<typename view_type, typename lock_type, typename ...lock_args_t>
+    inline access_result<view_type> try_acquire(
+            const weak_ptr_type &weak, access_status failure, lock_args_t &&...lock_args
+    )
+    {
+        if (++access_count >= sweep_interval) sweep();
+        typename std::list<pin>::iterator found;
+        if (const auto indexed = pin_index.find(weak.container_raw_ptr); indexed != pin_index.end())
+        {
+            found = indexed->second;
+            /// a pinned Container is alive, so another owner at its address means weak has expired
+            if (found->container.owner_before(weak.container_weak_ptr) ||
+                weak.container_weak_ptr.owner_before(found->container))
+                return access_result<view_type>(access_status::expired);
+            if (found->container->retired.load(std::memory_order_acquire))
+            {
+                if (!found->view_count) release(found);
+                return access_result<view_type>(access_status::expired);
+            }
+            pins.splice(pins.begin(), pins, found);
+        }
+        else
+        {
+            std::shared_ptr<T> content_shared_pointer(weak.content_weak_ptr.lock());
+            std::shared_ptr<Container> container_shared_pointer(weak.container_weak_ptr.lock());
+            if (!content_shared_pointer || !container_shared_pointer ||
+                container_shared_pointer->retired.load(std::memory_order_acquire))
+                return access_result<view_type>(access_status::expired);
+            pins.push_front(pin{std::move(content_shared_pointer), std::move(container_shared_pointer), 0});
+            found = pins.begin();
+            pin_index.emplace(found->container.get(), found);
+        }
+        lock_type content_guard_lock(found->container->content_guard, std::forward<lock_args_t>(lock_args)...);
+        if (!content_guard_lock) return access_result<view_type>(failure);
+        access_result<view_type> result(view_type(*found, std::move(content_guard_lock)));
+        evict();
+        return result;
+    }
+};
+
+#endif //HEADER_GUARD__d6f41b83_2e9a_47c5_8b0d_5a3e92c71f04__handle_cache_hpp
@@ -0,0 +1,478 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__41c7e8a2_6b5d_4f93_a0e1_8d2f7c35b964__instrumented_mutex_hpp
+#define HEADER_GUARD__41c7e8a2_6b5d_4f93_a0e1_8d2f7c35b964__instrumented_mutex_hpp
+
+#include "variable_util_includes.h"
+
+/**
+ * Accumulated statistics of the content guard of one referable_unique
+ */
+struct lock_record
+{
+    referable_tag id, label;
+    ///Successful acquisitions, shared or exclusive
+    std::uint64_t acquisition_count = 0;
+    ///Acquisitions which had to wait, including timed ones which gave up
+    std::uint64_t contention_count = 0;
+    std::chrono::nanoseconds total_wait{0}, max_wait{0}, total_hold{0}, max_hold{0};
+    /**
+     * Bucket i counts the events lasting less than 2^i nanoseconds and at least 2^(i-1),
+     * the last bucket also counts every longer event
+     */
+    std::array<std::uint64_t, 32> wait_histogram{}, hold_histogram{};
+    
+    ///Histogram bucket of duration
+    static inline std::size_t bucket_of(std::chrono::nanoseconds duration) noexcept
+    {
+        std::size_t bucket = 0;
+        for (auto remaining = static_cast<std::uint64_t>(std::max<std::int64_t>(duration.count(), 0));
+             remaining != 0 && bucket < 31; remaining >>= 1)
+            ++bucket;
+        return bucket;
+    }
+};
+
+/**
+ * Process wide collector of the events of every instrumented_mutex.
+ * Each thread appends its events to its own buffer without synchronization,
+ * and folds the buffer into the shared records under statistics_guard when it is full.
+ */
+class lock_statistics final
+{
+private:
+    struct event
+    {
+        std::uint64_t serial;
+        std::chrono::nanoseconds wait, hold;
+        bool acquired, contended;
+    };
+    
+    static constexpr std::size_t buffer_capacity = 256;
+    
+    /**
+     * Events of one thread.
+     * Only the owning thread writes events, at index published and above,
+     * and only under statistics_guard it resets published,
+     * so snapshot can read events below published under statistics_guard.
+     */
+    struct thread_buffer final
+    {
+        event events[buffer_capacity];
+        std::atomic<std::size_t> published{0};
+        ///Events below discarded were published before the last reset, guarded by statistics_guard
+        std::size_t discarded = 0;
+        
+        inline thread_buffer()
+        {
+            instance().attach(*this);
+        }
+        
+        inline ~thread_buffer()
+        {
+            instance().detach(*this);
+        }
+    };
+    
+    std::mutex statistics_guard;
+    std::vector<thread_buffer *> buffers;
+    std::unordered_map<std::uint64_t, lock_record> records;
+    std::uint64_t next_serial = 1;
+    
+    inline lock_statistics() = default;
+    
+    inline explicit lock_statistics(const lock_statistics &) = delete;
+    
+    inline lock_statistics &operator=(const lock_statistics &) = delete;
+    
+    static inline void fold(lock_record &record, const event &happened) noexcept
+    {
+        record.acquisition_count += happened.acquired;
+        record.contention_count += happened.contended;
+        record.total_wait += happened.wait;
+        record.max_wait = std::max(record.max_wait, happened.wait);
+        record.total_hold += happened.hold;
+        record.max_hold = std::max(record.max_hold, happened.hold);
+        ++record.wait_histogram[lock_record::bucket_of(happened.wait)];
+        if (happened.acquired) ++record.hold_histogram[lock_record::bucket_of(happened.hold)];
+    }
+    
+    ///Called with statistics_guard locked, events of forgotten objects are dropped
+    inline void fold_buffer(thread_buffer &buffer) noexcept
+    {
+        const std::size_t published = buffer.published.load(std::memory_order_relaxed);
+        for (std::size_t index = buffer.discarded; index < published; ++index)
+        {
+            if (auto found = records.find(buffer.events[index].serial); found != records.end())
+                fold(found->second, buffer.events[index]);
+        }
+        buffer.discarded = 0;
+        buffer.published.store(0, std::memory_order_relaxed);
+    }
+    
+    inline void attach(thread_buffer &buffer)
+    {
+        std::lock_guard<std::mutex> statistics_lock(statistics_guard);
+        buffers.push_back(&buffer);
+    }
+    
+    inline void detach(thread_buffer &buffer) noexcept
+    {
+        std::lock_guard<std::mutex> statistics_lock(statistics_guard);
+        fold_buffer(buffer);
+        buffers.erase(std::find(buffers.begin(), buffers.end(), &buffer));
+    }
+    
+    static inline thread_buffer &local_buffer()
+    {
+        static thread_local thread_buffer buffer;
+        return buffer;
+    }
+
+public:
+    /**
+     * The collector is never destroyed,
+     * so that threads and objects outliving static destruction can still report.
+     */
+    inline static lock_statistics &instance()
+    {
+        static lock_statistics *const statistics = new lock_statistics();
+        return *statistics;
+    }
+    
+    /**
+     * @return serial identifying a new instrumented object
+     */
+    inline std::uint64_t enroll()
+    {
+        std::lock_guard<std::mutex> statistics_lock(statistics_guard);
+        const std::uint64_t serial = next_serial++;
+        records.try_emplace(serial);
+        return serial;
+    }
+    
+    ///Set the tags reported for serial
+    inline void describe(std::uint64_t serial, const referable_tag &id, const referable_tag &label)
+    {
+        std::lock_guard<std::mutex> statistics_lock(statistics_guard);
+        if (auto found = records.find(serial); found != records.end())
+        {
+            found->second.id = id;
+            found->second.label = label;
+        }
+    }
+    
+    ///Drop the record of a destroyed object
+    inline void forget(std::uint64_t serial) noexcept
+    {
+        std::lock_guard<std::mutex> statistics_lock(statistics_guard);
+        records.erase(serial);
+    }
+    
+    /**
+     * Append one event to the buffer of the calling thread
+     * @param serial object of the event
+     * @param wait time spent waiting for the guard
+     * @param hold time the guard was held, zero if it was not acquired
+     * @param acquired whether the guard was acquired
+     * @param contended whether the guard was not immediately available
+     */
+    inline void record(
+            std::uint64_t serial, std::chrono::nanoseconds wait, std::chrono::nanoseconds hold,
+            bool acquired, bool contended
+    )
+    {
+        thread_buffer &buffer = local_buffer();
+        std::size_t published = buffer.published.load(std::memory_order_relaxed);
+        if (published == buffer_capacity)
+        {
+            std::lock_guard<std::mutex> statistics_lock(statistics_guard);
+            fold_buffer(buffer);
+            published = 0;
+        }
+        buffer.events[published] = event{serial, wait, hold, acquired, contended};
+        buffer.published.store(published + 1, std::memory_order_release);
+    }
+    
+    /**
+     * Records of the live instrumented objects which have been locked or waited for,
+     * including the events still buffered by every thread.
+     * @param top_count maximum number of records returned
+     * @return the records with the longest total wait first,
+     * then the most contended, then the longest total hold
+     */
+    inline std::vector<lock_record> snapshot(std::size_t top_count = SIZE_MAX)
+    {
+        std::vector<lock_record> hottest;
+        {
+            std::lock_guard<std::mutex> statistics_lock(statistics_guard);
+            std::unordered_map<std::uint64_t, lock_record> merged(records);
+            for (thread_buffer *buffer: buffers)
+            {
+                const std::size_t published = buffer->published.load(std::memory_order_acquire);
+                for (std::size_t index = buffer->discarded; index < published; ++index)
+                {
+                    if (auto found = merged.find(buffer->events[index].serial); found != merged.end())
+                        fold(found->second, buffer->events[index]);
+                }
+            }
+            hottest.reserve(merged.size());
+            for (auto &each: merged)
+            {
+                if (each.second.acquisition_count != 0 || each.second.contention_count != 0)
+                    hottest.push_back(std::move(each.second));
+            }
+        }
+        const auto hotter = [](const lock_record &left, const lock_record &right)
+        {
+            if (left.total_wait != right.total_wait) return left.total_wait > right.total_wait;
+            if (left.contention_count != right.contention_count)
+                return left.contention_count > right.contention_count;
+            return left.total_hold > right.total_hold;
+        };
+        if (top_count < hottest.size())
+        {
+            std::partial_sort(hottest.begin(), hottest.begin() + top_count, hottest.end(), hotter);
+            hottest.resize(top_count);
+        }
+        else std::sort(hottest.begin(), hottest.end(), hotter);
+        return hottest;
+    }
+    
+    /**
+     * Clear the accumulated statistics of every live object,
+     * including the events buffered by every thread.
+     */
+    inline void reset()
+    {
+        std::lock_guard<std::mutex> statistics_lock(statistics_guard);
+        for (thread_buffer *buffer: buffers)
+            buffer->discarded = buffer->published.load(std::memory_order_acquire);
+        for (auto &[serial, record]: records)
+        {
+            referable_tag id(record.id), label(record.label);
+            record = lock_record();
+            record.id = id;
+            record.label = label;
+        }
+    }
+};
+
+/**
+ * Lock policy which forwards to mutex_t and reports to lock_statistics,
+ * for each acquisition, the time spent waiting, the time held and whether it was contended.
+ * Objects using any other lock policy pay nothing.
+ * Hold time of shared acquisitions is tracked per thread,
+ * so it is not reported for a const_view destroyed by another thread.
+ * @tparam mutex_t wrapped lock, std::shared_timed_mutex, spin_shared_mutex, std::mutex ...
+ */
+template<typename mutex_t = std::shared_timed_mutex>
+class instrumented_mutex final
+{
+private:
+    using clock = std::chrono::steady_clock;
+    
+    struct shared_hold
+    {
+        const instrumented_mutex *mutex;
+        clock::time_point acquired_at;
+        std::chrono::nanoseconds wait;
+        bool contended;
+    };
+    
+    ///Shared acquisitions of the calling thread which are not released yet
+    struct shared_hold_stack
+    {
+        static constexpr std::size_t capacity = 8;
+        shared_hold holds[capacity];
+        std::size_t size = 0;
+    };
+    
+    mutex_t mutex;
+    const std::uint64_t serial;
+    
+    ///Written by the exclusive holder only
+    clock::time_point exclusive_acquired_at;
+    std::chrono::nanoseconds exclusive_wait{0};
+    bool exclusive_contended = false;
+    
+    inline explicit instrumented_mutex(const instrumented_mutex &) = delete;
+    
+    inline instrumented_mutex &operator=(const instrumented_mutex &) = delete;
+    
+    static inline shared_hold_stack &local_shared_holds() noexcept
+    {
+        static thread_local shared_hold_stack stack;
+        return stack;
+    }
+    
+    inline void acquired(clock::time_point acquired_at, std::chrono::nanoseconds wait, bool contended) noexcept
+    {
+        exclusive_acquired_at = acquired_at;
+        exclusive_wait = wait;
+        exclusive_contended = contended;
+    }
+    
+    inline void acquired_shared(clock::time_point acquired_at, std::chrono::nanoseconds wait, bool contended)
+    {
+        shared_hold_stack &stack = local_shared_holds();
+        if (stack.size < shared_hold_stack::capacity)
+            stack.holds[stack.size++] = shared_hold{this, acquired_at, wait, contended};
+        else
+            lock_statistics::instance().record(serial, wait, std::chrono::nanoseconds(0), true, contended);
+    }
+    
+    inline void failed(std::chrono::nanoseconds wait)
+    {
+        lock_statistics::instance().record(serial, wait, std::chrono::nanoseconds(0), false, true);
+    }
+
+public:
+    inline instrumented_mutex() : mutex(), serial(lock_statistics::instance().enroll())
+    {}
+    
+    inline ~instrumented_mutex()
+    {
+        lock_statistics::instance().forget(serial);
+    }
+    
+    /**
+     * Report id and label with the statistics of this lock,
+     * called by Container on construction
+     */
+    inline void bind(const referable_tag &id, const referable_tag &label)
+    {
+        lock_statistics::instance().describe(serial, id, label);
+    }
+    
+    inline void lock()
+    {
+        if (mutex.try_lock())
+        {
+            acquired(clock::now(), std::chrono::nanoseconds(0), false);
+            return;
+        }
+        const clock::time_point wait_start = clock::now();
+        mutex.lock();
+        const clock::time_point acquired_at = clock::now();
+        acquired(acquired_at, acquired_at - wait_start, true);
+    }
+    
+    inline bool try_lock()
+    {
+        if (!mutex.try_lock()) return false;
+        acquired(clock::now(), std::chrono::nanoseconds(0), false);
+        return true;
+    }
+    
+    template<class Rep, class Period>
+    inline bool try_lock_for(const std::chrono::duration<Rep, Period> &timeout_duration)
+    {
+        return try_lock_until(clock::now() + timeout_duration);
+    }
+    
+    template<class Clock, class Duration>
+    inline bool try_lock_until(const std::chrono::time_point<Clock, Duration> &timeout_time)
+    {
+        if (try_lock()) return true;
+        const clock::time_point wait_start = clock::now();
+        const bool locked = mutex.try_lock_until(timeout_time);
+        const clock::time_point wait_end = clock::now();
+        if (locked) acquired(wait_end, wait_end - wait_start, true);
+        else failed(wait_end - wait_start);
+        return locked;
+    }
+    
+    inline void unlock()
+    {
+        const std::chrono::nanoseconds hold = clock::now() - exclusive_acquired_at;
+        const std::chrono::nanoseconds wait = exclusive_wait;
+        const bool contended = exclusive_contended;
+        mutex.unlock();
+        lock_statistics::instance().record(serial, wait, hold, true, contended);
+    }
+    
+    template<typename shared_mutex_t = mutex_t, typename = std::enable_if_t<lock_traits<shared_mutex_t>::is_shared>>
+    inline void lock_shared()
+    {
+        if (mutex.try_lock_shared())
+        {
+            acquired_shared(clock::now(), std::chrono::nanoseconds(0), false);
+            return;
+        }
+        const clock::time_point wait_start = clock::now();
+        mutex.lock_shared();
+        const clock::time_point acquired_at = clock::now();
+        acquired_shared(acquired_at, acquired_at - wait_start, true);
+    }
+    
+    template<typename shared_mutex_t = mutex_t, typename = std::enable_if_t<lock_traits<shared_mutex_t>::is_shared>>
+    inline bool try_lock_shared()
+    {
+        if (!mutex.try_lock_shared()) return false;
+        acquired_shared(clock::now(), std::chrono::nanoseconds(0), false);
+        return true;
+    }
+    
+    template<class Rep, class Period>
+    inline bool try_lock_shared_for(const std::chrono::duration<Rep, Period> &timeout_duration)
+    {
+        return try_lock_shared_until(clock::now() + timeout_duration);
+    }
+    
+    template<class Clock, class Duration>
+    inline bool try_lock_shared_until(const std::chrono::time_point<Clock, Duration> &timeout_time)
+    {
+        if (try_lock_shared()) return true;
+        const clock::time_point wait_start = clock::now();
+        const bool locked = mutex.try_lock_shared_until(timeout_time);
+        const clock::time_point wait_end = clock::now();
+        if (locked) acquired_shared(wait_end, wait_end - wait_start, true);
+        else failed(wait_end - wait_start);
+        return locked;
+    }
+    
+    template<typename shared_mutex_t = mutex_t, typename = std::enable_if_t<lock_traits<shared_mutex_t>::is_shared>>
+    inline void unlock_shared()
+    {
+        const clock::time_point released_at = clock::now();
+        mutex.unlock_shared();
+        shared_hold_stack &stack = local_shared_holds();
+        /// views are usually released in reverse order, so search from the top
+        for (std::size_t index = stack.size; index-- > 0;)
+        {
+            if (stack.holds[index].mutex != this) continue;
+            const shared_hold released = stack.holds[index];
+            std::move(stack.holds + index + 1, stack.holds + stack.size, stack.holds + index);
+            --stack.size;
+            lock_statistics::instance().record(
+                    serial, released.wait, released_at - released.acquired_at, true, released.contended
+            );
+            return;
+        }
+        lock_statistics::instance().record(
+                serial, std::chrono::nanoseconds(0), std::chrono::nanoseconds(0), true, false
+        );
+    }
+};
+
+/**
+ * Whether lock_policy reports the tags of its Container
+ * @tparam lock_policy
+ */
+template<typename lock_policy, typename = void>
+struct is_instrumented_lock : std::false_type
+{
+};
+
+template<typename lock_policy>
+struct is_instrumented_lock<
+        lock_policy,
+        std::void_t<decltype(std::declval<lock_policy &>().bind(referable_tag(), referable_tag()))>
+> : std::true_type
+{
+};
+
+#endif //HEADER_GUARD__41c7e8a2_6b5d_4f93_a0e1_8d2f7c35b964__instrumented_mutex_hpp
@@ -0,0 +1,561 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__7448d3b0_810a_4bcb_aeb8_44a171cdb60c__lock_policy_hpp
+#define HEADER_GUARD__7448d3b0_810a_4bcb_aeb8_44a171cdb60c__lock_policy_hpp
+
+#include "variable_util_includes.h"
+
+/**
+ * Hint the processor that the current thread is spinning
+ */
+inline void cpu_relax() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+/**
+ * Seqlock read shared by the optimistic readers.
+ * Copies source between two loads of the same even version,
+ * retrying while a writer keeps version odd or moves it during the copy.
+ * @param version sequence number of source, odd while a writer modifies it
+ * @param source bytes guarded by version
+ * @param destination receives a consistent copy of source
+ * @param size bytes to copy
+ */
+inline void seqlock_copy(
+        const std::atomic<std::uint64_t> &version, const void *source, void *destination, std::size_t size
+) noexcept
+{
+    for (unsigned retry_count = 0;; ++retry_count)
+    {
+        const std::uint64_t observed = version.load(std::memory_order_acquire);
+        if (!(observed & 1u))
+        {
+            /// the copy may race with a writer, it is discarded when the version moved
+            std::memcpy(destination, source, size);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (version.load(std::memory_order_relaxed) == observed) return;
+        }
+        if (retry_count < 64) cpu_relax();
+        else std::this_thread::yield();
+    }
+}
+
+/**
+ * Block the current thread while *address == expected.
+ * Spurious wake-ups are allowed, callers must recheck their condition.
+ * @param address 32-bit word to wait on
+ * @param expected value observed by the caller
+ * @param timeout_duration maximum time to block, negative or std::nullopt means forever
+ */
+inline void futex_wait(
+        std::atomic<std::uint32_t> &address, std::uint32_t expected,
+        std::optional<std::chrono::nanoseconds> timeout_duration = std::nullopt
+) noexcept
+{
+#if defined(__linux__)
+    static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t));
+    timespec timeout{};
+    if (timeout_duration)
+    {
+        if (timeout_duration->count() <= 0) return;
+        timeout.tv_sec = static_cast<time_t>(timeout_duration->count() / 1000000000);
+        timeout.tv_nsec = static_cast<long>(timeout_duration->count() % 1000000000);
+    }
+    syscall(
+            SYS_futex, reinterpret_cast<std::uint32_t *>(&address),
+            FUTEX_WAIT_PRIVATE, expected, timeout_duration ? &timeout : nullptr,
+            nullptr, 0
+    );
+#else
+    if (address.load(std::memory_order_relaxed) == expected) std::this_thread::yield();
+#endif
+}
+
+/**
+ * Wake every thread blocked in futex_wait on address
+ * @param address 32-bit word waited on
+ */
+inline void futex_wake_all(std::atomic<std::uint32_t> &address) noexcept
+{
+#if defined(__linux__)
+    syscall(
+            SYS_futex, reinterpret_cast<std::uint32_t *>(&address),
+            FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0
+    );
+#else
+    (void) address;
+#endif
+}
+
+/**
+ * Waiting strategy of basic_shared_mutex which only spins and yields
+ */
+class spin_waiting final
+{
+public:
+    inline void wait(
+            std::atomic<std::uint32_t> &state, std::uint32_t observed,
+            std::optional<std::chrono::nanoseconds>
+    ) noexcept
+    {
+        for (unsigned spin_count = 0; state.load(std::memory_order_relaxed) == observed; ++spin_count)
+        {
+            if (spin_count < 64) cpu_relax();
+            else
+            {
+                std::this_thread::yield();
+                return;
+            }
+        }
+    }
+    
+    inline void wake(std::atomic<std::uint32_t> &) noexcept
+    {}
+};
+
+/**
+ * Waiting strategy of basic_shared_mutex which spins briefly
+ * and then sleeps on the state word with futex
+ */
+class futex_waiting final
+{
+private:
+    std::atomic<std::uint32_t> waiter_count{0};
+
+public:
+    inline void wait(
+            std::atomic<std::uint32_t> &state, std::uint32_t observed,
+            std::optional<std::chrono::nanoseconds> timeout_duration
+    ) noexcept
+    {
+        for (unsigned spin_count = 0; spin_count < 64; ++spin_count)
+        {
+            if (state.load(std::memory_order_relaxed) != observed) return;
+            cpu_relax();
+        }
+        /// seq_cst on both sides guarantees that either wake() observes the waiter
+        /// or the waiter observes the new state inside the futex syscall
+        waiter_count.fetch_add(1, std::memory_order_seq_cst);
+        futex_wait(state, observed, timeout_duration);
+        waiter_count.fetch_sub(1, std::memory_order_relaxed);
+    }
+    
+    inline void wake(std::atomic<std::uint32_t> &state) noexcept
+    {
+        if (waiter_count.load(std::memory_order_seq_cst) != 0) futex_wake_all(state);
+    }
+};
+
+/**
+ * Reader-writer lock on a single 32-bit state word.
+ * A writer which has to wait sets writer_pending so that new readers queue behind it.
+ * At most one upgrader coexists with the readers,
+ * it excludes writers and can be promoted to a writer without releasing the lock.
+ * Satisfies SharedTimedMutex.
+ * @tparam waiting_t waiting strategy, spin_waiting or futex_waiting
+ */
+template<typename waiting_t>
+class basic_shared_mutex final
+{
+private:
+    static constexpr std::uint32_t writer = 1, writer_pending = 2, upgrader = 4, reader = 8;
+    
+    std::atomic<std::uint32_t> state{0};
+    waiting_t waiting;
+    
+    inline explicit basic_shared_mutex(const basic_shared_mutex &) = delete;
+    
+    inline basic_shared_mutex &operator=(const basic_shared_mutex &) = delete;
+    
+    template<class Clock, class Duration>
+    static inline std::optional<std::chrono::nanoseconds> remaining(
+            const std::optional<std::chrono::time_point<Clock, Duration>> &deadline
+    ) noexcept
+    {
+        if (!deadline) return std::nullopt;
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(*deadline - Clock::now());
+    }
+    
+    template<class Clock, class Duration>
+    inline bool acquire(const std::optional<std::chrono::time_point<Clock, Duration>> &deadline) noexcept
+    {
+        while (true)
+        {
+            std::uint32_t observed = state.load(std::memory_order_relaxed);
+            if ((observed & ~writer_pending) == 0)
+            {
+                if (state.compare_exchange_weak(
+                        observed, writer, std::memory_order_acquire, std::memory_order_relaxed
+                ))
+                    return true;
+                continue;
+            }
+            if (deadline && Clock::now() >= *deadline)
+            {
+                /// other waiting writers will set it again
+                state.fetch_and(~writer_pending, std::memory_order_relaxed);
+                waiting.wake(state);
+                return false;
+            }
+            if (!(observed & writer_pending))
+            {
+                observed = state.fetch_or(writer_pending, std::memory_order_relaxed) | writer_pending;
+            }
+            waiting.wait(state, observed, remaining(deadline));
+        }
+    }
+    
+    template<class Clock, class Duration>
+    inline bool acquire_shared(const std::optional<std::chrono::time_point<Clock, Duration>> &deadline) noexcept
+    {
+        while (true)
+        {
+            std::uint32_t observed = state.load(std::memory_order_relaxed);
+            if (!(observed & (writer | writer_pending)))
+            {
+                if (state.compare_exchange_weak(
+                        observed, observed + reader, std::memory_order_acquire, std::memory_order_relaxed
+                ))
+                    return true;
+                continue;
+            }
+            if (deadline && Clock::now() >= *deadline) return false;
+            waiting.wait(state, observed, remaining(deadline));
+        }
+    }
+
+public:
+    inline basic_shared_mutex() noexcept = default;
+    
+    inline void lock() noexcept
+    {
+        if (!try_lock()) acquire<std::chrono::steady_clock, std::chrono::steady_clock::duration>(std::nullopt);
+    }
+    
+    inline bool try_lock() noexcept
+    {
+        std::uint32_t observed = state.load(std::memory_order_relaxed);
+        return (observed & ~writer_pending) == 0 && state.compare_exchange_strong(
+                observed, writer, std::memory_order_acquire, std::memory_order_relaxed
+        );
+    }
+    
+    template<class Rep, class Period>
+    inline bool try_lock_for(const std::chrono::duration<Rep, Period> &timeout_duration) noexcept
+    {
+        return try_lock_until(std::chrono::steady_clock::now() + timeout_duration);
+    }
+    
+    template<class Clock, class Duration>
+    inline bool try_lock_until(const std::chrono::time_point<Clock, Duration> &timeout_time) noexcept
+    {
+        return try_lock() || acquire(std::make_optional(timeout_time));
+    }
+    
+    inline void unlock() noexcept
+    {
+        state.fetch_sub(writer, std::memory_order_release);
+        waiting.wake(state);
+    }
+    
+    inline void lock_shared() noexcept
+    {
+        if (!try_lock_shared())
+            acquire_shared<std::chrono::steady_clock, std::chrono::steady_clock::duration>(std::nullopt);
+    }
+    
+    inline bool try_lock_shared() noexcept
+    {
+        std::uint32_t observed = state.load(std::memory_order_relaxed);
+        return !(observed & (writer | writer_pending)) && state.compare_exchange_strong(
+                observed, observed + reader, std::memory_order_acquire, std::memory_order_relaxed
+        );
+    }
+    
+    template<class Rep, class Period>
+    inline bool try_lock_shared_for(const std::chrono::duration<Rep, Period> &timeout_duration) noexcept
+    {
+        return try_lock_shared_until(std::chrono::steady_clock::now() + timeout_duration);
+    }
+    
+    template<class Clock, class Duration>
+    inline bool try_lock_shared_until(const std::chrono::time_point<Clock, Duration> &timeout_time) noexcept
+    {
+        return try_lock_shared() || acquire_shared(std::make_optional(timeout_time));
+    }
+    
+    inline void unlock_shared() noexcept
+    {
+        /// only the last reader can unblock a writer or an upgrader waiting for promotion
+        if ((state.fetch_sub(reader, std::memory_order_release) & ~(writer_pending | upgrader)) == reader)
+            waiting.wake(state);
+    }
+    
+    ///Lock shared as the only upgrader, new readers are still admitted
+    inline void lock_upgrade() noexcept
+    {
+        while (!try_lock_upgrade())
+        {
+            const std::uint32_t observed = state.load(std::memory_order_relaxed);
+            if (observed & (writer | writer_pending | upgrader)) waiting.wait(state, observed, std::nullopt);
+        }
+    }
+    
+    inline bool try_lock_upgrade() noexcept
+    {
+        std::uint32_t observed = state.load(std::memory_order_relaxed);
+        return !(observed & (writer | writer_pending | upgrader)) && state.compare_exchange_strong(
+                observed, observed | upgrader, std::memory_order_acquire, std::memory_order_relaxed
+        );
+    }
+    
+    inline void unlock_upgrade() noexcept
+    {
+        state.fetch_and(~upgrader, std::memory_order_release);
+        waiting.wake(state);
+    }
+    
+    /**
+     * Promote the upgrade lock to the exclusive lock without releasing it.
+     * New readers queue behind the promotion, which waits until the current readers have left.
+     */
+    inline void unlock_upgrade_and_lock() noexcept
+    {
+        while (true)
+        {
+            std::uint32_t observed = state.load(std::memory_order_relaxed);
+            if ((observed & ~writer_pending) == upgrader)
+            {
+                if (state.compare_exchange_weak(
+                        observed, writer, std::memory_order_acquire, std::memory_order_relaxed
+                ))
+                    return;
+                continue;
+            }
+            if (!(observed & writer_pending))
+            {
+                observed = state.fetch_or(writer_pending, std::memory_order_relaxed) | writer_pending;
+            }
+            waiting.wait(state, observed, std::nullopt);
+        }
+    }
+    
+    ///Promote the upgrade lock to the exclusive lock only if no reader is left
+    inline bool try_unlock_upgrade_and_lock() noexcept
+    {
+        std::uint32_t observed = state.load(std::memory_order_relaxed);
+        return (observed & ~writer_pending) == upgrader && state.compare_exchange_strong(
+                observed, writer, std::memory_order_acquire, std::memory_order_relaxed
+        );
+    }
+    
+    ///Turn the upgrade lock into a plain shared lock, letting another upgrader in
+    inline void unlock_upgrade_and_lock_shared() noexcept
+    {
+        state.fetch_add(reader - upgrader, std::memory_order_release);
+        waiting.wake(state);
+    }
+    
+    ///Turn the exclusive lock into the upgrade lock, readers are admitted again
+    inline void unlock_and_lock_upgrade() noexcept
+    {
+        state.fetch_add(upgrader - writer, std::memory_order_release);
+        waiting.wake(state);
+    }
+    
+    ///Turn the exclusive lock into a shared lock, readers are admitted again
+    inline void unlock_and_lock_shared() noexcept
+    {
+        state.fetch_add(reader - writer, std::memory_order_release);
+        waiting.wake(state);
+    }
+};
+
+///Spinning reader-writer lock for short critical sections
+using spin_shared_mutex = basic_shared_mutex<spin_waiting>;
+
+///Reader-writer lock which sleeps on futex when contended
+using futex_shared_mutex = basic_shared_mutex<futex_waiting>;
+
+/**
+ * Lock which does nothing, for content only accessed by a single thread.
+ * Satisfies SharedTimedMutex.
+ * Only the lock is free: the Container of referable_unique keeps the members
+ * used by the optional features of weak_ptr, see referable_unique::Container.
+ */
+class null_mutex final
+{
+public:
+    inline void lock() noexcept
+    {}
+    
+    inline bool try_lock() noexcept
+    {
+        return true;
+    }
+    
+    template<class Rep, class Period>
+    inline bool try_lock_for(const std::chrono::duration<Rep, Period> &) noexcept
+    {
+        return true;
+    }
+    
+    template<class Clock, class Duration>
+    inline bool try_lock_until(const std::chrono::time_point<Clock, Duration> &) noexcept
+    {
+        return true;
+    }
+    
+    inline void unlock() noexcept
+    {}
+    
+    inline void lock_shared() noexcept
+    {}
+    
+    inline bool try_lock_shared() noexcept
+    {
+        return true;
+    }
+    
+    template<class Rep, class Period>
+    inline bool try_lock_shared_for(const std::chrono::duration<Rep, Period> &) noexcept
+    {
+        return true;
+    }
+    
+    template<class Clock, class Duration>
+    inline bool try_lock_shared_until(const std::chrono::time_point<Clock, Duration> &) noexcept
+    {
+        return true;
+    }
+    
+    inline void unlock_shared() noexcept
+    {}
+};
+
+/**
+ * Base of lock policies which replace content_guard
+ * with another concurrency scheme.
+ * Each of them selects its own specialization of referable_unique.
+ */
+struct guard_mode
+{
+};
+
+/**
+ * Ownership of the upgrade lock of a lock policy supporting lock_upgrade,
+ * in the manner of std::shared_lock
+ * @tparam mutex_t
+ */
+template<typename mutex_t>
+class upgrade_lock final
+{
+private:
+    mutex_t *mutex;
+    bool owns;
+    
+    inline explicit upgrade_lock(const upgrade_lock &) = delete;
+    
+    inline upgrade_lock &operator=(const upgrade_lock &) = delete;
+    
+    inline upgrade_lock &operator=(upgrade_lock &&) = delete;
+
+public:
+    inline explicit upgrade_lock(mutex_t &locked_mutex) : mutex(&locked_mutex), owns(true)
+    {
+        mutex->lock_upgrade();
+    }
+    
+    inline upgrade_lock(mutex_t &locked_mutex, std::try_to_lock_t) :
+            mutex(&locked_mutex), owns(locked_mutex.try_lock_upgrade())
+    {}
+    
+    inline upgrade_lock(mutex_t &locked_mutex, std::adopt_lock_t) noexcept : mutex(&locked_mutex), owns(true)
+    {}
+    
+    inline upgrade_lock(upgrade_lock &&original) noexcept : mutex(original.mutex), owns(original.owns)
+    {
+        original.mutex = nullptr;
+        original.owns = false;
+    }
+    
+    inline ~upgrade_lock()
+    {
+        if (owns) mutex->unlock_upgrade();
+    }
+    
+    inline bool owns_lock() const noexcept
+    {
+        return owns;
+    }
+    
+    inline explicit operator bool() const noexcept
+    {
+        return owns;
+    }
+    
+    /**
+     * Give up ownership without unlocking
+     * @return the mutex, locked for upgrade if this lock owned it
+     */
+    inline mutex_t *release() noexcept
+    {
+        mutex_t *released = mutex;
+        mutex = nullptr;
+        owns = false;
+        return released;
+    }
+};
+
+/**
+ * Guard types used by view and const_view for a lock policy.
+ * Exclusive-only locks such as std::mutex guard const_view exclusively too.
+ * @tparam lock_policy type of Container::content_guard
+ */
+template<typename lock_policy, typename = void>
+struct lock_traits
+{
+    using unique_lock_type = std::unique_lock<lock_policy>;
+    using shared_lock_type = std::unique_lock<lock_policy>;
+    static constexpr bool is_shared = false;
+};
+
+/**
+ * Whether lock_policy supports the upgrade lock,
+ * which enables weak_ptr::get_upgradable_view and view::downgrade
+ * @tparam lock_policy type of Container::content_guard
+ */
+template<typename lock_policy, typename = void>
+struct is_upgradable_lock : std::false_type
+{
+};
+
+template<typename lock_policy>
+struct is_upgradable_lock<
+        lock_policy, std::void_t<
+                decltype(std::declval<lock_policy &>().lock_upgrade()),
+                decltype(std::declval<lock_policy &>().unlock_upgrade_and_lock()),
+                decltype(std::declval<lock_policy &>().unlock_and_lock_shared())
+        >
+> : std::true_type
+{
+};
+
+template<typename lock_policy>
+struct lock_traits<
+        lock_policy, std::void_t<decltype(std::declval<lock_policy &>().lock_shared())>
+>
+{
+    using unique_lock_type = std::unique_lock<lock_policy>;
+    using shared_lock_type = std::shared_lock<lock_policy>;
+    static constexpr bool is_shared = true;
+};
+
+#endif //HEADER_GUARD__7448d3b0_810a_4bcb_aeb8_44a171cdb60c__lock_policy_hpp
@@ -0,0 +1,427 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__e2a9c4d7_1f36_4b85_9c0e_7d4b62f18a53__lock_views_hpp
+#define HEADER_GUARD__e2a9c4d7_1f36_4b85_9c0e_7d4b62f18a53__lock_views_hpp
+
+#include "variable_util_includes.h"
+
+/**
+ * Locks the content guards of several referable_unique objects at once.
+ * Guards are always acquired in one canonical order, the address of their Containers,
+ * so that callers locking overlapping sets never deadlock.
+ * Only weak_ptr of the generic lock_policy specialization are accepted.
+ * @see lock_views
+ * @see lock_const_views
+ */
+class view_locker final
+{
+private:
+    using clock = std::chrono::steady_clock;
+    
+    enum class acquire_mode
+    {
+        blocking, attempt, until
+    };
+    
+    ///Type erased content guard of one target
+    struct pending_lock
+    {
+        const void *address;
+        void *guard;
+        
+        bool (*acquire)(void *guard, acquire_mode mode, clock::time_point deadline);
+        
+        void (*release)(void *guard);
+    };
+    
+    template<typename weak_ptr_t, bool shared>
+    using view_t = typename std::conditional_t<
+            shared,
+            decltype(std::declval<weak_ptr_t &>().get_const_view()),
+            decltype(std::declval<weak_ptr_t &>().get_view())
+    >::value_type;
+    
+    ///std::unique_lock or std::shared_lock held by a view or a const_view
+    template<typename view_type, bool shared>
+    struct lock_of
+    {
+        using type = decltype(std::declval<view_type &>().content_unique_lock);
+    };
+    
+    template<typename view_type>
+    struct lock_of<view_type, true>
+    {
+        using type = decltype(std::declval<view_type &>().content_shared_lock);
+    };
+    
+    template<typename view_type, bool shared>
+    using lock_t = typename lock_of<view_type, shared>::type;
+    
+    template<typename lock_type>
+    static constexpr bool is_shared_lock_v = std::is_same_v<
+            lock_type, std::shared_lock<typename lock_type::mutex_type>
+    >;
+    
+    template<typename lock_type, bool timed>
+    static bool acquire(void *guard, acquire_mode mode, clock::time_point deadline)
+    {
+        auto &content_guard = *static_cast<typename lock_type::mutex_type *>(guard);
+        if constexpr (is_shared_lock_v<lock_type>)
+        {
+            if (mode == acquire_mode::attempt) return content_guard.try_lock_shared();
+            if constexpr (timed)
+            {
+                if (mode == acquire_mode::until) return content_guard.try_lock_shared_until(deadline);
+            }
+            content_guard.lock_shared();
+        }
+        else
+        {
+            if (mode == acquire_mode::attempt) return content_guard.try_lock();
+            if constexpr (timed)
+            {
+                if (mode == acquire_mode::until) return content_guard.try_lock_until(deadline);
+            }
+            content_guard.lock();
+        }
+        return true;
+    }
+    
+    template<typename lock_type>
+    static void release(void *guard)
+    {
+        auto &content_guard = *static_cast<typename lock_type::mutex_type *>(guard);
+        if constexpr (is_shared_lock_v<lock_type>) content_guard.unlock_shared();
+        else content_guard.unlock();
+    }
+    
+    /**
+     * Strong references of one target.
+     * The constructors of std::shared_ptr throw std::bad_weak_ptr
+     * when the content or the Container has expired, before any guard is acquired.
+     * A retired Container is reported the same way, as weak_ptr treats it as expired.
+     */
+    template<typename weak_ptr_t>
+    struct target
+    {
+        decltype(std::declval<weak_ptr_t &>().content_weak_ptr.lock()) content_shared_ptr;
+        decltype(std::declval<weak_ptr_t &>().container_weak_ptr.lock()) container_shared_ptr;
+        
+        inline explicit target(const weak_ptr_t &weak_ptr) :
+                content_shared_ptr(weak_ptr.content_weak_ptr),
+                container_shared_ptr(weak_ptr.container_weak_ptr)
+        {
+            if (container_shared_ptr->retired.load(std::memory_order_acquire)) throw std::bad_weak_ptr();
+        }
+        
+        template<bool shared, bool timed>
+        inline pending_lock describe() const noexcept
+        {
+            using lock_type = lock_t<view_t<weak_ptr_t, shared>, shared>;
+            return pending_lock{
+                    container_shared_ptr.get(), &container_shared_ptr->content_guard,
+                    &view_locker::acquire<lock_type, timed>, &view_locker::release<lock_type>
+            };
+        }
+        
+        ///Called after describe<shared, timed>() has been acquired
+        template<bool shared>
+        inline view_t<weak_ptr_t, shared> adopt()
+        {
+            using lock_type = lock_t<view_t<weak_ptr_t, shared>, shared>;
+            auto &content_guard = container_shared_ptr->content_guard;
+            return view_t<weak_ptr_t, shared>(
+                    std::move(content_shared_ptr), std::move(container_shared_ptr),
+                    lock_type(content_guard, std::adopt_lock)
+            );
+        }
+    };
+    
+    /**
+     * Sort pending locks into the canonical order and reject duplicates,
+     * which would deadlock against themselves.
+     */
+    static inline void order(pending_lock *first, pending_lock *last)
+    {
+        std::sort(
+                first, last,
+                [](const pending_lock &left, const pending_lock &right)
+                {
+                    return std::less<const void *>()(left.address, right.address);
+                }
+        );
+        if (std::adjacent_find(
+                first, last,
+                [](const pending_lock &left, const pending_lock &right) { return left.address == right.address; }
+        ) != last)
+            throw std::invalid_argument("view_locker: the same referable_unique is locked twice");
+    }
+    
+    ///Release the locks in [first, last) except skipped
+    static inline void release_range(pending_lock *first, pending_lock *last, const pending_lock *skipped) noexcept
+    {
+        for (pending_lock *current = first; current != last; ++current)
+        {
+            if (current != skipped) current->release(current->guard);
+        }
+    }
+    
+    /**
+     * Acquire every lock of the ordered range [first, last).
+     * Without a deadline the locks are taken one after another in order, which cannot deadlock.
+     * With a deadline no lock is held while waiting:
+     * the lock which failed last time is awaited until the deadline,
+     * the others are only tried, and everything is released and retried on failure.
+     * @return false if the deadline has passed, no lock is held then
+     */
+    static inline bool acquire_all(pending_lock *first, pending_lock *last, std::optional<clock::time_point> deadline)
+    {
+        if (!deadline)
+        {
+            for (pending_lock *current = first; current != last; ++current)
+                current->acquire(current->guard, acquire_mode::blocking, clock::time_point());
+            return true;
+        }
+        if (first == last) return true;
+        for (pending_lock *awaited = first;;)
+        {
+            if (!awaited->acquire(awaited->guard, acquire_mode::until, *deadline)) return false;
+            pending_lock *current = first;
+            for (; current != last; ++current)
+            {
+                if (current != awaited && !current->acquire(current->guard, acquire_mode::attempt, *deadline))
+                    break;
+            }
+            if (current == last) return true;
+            release_range(first, current, awaited);
+            awaited->release(awaited->guard);
+            awaited = current;
+            std::this_thread::yield();
+        }
+    }
+    
+    template<bool shared, bool timed, typename ...weak_ptr_t>
+    static inline std::optional<std::tuple<view_t<weak_ptr_t, shared>...>> lock_targets(
+            std::optional<clock::time_point> deadline, const weak_ptr_t &...weak_ptrs
+    )
+    {
+        std::tuple<target<weak_ptr_t>...> targets{target<weak_ptr_t>(weak_ptrs)...};
+        std::array<pending_lock, sizeof...(weak_ptr_t)> pending_locks = std::apply(
+                [](const auto &...each)
+                {
+                    return std::array<pending_lock, sizeof...(weak_ptr_t)>{
+                            each.template describe<shared, timed>()...
+                    };
+                },
+                targets
+        );
+        order(pending_locks.data(), pending_locks.data() + pending_locks.size());
+        if (!acquire_all(pending_locks.data(), pending_locks.data() + pending_locks.size(), deadline))
+            return std::nullopt;
+        return std::apply(
+                [](auto &...each)
+                {
+                    return std::optional<std::tuple<view_t<weak_ptr_t, shared>...>>(
+                            std::in_place, each.template adopt<shared>()...
+                    );
+                },
+                targets
+        );
+    }
+    
+    template<bool shared, bool timed, typename iterator_t>
+    static inline auto lock_target_range(
+            std::optional<clock::time_point> deadline, iterator_t first, iterator_t last
+    )
+    {
+        using weak_ptr_t = std::decay_t<decltype(*first)>;
+        std::vector<target<weak_ptr_t>> targets;
+        for (; first != last; ++first) targets.emplace_back(*first);
+        std::vector<pending_lock> pending_locks;
+        pending_locks.reserve(targets.size());
+        for (auto &each: targets) pending_locks.push_back(each.template describe<shared, timed>());
+        order(pending_locks.data(), pending_locks.data() + pending_locks.size());
+        /// nothing may throw once the locks are acquired
+        std::vector<view_t<weak_ptr_t, shared>> views;
+        views.reserve(targets.size());
+        if (!acquire_all(pending_locks.data(), pending_locks.data() + pending_locks.size(), deadline))
+            return std::optional<std::vector<view_t<weak_ptr_t, shared>>>();
+        for (auto &each: targets) views.push_back(each.template adopt<shared>());
+        return std::optional<std::vector<view_t<weak_ptr_t, shared>>>(std::move(views));
+    }
+    
+    template<typename, typename = void>
+    struct is_weak_ptr : std::false_type
+    {
+    };
+    
+    template<typename weak_ptr_t>
+    struct is_weak_ptr<weak_ptr_t, std::void_t<decltype(std::declval<weak_ptr_t &>().get_view())>> :
+            std::true_type
+    {
+    };
+
+public:
+    template<typename ...weak_ptr_t>
+    static constexpr bool are_weak_ptrs_v = (is_weak_ptr<std::decay_t<weak_ptr_t>>::value && ...);
+    
+    template<typename ...weak_ptr_t>
+    static inline auto lock(const weak_ptr_t &...weak_ptrs)
+    {
+        return lock_targets<false, false>(std::nullopt, weak_ptrs...);
+    }
+    
+    template<typename ...weak_ptr_t>
+    static inline auto lock_until(clock::time_point deadline, const weak_ptr_t &...weak_ptrs)
+    {
+        return lock_targets<false, true>(deadline, weak_ptrs...);
+    }
+    
+    template<typename ...weak_ptr_t>
+    static inline auto lock_shared(const weak_ptr_t &...weak_ptrs)
+    {
+        return lock_targets<true, false>(std::nullopt, weak_ptrs...);
+    }
+    
+    template<typename ...weak_ptr_t>
+    static inline auto lock_shared_until(clock::time_point deadline, const weak_ptr_t &...weak_ptrs)
+    {
+        return lock_targets<true, true>(deadline, weak_ptrs...);
+    }
+    
+    template<typename iterator_t>
+    static inline auto lock_range(iterator_t first, iterator_t last)
+    {
+        return lock_target_range<false, false>(std::nullopt, first, last);
+    }
+    
+    template<typename iterator_t>
+    static inline auto lock_range_until(clock::time_point deadline, iterator_t first, iterator_t last)
+    {
+        return lock_target_range<false, true>(deadline, first, last);
+    }
+    
+    template<typename iterator_t>
+    static inline auto lock_shared_range(iterator_t first, iterator_t last)
+    {
+        return lock_target_range<true, false>(std::nullopt, first, last);
+    }
+    
+    template<typename iterator_t>
+    static inline auto lock_shared_range_until(clock::time_point deadline, iterator_t first, iterator_t last)
+    {
+        return lock_target_range<true, true>(deadline, first, last);
+    }
+};
+
+/**
+ * Lock the contents of several weak_ptr exclusively, without deadlock.
+ * Throws std::bad_weak_ptr before locking anything if any content has expired,
+ * and std::invalid_argument if two weak_ptr refer to the same content.
+ * @tparam weak_ptr_t referable_unique<T, lock_policy>::weak_ptr of any T and lock_policy
+ * @param weak_ptrs
+ * @return std::optional of the std::tuple of the views in the order of weak_ptrs,
+ * which is never empty and shares its type with the timed version
+ */
+template<typename ...weak_ptr_t, typename = std::enable_if_t<view_locker::are_weak_ptrs_v<weak_ptr_t...>>>
+inline auto lock_views(const weak_ptr_t &...weak_ptrs)
+{
+    return view_locker::lock(weak_ptrs...);
+}
+
+/**
+ * Timed version of lock_views, for lock policies satisfying SharedTimedMutex or TimedMutex.
+ * No lock is held while waiting for another one.
+ * @return std::nullopt if not every content has been locked within timeout_duration
+ */
+template<
+        class Rep, class Period, typename ...weak_ptr_t,
+        typename = std::enable_if_t<view_locker::are_weak_ptrs_v<weak_ptr_t...>>
+>
+inline auto lock_views(const std::chrono::duration<Rep, Period> &timeout_duration, const weak_ptr_t &...weak_ptrs)
+{
+    return view_locker::lock_until(
+            std::chrono::steady_clock::now() +
+            std::chrono::ceil<std::chrono::steady_clock::duration>(timeout_duration),
+            weak_ptrs...
+    );
+}
+
+/**
+ * Lock every weak_ptr in [first, last) exclusively, without deadlock.
+ * @see lock_views
+ * @tparam iterator_t input iterator of referable_unique<T, lock_policy>::weak_ptr of a single T
+ * @return std::optional of the std::vector of the views in the order of the range, never empty
+ */
+template<typename iterator_t, typename = std::enable_if_t<view_locker::are_weak_ptrs_v<decltype(*std::declval<iterator_t &>())>>>
+inline auto lock_views(iterator_t first, iterator_t last)
+{
+    return view_locker::lock_range(first, last);
+}
+
+///Timed version of lock_views for a range
+template<
+        class Rep, class Period, typename iterator_t,
+        typename = std::enable_if_t<view_locker::are_weak_ptrs_v<decltype(*std::declval<iterator_t &>())>>
+>
+inline auto lock_views(const std::chrono::duration<Rep, Period> &timeout_duration, iterator_t first, iterator_t last)
+{
+    return view_locker::lock_range_until(
+            std::chrono::steady_clock::now() +
+            std::chrono::ceil<std::chrono::steady_clock::duration>(timeout_duration),
+            first, last
+    );
+}
+
+/**
+ * Shared version of lock_views returning const_view
+ * @see lock_views
+ */
+template<typename ...weak_ptr_t, typename = std::enable_if_t<view_locker::are_weak_ptrs_v<weak_ptr_t...>>>
+inline auto lock_const_views(const weak_ptr_t &...weak_ptrs)
+{
+    return view_locker::lock_shared(weak_ptrs...);
+}
+
+///Timed shared version of lock_views returning const_view
+template<
+        class Rep, class Period, typename ...weak_ptr_t,
+        typename = std::enable_if_t<view_locker::are_weak_ptrs_v<weak_ptr_t...>>
+>
+inline auto lock_const_views(
+        const std::chrono::duration<Rep, Period> &timeout_duration, const weak_ptr_t &...weak_ptrs
+)
+{
+    return view_locker::lock_shared_until(
+            std::chrono::steady_clock::now() +
+            std::chrono::ceil<std::chrono::steady_clock::duration>(timeout_duration),
+            weak_ptrs...
+    );
+}
+
+///Shared version of lock_views for a range
+template<typename iterator_t, typename = std::enable_if_t<view_locker::are_weak_ptrs_v<decltype(*std::declval<iterator_t &>())>>>
+inline auto lock_const_views(iterator_t first, iterator_t last)
+{
+    return view_locker::lock_shared_range(first, last);
+}
+
+///Timed shared version of lock_views for a range
+template<
+        class Rep, class Period, typename iterator_t,
+        typename = std::enable_if_t<view_locker::are_weak_ptrs_v<decltype(*std::declval<iterator_t &>())>>
+>
+inline auto lock_const_views(
+        const std::chrono::duration<Rep, Period> &timeout_duration, iterator_t first, iterator_t last
+)
+{
+    return view_locker::lock_shared_range_until(
+            std::chrono::steady_clock::now() +
+            std::chrono::ceil<std::chrono::steady_clock::duration>(timeout_duration),
+            first, last
+    );
+}
+
+#endif //HEADER_GUARD__e2a9c4d7_1f36_4b85_9c0e_7d4b62f18a53__lock_views_hpp
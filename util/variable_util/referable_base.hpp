@@ -0,0 +1,66 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__5b0e7f3a_c2d4_4a18_b6e9_83f1d0a4c7b2__referable_base_hpp
+#define HEADER_GUARD__5b0e7f3a_c2d4_4a18_b6e9_83f1d0a4c7b2__referable_base_hpp
+
+#include "variable_util_includes.h"
+
+/**
+ * Base class of content types which embed their own content_guard and tags.
+ * referable_unique<T> of a T publicly derived from referable_base selects the intrusive specialization,
+ * which allocates nothing but the content with its reference counts in front and keeps one pointer in every handle.
+ * The state of referable_base belongs to referable_unique,
+ * copying or assigning a derived content never copies it.
+ * @tparam lock_policy type of content_guard, VARIABLE_UTIL_DEFAULT_LOCK_POLICY by default.
+ * The lock_policy argument of referable_unique is ignored for such content types.
+ */
+template<typename lock_policy = VARIABLE_UTIL_DEFAULT_LOCK_POLICY>
+class referable_base
+{
+private:
+    template<
+            typename, typename, typename, typename, typename, typename, typename, typename, typename,
+            typename, typename, typename, typename, typename, typename, typename, typename
+    > friend
+    class referable_unique;
+    
+    referable_tag content_id, content_label;
+    lock_policy content_guard;
+
+protected:
+    inline referable_base() noexcept :
+            content_id(), content_label(),
+            content_guard()
+    {}
+    
+    ///Copies start with their own content_guard and empty tags
+    inline referable_base(const referable_base &) noexcept : referable_base()
+    {}
+    
+    ///Keeps the content_guard and tags of this object
+    inline referable_base &operator=(const referable_base &) noexcept
+    {
+        return *this;
+    }
+    
+    inline ~referable_base() = default;
+
+public:
+    using lock_type = lock_policy;
+    
+    ///@return id of the content
+    inline const referable_tag &id() const noexcept
+    {
+        return content_id;
+    }
+    
+    ///@return label of the content
+    inline const referable_tag &label() const noexcept
+    {
+        return content_label;
+    }
+};
+
+#endif //HEADER_GUARD__5b0e7f3a_c2d4_4a18_b6e9_83f1d0a4c7b2__referable_base_hpp
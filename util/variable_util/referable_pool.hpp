@@ -0,0 +1,457 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__71f3a0d8_5e2b_4c96_a4d7_c08e92b1f56a__referable_pool_hpp
+#define HEADER_GUARD__71f3a0d8_5e2b_4c96_a4d7_c08e92b1f56a__referable_pool_hpp
+
+#include "variable_util_includes.h"
+
+/**
+ * Objects stored contiguously in chunks of slots and referred to by 8-byte handles.
+ * A handle is the index of a slot and the generation of the slot when the object was inserted.
+ * The generation changes when the object is erased, so that stale handles are detected
+ * without any reference count: resolving a handle locks the content_guard of its slot
+ * and compares the generations, and erase waits for that lock before destroying the object.
+ * A slot is retired instead of reused once its 32-bit generation is exhausted, after 2^31 objects,
+ * so that a stale handle never matches a later object of the same slot.
+ * Handles do not keep the pool alive, the pool must outlive every view.
+ * @tparam T non-const content type
+ * @tparam lock_policy type of the content_guard of every slot
+ */
+template<typename T, typename lock_policy = VARIABLE_UTIL_DEFAULT_LOCK_POLICY>
+class referable_pool final
+{
+private:
+    static_assert(std::is_const_v<T> == 0, "referable_pool requires a non-const content type");
+    
+    using unique_lock_type = typename lock_traits<lock_policy>::unique_lock_type;
+    using shared_lock_type = typename lock_traits<lock_policy>::shared_lock_type;
+    
+    struct slot
+    {
+        /**
+         * Odd while the slot holds an object, even while it is free.
+         * Written under content_guard, read without it by insertions.
+         * Wraps to 0 when the object of the last odd generation is erased, which retires the slot.
+         */
+        std::atomic<std::uint32_t> generation{0};
+        lock_policy content_guard;
+        alignas(T) unsigned char storage[sizeof(T)];
+        
+        inline T *content() noexcept
+        {
+            return std::launder(reinterpret_cast<T *>(storage));
+        }
+    };
+    
+    static constexpr std::size_t chunk_size = 1024;
+    
+    const std::size_t max_chunk_count;
+    ///Chunks are published with release and never move or shrink until the pool is destroyed
+    std::unique_ptr<std::atomic<slot *>[]> chunks;
+    
+    std::mutex allocation_guard;
+    std::vector<std::uint32_t> free_indices;
+    std::uint32_t used_index_count;
+    std::size_t live_count;
+    
+    inline explicit referable_pool(const referable_pool &) = delete;
+    
+    inline referable_pool &operator=(const referable_pool &) = delete;
+    
+    ///@return the slot at index, or nullptr beyond the allocated chunks
+    inline slot *locate(std::uint32_t index) const noexcept
+    {
+        const std::size_t chunk_index = index / chunk_size;
+        if (chunk_index >= max_chunk_count) return nullptr;
+        slot *const chunk = chunks[chunk_index].load(std::memory_order_acquire);
+        return chunk ? chunk + index % chunk_size : nullptr;
+    }
+    
+    ///Take a free index or a new one, called with allocation_guard held
+    inline std::uint32_t allocate_index()
+    {
+        if (!free_indices.empty())
+        {
+            const std::uint32_t index = free_indices.back();
+            free_indices.pop_back();
+            return index;
+        }
+        const std::uint32_t index = used_index_count;
+        const std::size_t chunk_index = index / chunk_size;
+        if (chunk_index >= max_chunk_count) throw std::length_error("referable_pool is full");
+        if (!chunks[chunk_index].load(std::memory_order_relaxed))
+            chunks[chunk_index].store(new slot[chunk_size], std::memory_order_release);
+        ++used_index_count;
+        return index;
+    }
+
+public:
+    class handle final
+    {
+    private:
+        friend class referable_pool;
+        
+        std::uint32_t index, generation;
+        
+        inline handle(std::uint32_t slot_index, std::uint32_t slot_generation) noexcept :
+                index(slot_index), generation(slot_generation)
+        {}
+    
+    public:
+        ///Refers to nothing, every lookup reports it as expired
+        inline handle() noexcept : index(0), generation(0)
+        {}
+        
+        inline bool operator==(const handle &another) const noexcept
+        {
+            return index == another.index && generation == another.generation;
+        }
+        
+        inline bool operator!=(const handle &another) const noexcept
+        {
+            return !(*this == another);
+        }
+    };
+    
+    class const_view final
+    {
+    private:
+        friend class referable_pool;
+        
+        T *content;
+        shared_lock_type content_shared_lock;
+        
+        ///Disable default constructor
+        inline explicit const_view() = delete;
+        
+        ///Disable copy constructor
+        inline explicit const_view(const const_view &) = delete;
+        
+        inline const const_view &operator=(const const_view &) = delete;
+        
+        inline const const_view &operator=(const_view &&) = delete;
+        
+        ///Constructor used by referable_pool
+        inline explicit const_view(T *locked_content, shared_lock_type &&content_lock) noexcept :
+                content(locked_content), content_shared_lock(std::move(content_lock))
+        {}
+    
+    public:
+        /// Move constructor
+        inline explicit const_view(const_view &&original) :
+                content(original.content), content_shared_lock(std::move(original.content_shared_lock))
+        {}
+        
+        ///is this view valid
+        inline operator bool() const
+        {
+            return (bool) content_shared_lock;
+        }
+        
+        inline const T &operator*()
+        {
+            return *content;
+        }
+        
+        inline const T *operator->()
+        {
+            return content;
+        }
+    };
+    
+    class view final
+    {
+    private:
+        friend class referable_pool;
+        
+        T *content;
+        unique_lock_type content_unique_lock;
+        
+        ///Disable default constructor
+        inline explicit view() = delete;
+        
+        ///Disable copy constructor
+        inline explicit view(const view &) = delete;
+        
+        inline const view &operator=(const view &) = delete;
+        
+        inline const view &operator=(view &&) = delete;
+        
+        ///Constructor used by referable_pool
+        inline explicit view(T *locked_content, unique_lock_type &&content_lock) noexcept :
+                content(locked_content), content_unique_lock(std::move(content_lock))
+        {}
+    
+    public:
+        /// Move constructor
+        inline explicit view(view &&original) :
+                content(original.content), content_unique_lock(std::move(original.content_unique_lock))
+        {}
+        
+        ///is this view valid
+        inline operator bool() const
+        {
+            return (bool) content_unique_lock;
+        }
+        
+        inline T &operator*()
+        {
+            return *content;
+        }
+        
+        inline T *operator->()
+        {
+            return content;
+        }
+        
+        inline T &operator=(const T &t)
+        {
+            *content = t;
+            return *content;
+        }
+    };
+    
+    /**
+     * @param max_size maximum number of objects alive at once, rounded up to whole chunks.
+     * Only the table of chunks is allocated up front, one pointer per chunk_size objects.
+     */
+    inline explicit referable_pool(std::size_t max_size = std::size_t(1) << 22) :
+            max_chunk_count(
+                    std::min<std::size_t>(
+                            (max_size + chunk_size - 1) / chunk_size,
+                            (std::size_t(std::numeric_limits<std::uint32_t>::max()) + 1) / chunk_size
+                    )
+            ),
+            chunks(new std::atomic<slot *>[max_chunk_count]),
+            allocation_guard(), free_indices(), used_index_count(0), live_count(0)
+    {
+        for (std::size_t chunk_index = 0; chunk_index < max_chunk_count; ++chunk_index)
+            chunks[chunk_index].store(nullptr, std::memory_order_relaxed);
+    }
+    
+    ///Destroys the objects which are still alive
+    inline ~referable_pool()
+    {
+        for (std::size_t chunk_index = 0; chunk_index < max_chunk_count; ++chunk_index)
+        {
+            slot *const chunk = chunks[chunk_index].load(std::memory_order_relaxed);
+            if (!chunk) break;
+            for (std::size_t offset = 0; offset < chunk_size; ++offset)
+            {
+                if (chunk[offset].generation.load(std::memory_order_relaxed) & 1u)
+                    chunk[offset].content()->~T();
+            }
+            delete[] chunk;
+        }
+    }
+    
+    /**
+     * Construct an object in a free slot
+     * @tparam args_t types of arguments forwarded to the constructor of T
+     * @param args arguments forwarded to the constructor of T
+     * @return handle of the new object
+     * @throw std::length_error when max_size objects are alive, counting retired slots as alive
+     */
+    template<typename ...args_t>
+    inline handle emplace(args_t &&...args)
+    {
+        std::uint32_t index;
+        {
+            std::lock_guard<std::mutex> allocation_lock(allocation_guard);
+            index = allocate_index();
+        }
+        slot *const target = locate(index);
+        try
+        {
+            ::new(static_cast<void *>(target->storage)) T(std::forward<args_t>(args)...);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> allocation_lock(allocation_guard);
+            free_indices.push_back(index);
+            throw;
+        }
+        const std::uint32_t generation = target->generation.load(std::memory_order_relaxed) + 1;
+        /// publishes the constructed object to lookups which compare the generation
+        target->generation.store(generation, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> allocation_lock(allocation_guard);
+            ++live_count;
+        }
+        return handle(index, generation);
+    }
+    
+    /**
+     * Destroy the object of content_handle, waiting for its views
+     * @param content_handle
+     * @return false if the object has already expired
+     */
+    inline bool erase(const handle &content_handle)
+    {
+        slot *const target = locate(content_handle.index);
+        if (!target) return false;
+        {
+            unique_lock_type content_lock(target->content_guard);
+            if (target->generation.load(std::memory_order_acquire) != content_handle.generation ||
+                !(content_handle.generation & 1u))
+                return false;
+            target->generation.store(content_handle.generation + 1, std::memory_order_release);
+            target->content()->~T();
+        }
+        std::lock_guard<std::mutex> allocation_lock(allocation_guard);
+        /// a reused slot would start again from generation 1, which older handles may still hold
+        if (content_handle.generation != std::numeric_limits<std::uint32_t>::max())
+            free_indices.push_back(content_handle.index);
+        --live_count;
+        return true;
+    }
+    
+    ///@return whether the object of content_handle has been erased, without locking it
+    inline bool expired(const handle &content_handle) const noexcept
+    {
+        const slot *const target = locate(content_handle.index);
+        return !target || !(content_handle.generation & 1u) ||
+               target->generation.load(std::memory_order_acquire) != content_handle.generation;
+    }
+    
+    ///@return number of objects alive
+    inline std::size_t size()
+    {
+        std::lock_guard<std::mutex> allocation_lock(allocation_guard);
+        return live_count;
+    }
+    
+    /**
+     * @return std::optional<const_view>
+     * @throw std::bad_weak_ptr when the object has expired
+     */
+    inline std::optional<const_view> get_const_view(const handle &content_handle)
+    {
+        access_result<const_view> result(try_get_const_view(content_handle));
+        if (!result) throw std::bad_weak_ptr();
+        return std::move(result.to_optional());
+    }
+    
+    /**
+     * @return std::optional<view>
+     * @throw std::bad_weak_ptr when the object has expired
+     */
+    inline std::optional<view> get_view(const handle &content_handle)
+    {
+        access_result<view> result(try_get_view(content_handle));
+        if (!result) throw std::bad_weak_ptr();
+        return std::move(result.to_optional());
+    }
+    
+    /**
+     * Blocking version of get_const_view which reports expiry instead of throwing
+     * @return access_status::acquired or access_status::expired
+     */
+    inline access_result<const_view> try_get_const_view(const handle &content_handle)
+    {
+        return try_acquire<const_view, shared_lock_type>(content_handle, access_status::acquired);
+    }
+    
+    /**
+     * Timed version of get_const_view which reports expiry instead of throwing
+     * @return access_status::acquired, access_status::expired or access_status::timed_out
+     */
+    template<class Rep, class Period>
+    inline access_result<const_view> try_get_const_view(
+            const handle &content_handle, const std::chrono::duration<Rep, Period> &timeout_duration
+    )
+    {
+        return try_acquire<const_view, shared_lock_type>(content_handle, access_status::timed_out, timeout_duration);
+    }
+    
+    /**
+     * Create a const_view only if the object can be locked without waiting
+     * @return access_status::acquired, access_status::expired or access_status::contended
+     */
+    inline access_result<const_view> try_lock_const_view(const handle &content_handle)
+    {
+        return try_acquire<const_view, shared_lock_type>(content_handle, access_status::contended, std::try_to_lock);
+    }
+    
+    /**
+     * Blocking version of get_view which reports expiry instead of throwing
+     * @return access_status::acquired or access_status::expired
+     */
+    inline access_result<view> try_get_view(const handle &content_handle)
+    {
+        return try_acquire<view, unique_lock_type>(content_handle, access_status::acquired);
+    }
+    
+    /**
+     * Timed version of get_view which reports expiry instead of throwing
+     * @return access_status::acquired, access_status::expired or access_status::timed_out
+     */
+    template<class Rep, class Period>
+    inline access_result<view> try_get_view(
+            const handle &content_handle, const std::chrono::duration<Rep, Period> &timeout_duration
+    )
+    {
+        return try_acquire<view, unique_lock_type>(content_handle, access_status::timed_out, timeout_duration);
+    }
+    
+    /**
+     * Create a view only if the object can be locked without waiting
+     * @return access_status::acquired, access_status::expired or access_status::contended
+     */
+    inline access_result<view> try_lock_view(const handle &content_handle)
+    {
+        return try_acquire<view, unique_lock_type>(content_handle, access_status::contended, std::try_to_lock);
+    }
+    
+    /**
+     * Visit every object alive in slot order, each one under its shared lock
+     * @tparam function_t callable with const handle & and const T &
+     * @param function
+     */
+    template<typename function_t>
+    inline void for_each(function_t &&function)
+    {
+        std::uint32_t index_count;
+        {
+            std::lock_guard<std::mutex> allocation_lock(allocation_guard);
+            index_count = used_index_count;
+        }
+        for (std::uint32_t index = 0; index < index_count; ++index)
+        {
+            slot *const target = locate(index);
+            shared_lock_type content_lock(target->content_guard);
+            const std::uint32_t generation = target->generation.load(std::memory_order_acquire);
+            if (!(generation & 1u)) continue;
+            const handle content_handle(index, generation);
+            function(content_handle, std::as_const(*target->content()));
+        }
+    }
+
+private:
+    /**
+     * Lock the slot of content_handle and check that it still holds the same object
+     * @tparam view_type view or const_view
+     * @tparam lock_type guard type held by view_type
+     * @tparam lock_args_t types of the arguments following the mutex in the constructor of lock_type
+     * @param content_handle
+     * @param failure status returned when the lock is not owned after construction
+     * @param lock_args std::try_to_lock, a timeout duration or nothing
+     */
+    template<typename view_type, typename lock_type, typename ...lock_args_t>
+    inline access_result<view_type> try_acquire(
+            const handle &content_handle, access_status failure, lock_args_t &&...lock_args
+    )
+    {
+        slot *const target = locate(content_handle.index);
+        if (!target || !(content_handle.generation & 1u)) return access_result<view_type>(access_status::expired);
+        lock_type content_guard_lock(target->content_guard, std::forward<lock_args_t>(lock_args)...);
+        if (!content_guard_lock) return access_result<view_type>(failure);
+        if (target->generation.load(std::memory_order_acquire) != content_handle.generation)
+            return access_result<view_type>(access_status::expired);
+        return access_result<view_type>(view_type(target->content(), std::move(content_guard_lock)));
+    }
+};
+
+#endif //HEADER_GUARD__71f3a0d8_5e2b_4c96_a4d7_c08e92b1f56a__referable_pool_hpp
@@ -0,0 +1,144 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__5b0e2a61_93d4_4f0c_b7a8_2e6c1d94f37e__referable_registry_hpp
+#define HEADER_GUARD__5b0e2a61_93d4_4f0c_b7a8_2e6c1d94f37e__referable_registry_hpp
+
+#include "variable_util_includes.h"
+
+/**
+ * Process wide index of the live referable_unique<T, lock_policy> objects by id.
+ * Every object constructed with a non-empty id registers itself,
+ * and is removed when its owner is destroyed.
+ * Ids are unique among registered objects: an object constructed with the id of a live registered object
+ * is not registered, neither then nor after the first one is destroyed, so find keeps returning the first one.
+ * Registering allocates a node of the map, so a tagged object costs one allocation more than an untagged one.
+ * The map is split into shard_count shards, each guarded by its own futex_shared_mutex,
+ * so lookups of different ids never contend and lookups of the same id only share a lock.
+ * @tparam T non-const content type
+ * @tparam lock_policy type of Container::content_guard of the registered objects
+ */
+template<typename T, typename lock_policy>
+class referable_registry final
+{
+private:
+    using referable_unique_type = referable_unique<T, lock_policy>;
+    using Container = typename referable_unique_type::Container;
+    
+    friend referable_unique_type;
+    
+    ///Must be a power of 2
+    static constexpr std::size_t shard_count = 64;
+    
+    struct entry final
+    {
+        typename referable_unique_type::weak_ptr handle;
+        ///Identifies the registering object, compared but never dereferenced
+        const Container *container;
+        
+        inline explicit entry(const referable_unique_type &owner) noexcept :
+                handle(owner), container(owner.container.get())
+        {}
+    };
+    
+    struct alignas(64) shard final
+    {
+        futex_shared_mutex guard;
+        std::unordered_map<referable_tag, entry, referable_tag::hasher> entries;
+    };
+    
+    shard shards[shard_count];
+    
+    inline referable_registry() = default;
+    
+    inline explicit referable_registry(const referable_registry &) = delete;
+    
+    inline referable_registry &operator=(const referable_registry &) = delete;
+    
+    /// the low bits select the bucket inside a shard, so the shard takes the high bits
+    inline shard &shard_of(const referable_tag &id) noexcept
+    {
+        return shards[(id.hash() >> 58) & (shard_count - 1)];
+    }
+    
+    /**
+     * Called by the constructors of referable_unique with a non-empty id
+     * @return false if another live object is registered with the same id, which is kept
+     */
+    inline bool insert(const referable_unique_type &owner)
+    {
+        const referable_tag &id = owner.container->content_id;
+        shard &target = shard_of(id);
+        std::lock_guard<futex_shared_mutex> shard_lock(target.guard);
+        return target.entries.try_emplace(id, owner).second;
+    }
+    
+    /**
+     * Called by the destructor of referable_unique with a non-empty id.
+     * The entry is kept unless it was registered by container.
+     */
+    inline void erase(const referable_tag &id, const Container *container) noexcept
+    {
+        shard &target = shard_of(id);
+        std::lock_guard<futex_shared_mutex> shard_lock(target.guard);
+        if (auto found = target.entries.find(id); found != target.entries.end() &&
+                                                  found->second.container == container)
+            target.entries.erase(found);
+    }
+
+public:
+    /**
+     * The registry is never destroyed,
+     * so that objects with static storage duration can unregister at exit.
+     * @return the registry of referable_unique<T, lock_policy>
+     */
+    inline static referable_registry &instance()
+    {
+        static referable_registry *const registry = new referable_registry();
+        return *registry;
+    }
+    
+    /**
+     * @param id
+     * @return weak_ptr of the object registered with id, or std::nullopt if there is none.
+     * The weak_ptr may expire as soon as it is returned.
+     */
+    inline std::optional<typename referable_unique_type::weak_ptr> find(const referable_tag &id)
+    {
+        shard &target = shard_of(id);
+        std::shared_lock<futex_shared_mutex> shard_lock(target.guard);
+        if (auto found = target.entries.find(id); found != target.entries.end())
+            return std::optional<typename referable_unique_type::weak_ptr>(std::in_place, found->second.handle);
+        return std::nullopt;
+    }
+    
+    /**
+     * @param id
+     * @return whether an object is registered with id
+     */
+    inline bool contains(const referable_tag &id)
+    {
+        shard &target = shard_of(id);
+        std::shared_lock<futex_shared_mutex> shard_lock(target.guard);
+        return target.entries.count(id) != 0;
+    }
+    
+    /**
+     * Shards are counted one after another,
+     * so the result is only exact when no object is constructed or destroyed meanwhile.
+     * @return number of registered objects
+     */
+    inline std::size_t size()
+    {
+        std::size_t registered_count = 0;
+        for (shard &each: shards)
+        {
+            std::shared_lock<futex_shared_mutex> shard_lock(each.guard);
+            registered_count += each.entries.size();
+        }
+        return registered_count;
+    }
+};
+
+#endif //HEADER_GUARD__5b0e2a61_93d4_4f0c_b7a8_2e6c1d94f37e__referable_registry_hpp
@@ -0,0 +1,317 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__683f2bab_6934_410a_8ff2_2b4eaebdd29e__referable_snapshot_hpp
+#define HEADER_GUARD__683f2bab_6934_410a_8ff2_2b4eaebdd29e__referable_snapshot_hpp
+
+#include "variable_util_includes.h"
+
+#if defined(__linux__)
+
+/**
+ * Layout of a snapshot file written by write_referable_snapshot:
+ * the header, the contents as an array of T at content_offset,
+ * two tag records per content (id then label) at tag_offset,
+ * and the characters of the string tags at string_offset.
+ * Every number is in the byte order of the writing machine.
+ */
+struct snapshot_header final
+{
+    static constexpr char expected_magic[8] = {'V', 'U', 'S', 'N', 'A', 'P', '\0', '\0'};
+    static constexpr std::uint32_t current_format = 1;
+    
+    char magic[8];
+    std::uint32_t format;
+    std::uint32_t content_size;
+    std::uint32_t content_alignment;
+    std::uint32_t reserved;
+    std::uint64_t count;
+    std::uint64_t content_offset;
+    std::uint64_t tag_offset;
+    std::uint64_t string_offset;
+    std::uint64_t string_size;
+};
+
+/**
+ * A referable_tag in a snapshot file.
+ * value is the integer of an integer tag or the offset of the characters of a string tag.
+ */
+struct snapshot_tag_record final
+{
+    std::uint64_t value;
+    std::uint32_t length;
+    std::uint8_t kind;
+    std::uint8_t padding[3];
+};
+
+/**
+ * A snapshot file mapped copy-on-write.
+ * Restored contents alias it, so it is unmapped when the last of them is gone.
+ */
+class snapshot_mapping final
+{
+private:
+    void *address;
+    std::size_t length;
+    
+    inline explicit snapshot_mapping(const snapshot_mapping &) = delete;
+    
+    inline snapshot_mapping &operator=(const snapshot_mapping &) = delete;
+
+public:
+    /**
+     * Map the whole file privately, pages are read on first access
+     * and copied on first write, which never reaches the file
+     * @param path
+     * @throw std::system_error when the file cannot be opened or mapped
+     */
+    inline explicit snapshot_mapping(const std::string &path) : address(MAP_FAILED), length(0)
+    {
+        const int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (descriptor < 0) throw std::system_error(errno, std::generic_category(), "open " + path);
+        struct stat file_status{};
+        if (::fstat(descriptor, &file_status) == 0 && file_status.st_size > 0)
+        {
+            length = static_cast<std::size_t>(file_status.st_size);
+            address = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, descriptor, 0);
+        }
+        const int mapping_error = errno;
+        ::close(descriptor);
+        if (address == MAP_FAILED)
+            throw std::system_error(length ? mapping_error : EINVAL, std::generic_category(), "mmap " + path);
+    }
+    
+    inline ~snapshot_mapping()
+    {
+        ::munmap(address, length);
+    }
+    
+    inline unsigned char *data() const noexcept
+    {
+        return static_cast<unsigned char *>(address);
+    }
+    
+    inline std::size_t size() const noexcept
+    {
+        return length;
+    }
+};
+
+/**
+ * Write the contents and tags of [first, last) to a snapshot file for restore_referable_snapshot.
+ * Each content is copied under its shared lock, so every content is consistent
+ * but contents modified during the call are not captured at one instant.
+ * The file is written next to path and renamed over it once synced,
+ * so that a crash never leaves a truncated snapshot at path.
+ * @tparam T trivially copyable content type
+ * @tparam lock_policy
+ * @tparam iterator_t forward iterator of referable_unique<T, lock_policy>
+ * @param path
+ * @param first
+ * @param last
+ * @return number of contents written
+ * @throw std::invalid_argument when an owner of [first, last) has been moved from, before the file is created
+ * @throw std::system_error when the file cannot be written
+ */
+template<typename T, typename lock_policy, typename iterator_t>
+inline std::uint64_t write_referable_snapshot(const std::string &path, iterator_t first, iterator_t last)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "referable snapshots require a trivially copyable content type");
+    
+    for (iterator_t current = first; current != last; ++current)
+    {
+        const referable_unique<T, lock_policy> &owner = *current;
+        if (!owner) throw std::invalid_argument("write_referable_snapshot: moved from referable_unique");
+    }
+    const std::string partial_path = path + ".partial";
+    std::unique_ptr<std::FILE, int (*)(std::FILE *)> file(std::fopen(partial_path.c_str(), "wb"), &std::fclose);
+    if (!file) throw std::system_error(errno, std::generic_category(), "fopen " + partial_path);
+    const auto check = [&](bool succeeded)
+    {
+        if (succeeded) return;
+        const int write_error = errno;
+        file.reset();
+        std::remove(partial_path.c_str());
+        throw std::system_error(write_error, std::generic_category(), "write " + partial_path);
+    };
+    const auto align = [](std::uint64_t offset, std::uint64_t alignment)
+    {
+        return (offset + alignment - 1) / alignment * alignment;
+    };
+    
+    snapshot_header header{};
+    std::memcpy(header.magic, snapshot_header::expected_magic, sizeof(header.magic));
+    header.format = snapshot_header::current_format;
+    header.content_size = sizeof(T);
+    header.content_alignment = alignof(T);
+    header.count = static_cast<std::uint64_t>(std::distance(first, last));
+    header.content_offset = align(sizeof(snapshot_header), std::max<std::uint64_t>(alignof(T), 64));
+    header.tag_offset = align(header.content_offset + header.count * sizeof(T), alignof(snapshot_tag_record));
+    header.string_offset = header.tag_offset + header.count * 2 * sizeof(snapshot_tag_record);
+    
+    static const unsigned char zeros[64] = {};
+    check(std::fseek(file.get(), static_cast<long>(header.content_offset), SEEK_SET) == 0);
+    for (iterator_t current = first; current != last; ++current)
+    {
+        const referable_unique<T, lock_policy> &owner = *current;
+        auto content_view = owner.borrow_const();
+        check(std::fwrite(&*content_view, sizeof(T), 1, file.get()) == 1);
+    }
+    const std::uint64_t tag_padding = header.tag_offset - header.content_offset - header.count * sizeof(T);
+    check(std::fwrite(zeros, 1, tag_padding, file.get()) == tag_padding);
+    
+    ///Offsets of the distinct strings, each written once
+    std::unordered_map<std::string_view, std::uint64_t> string_offsets;
+    const auto write_record = [&](const referable_tag &tag)
+    {
+        snapshot_tag_record record{};
+        record.kind = static_cast<std::uint8_t>(tag.get_kind());
+        if (const auto integer = tag.as_integer(); integer)
+        {
+            record.value = static_cast<std::uint64_t>(*integer);
+            record.length = sizeof(std::int64_t);
+        }
+        else if (const auto string = tag.as_string(); string)
+        {
+            const auto [offset, inserted] = string_offsets.try_emplace(*string, header.string_size);
+            record.value = offset->second;
+            record.length = static_cast<std::uint32_t>(string->size());
+            if (inserted) header.string_size += string->size();
+        }
+        check(std::fwrite(&record, sizeof(record), 1, file.get()) == 1);
+    };
+    std::uint64_t string_written = 0;
+    const auto write_string = [&](const referable_tag &tag)
+    {
+        if (const auto string = tag.as_string(); string && string_offsets[*string] == string_written)
+        {
+            check(std::fwrite(string->data(), 1, string->size(), file.get()) == string->size());
+            string_written += string->size();
+        }
+    };
+    for (iterator_t current = first; current != last; ++current)
+    {
+        const referable_unique<T, lock_policy> &owner = *current;
+        write_record(owner.id());
+        write_record(owner.label());
+    }
+    for (iterator_t current = first; current != last; ++current)
+    {
+        const referable_unique<T, lock_policy> &owner = *current;
+        write_string(owner.id());
+        write_string(owner.label());
+    }
+    
+    check(std::fseek(file.get(), 0, SEEK_SET) == 0);
+    check(std::fwrite(&header, sizeof(header), 1, file.get()) == 1);
+    check(std::fflush(file.get()) == 0);
+    check(::fsync(::fileno(file.get())) == 0);
+    check(std::fclose(file.release()) == 0);
+    if (std::rename(partial_path.c_str(), path.c_str()) != 0)
+    {
+        const int rename_error = errno;
+        std::remove(partial_path.c_str());
+        throw std::system_error(rename_error, std::generic_category(), "rename " + partial_path);
+    }
+    return header.count;
+}
+
+/**
+ * Write every referable_unique of a container to a snapshot file
+ * @see write_referable_snapshot(const std::string &, iterator_t, iterator_t)
+ */
+template<typename T, typename lock_policy, typename allocator_t>
+inline std::uint64_t write_referable_snapshot(
+        const std::string &path, const std::vector<referable_unique<T, lock_policy>, allocator_t> &owners
+)
+{
+    return write_referable_snapshot<T, lock_policy>(path, owners.begin(), owners.end());
+}
+
+/**
+ * Reopen a snapshot file written by write_referable_snapshot without copying the contents.
+ * The file is mapped copy-on-write and every content of the result points into the mapping,
+ * so restoring costs one allocation per content for its Container and its tags, whatever the size of T,
+ * and a page is read from the file when first accessed.
+ * Each restored content expires on its own, the mapping is kept by the block of every Container.
+ * The first view writing to a page gets a private copy of it, the file is never modified.
+ * Contents with an id are registered to referable_registry as on construction.
+ * The mapping is released when the last restored content has expired
+ * and the last view and weak_ptr of them are gone.
+ * @tparam T trivially copyable content type, the same as the one written
+ * @tparam lock_policy
+ * @param path
+ * @return the restored owners in the order they were written
+ * @throw std::system_error when the file cannot be mapped
+ * @throw std::runtime_error when the file is not a snapshot of T
+ */
+template<typename T, typename lock_policy = VARIABLE_UTIL_DEFAULT_LOCK_POLICY>
+inline std::vector<referable_unique<T, lock_policy>> restore_referable_snapshot(const std::string &path)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "referable snapshots require a trivially copyable content type");
+    
+    auto mapping = std::make_shared<snapshot_mapping>(path);
+    const unsigned char *const base = mapping->data();
+    const std::uint64_t file_size = mapping->size();
+    
+    snapshot_header header{};
+    if (file_size < sizeof(header)) throw std::runtime_error("not a referable snapshot: " + path);
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, snapshot_header::expected_magic, sizeof(header.magic)) != 0 ||
+        header.format != snapshot_header::current_format)
+        throw std::runtime_error("not a referable snapshot: " + path);
+    if (header.content_size != sizeof(T) || header.content_alignment != alignof(T) ||
+        header.content_offset % alignof(T) != 0)
+        throw std::runtime_error("referable snapshot of another content type: " + path);
+    if (header.content_offset < sizeof(snapshot_header) || header.tag_offset % alignof(snapshot_tag_record) != 0)
+        throw std::runtime_error("not a referable snapshot: " + path);
+    /// offsets are compared by subtraction once ordered, so that corrupted ones cannot wrap around
+    if (header.string_offset > file_size || header.tag_offset > header.string_offset ||
+        header.content_offset > header.tag_offset ||
+        header.count > file_size / 2 / sizeof(snapshot_tag_record) ||
+        header.count > (header.tag_offset - header.content_offset) / sizeof(T) ||
+        header.string_offset - header.tag_offset != header.count * 2 * sizeof(snapshot_tag_record) ||
+        header.string_size > file_size - header.string_offset)
+        throw std::runtime_error("truncated referable snapshot: " + path);
+    
+    const auto *const records = reinterpret_cast<const snapshot_tag_record *>(base + header.tag_offset);
+    const auto *const strings = reinterpret_cast<const char *>(base + header.string_offset);
+    ///Long string tags restored once per offset, so that their copies share one string
+    std::unordered_map<std::uint64_t, referable_tag> interned_tags;
+    const auto restore_tag = [&](const snapshot_tag_record &record)
+    {
+        switch (static_cast<referable_tag::kind_t>(record.kind))
+        {
+            case referable_tag::kind_t::integer:
+                return referable_tag(static_cast<std::int64_t>(record.value));
+            case referable_tag::kind_t::string:
+                if (record.value > header.string_size || record.length > header.string_size - record.value)
+                    throw std::runtime_error("truncated referable snapshot: " + path);
+                if (record.length <= referable_tag::inline_capacity)
+                    return referable_tag(std::string_view(strings + record.value, record.length));
+                if (const auto found = interned_tags.find(record.value); found != interned_tags.end())
+                    return found->second;
+                return interned_tags.try_emplace(
+                        record.value, std::string_view(strings + record.value, record.length)
+                ).first->second;
+            default:
+                return referable_tag();
+        }
+    };
+    
+    std::vector<referable_unique<T, lock_policy>> owners;
+    owners.reserve(header.count);
+    for (std::uint64_t i = 0; i < header.count; ++i)
+    {
+        T *const content = reinterpret_cast<T *>(mapping->data() + header.content_offset + i * sizeof(T));
+        owners.emplace_back(
+                external_storage, restore_tag(records[2 * i]), restore_tag(records[2 * i + 1]), content, mapping
+        );
+    }
+    return owners;
+}
+
+#endif
+
+#endif //HEADER_GUARD__683f2bab_6934_410a_8ff2_2b4eaebdd29e__referable_snapshot_hpp
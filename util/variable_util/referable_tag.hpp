@@ -0,0 +1,248 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__c639ef14_7cbf_48d9_abb3_15c15c7778a7__referable_tag_hpp
+#define HEADER_GUARD__c639ef14_7cbf_48d9_abb3_15c15c7778a7__referable_tag_hpp
+
+#include "variable_util_includes.h"
+
+/**
+ * Compact id or label of a referable_unique.
+ * A tag is empty, an integer or a string.
+ * Integers and strings up to inline_capacity bytes are stored inline,
+ * longer strings are stored once per constructed tag and shared by its copies through a reference count,
+ * so no tag allocates on copy and a long string is freed with the last copy of its tag.
+ * The hash is computed once on construction,
+ * so only tags of equal hashes compare their characters.
+ */
+class referable_tag final
+{
+public:
+    static constexpr std::size_t inline_capacity = 16;
+    
+    enum class kind_t : std::uint8_t
+    {
+        empty, integer, string
+    };
+    
+    ///Hash functor for unordered containers
+    struct hasher
+    {
+        inline std::size_t operator()(const referable_tag &tag) const noexcept
+        {
+            return static_cast<std::size_t>(tag.hash());
+        }
+    };
+
+private:
+    ///Out of line string of a tag longer than inline_capacity, the characters follow it
+    struct shared_string final
+    {
+        std::atomic<std::size_t> reference_count;
+        
+        inline const char *characters() const noexcept
+        {
+            return reinterpret_cast<const char *>(this + 1);
+        }
+    };
+    
+    /**
+     * integer: the value in the first 8 bytes
+     * string:  the characters if length <= inline_capacity,
+     *          otherwise the address of the shared_string
+     */
+    alignas(8) unsigned char storage[inline_capacity];
+    std::uint64_t hash_value;
+    std::uint32_t length;
+    kind_t kind;
+    
+    static inline std::uint64_t mix(std::uint64_t value) noexcept
+    {
+        value ^= value >> 30;
+        value *= 0xbf58476d1ce4e5b9ull;
+        value ^= value >> 27;
+        value *= 0x94d049bb133111ebull;
+        value ^= value >> 31;
+        return value;
+    }
+    
+    static inline std::uint64_t hash_string(std::string_view string) noexcept
+    {
+        std::uint64_t value = 0xcbf29ce484222325ull;
+        for (unsigned char character: string)
+        {
+            value ^= character;
+            value *= 0x100000001b3ull;
+        }
+        return mix(value);
+    }
+    
+    ///@return the shared_string of a string longer than inline_capacity, or nullptr
+    inline shared_string *shared() const noexcept
+    {
+        if (kind != kind_t::string || length <= inline_capacity) return nullptr;
+        shared_string *string;
+        std::memcpy(&string, storage, sizeof(string));
+        return string;
+    }
+    
+    inline void release() noexcept
+    {
+        if (shared_string *const string = shared();
+                string && string->reference_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            string->~shared_string();
+            ::operator delete(string);
+        }
+    }
+
+public:
+    ///Empty tag
+    inline referable_tag() noexcept :
+            storage(), hash_value(0), length(0), kind(kind_t::empty)
+    {}
+    
+    /**
+     * Integer tag, integers of every type with the same value are equal
+     * @tparam integer_t integral type
+     * @param integer
+     */
+    template<
+            typename integer_t,
+            typename = std::enable_if_t<std::is_integral_v<integer_t> && !std::is_same_v<integer_t, bool>>
+    >
+    inline referable_tag(integer_t integer) noexcept :
+            storage(), hash_value(mix(static_cast<std::uint64_t>(integer))),
+            length(sizeof(std::int64_t)), kind(kind_t::integer)
+    {
+        const auto value = static_cast<std::int64_t>(integer);
+        std::memcpy(storage, &value, sizeof(value));
+    }
+    
+    /**
+     * String tag, allocated out of line when longer than inline_capacity
+     * @param string
+     */
+    inline referable_tag(std::string_view string) :
+            storage(), hash_value(hash_string(string)),
+            length(static_cast<std::uint32_t>(string.size())), kind(kind_t::string)
+    {
+        if (string.size() <= inline_capacity) std::memcpy(storage, string.data(), string.size());
+        else
+        {
+            auto *const allocated = new(::operator new(sizeof(shared_string) + string.size())) shared_string{{1}};
+            std::memcpy(reinterpret_cast<char *>(allocated + 1), string.data(), string.size());
+            std::memcpy(storage, &allocated, sizeof(allocated));
+        }
+    }
+    
+    inline referable_tag(const std::string &string) :
+            referable_tag(std::string_view(string))
+    {}
+    
+    ///String tag, or empty tag for nullptr
+    inline referable_tag(const char *string) :
+            referable_tag()
+    {
+        if (string) *this = referable_tag(std::string_view(string));
+    }
+    
+    inline referable_tag(const referable_tag &another) noexcept :
+            hash_value(another.hash_value), length(another.length), kind(another.kind)
+    {
+        std::memcpy(storage, another.storage, inline_capacity);
+        if (shared_string *const string = shared()) string->reference_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    inline referable_tag(referable_tag &&another) noexcept :
+            hash_value(another.hash_value), length(another.length), kind(another.kind)
+    {
+        std::memcpy(storage, another.storage, inline_capacity);
+        another.kind = kind_t::empty;
+        another.length = 0;
+        another.hash_value = 0;
+        std::memset(another.storage, 0, inline_capacity);
+    }
+    
+    inline referable_tag &operator=(const referable_tag &another) noexcept
+    {
+        if (this != &another)
+        {
+            referable_tag copy(another);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+    
+    inline referable_tag &operator=(referable_tag &&another) noexcept
+    {
+        if (this != &another)
+        {
+            release();
+            std::memcpy(storage, another.storage, inline_capacity);
+            hash_value = another.hash_value;
+            length = another.length;
+            kind = another.kind;
+            another.kind = kind_t::empty;
+            another.length = 0;
+            another.hash_value = 0;
+            std::memset(another.storage, 0, inline_capacity);
+        }
+        return *this;
+    }
+    
+    inline ~referable_tag()
+    {
+        release();
+    }
+    
+    inline kind_t get_kind() const noexcept
+    {
+        return kind;
+    }
+    
+    inline bool empty() const noexcept
+    {
+        return kind == kind_t::empty;
+    }
+    
+    inline std::uint64_t hash() const noexcept
+    {
+        return hash_value;
+    }
+    
+    inline std::optional<std::int64_t> as_integer() const noexcept
+    {
+        if (kind != kind_t::integer) return std::nullopt;
+        std::int64_t value;
+        std::memcpy(&value, storage, sizeof(value));
+        return value;
+    }
+    
+    /**
+     * @return the string, which refers to this tag or to the string shared by its copies
+     */
+    inline std::optional<std::string_view> as_string() const noexcept
+    {
+        if (kind != kind_t::string) return std::nullopt;
+        if (const shared_string *const string = shared()) return std::string_view(string->characters(), length);
+        return std::string_view(reinterpret_cast<const char *>(storage), length);
+    }
+    
+    inline bool operator==(const referable_tag &another) const noexcept
+    {
+        if (hash_value != another.hash_value || length != another.length || kind != another.kind) return false;
+        if (std::memcmp(storage, another.storage, inline_capacity) == 0) return true;
+        /// long strings constructed apart have different addresses
+        const shared_string *const string = shared();
+        return string && std::memcmp(string->characters(), another.shared()->characters(), length) == 0;
+    }
+    
+    inline bool operator!=(const referable_tag &another) const noexcept
+    {
+        return !(*this == another);
+    }
+};
+
+#endif //HEADER_GUARD__c639ef14_7cbf_48d9_abb3_15c15c7778a7__referable_tag_hpp
@@ -10,11 +10,16 @@
 /**
  * The primary class template of referable_unique.
  * @tparam T Type
+ * @tparam lock_policy type of Container::content_guard,
+ * std::shared_timed_mutex, std::mutex, spin_shared_mutex, futex_shared_mutex, null_mutex, instrumented_mutex
+ * or awaitable_mutex, VARIABLE_UTIL_DEFAULT_LOCK_POLICY by default.
+ * spin_shared_mutex and futex_shared_mutex also provide upgradable_view.
+ * storage_policy_t<T> picks atomic_storage_policy or seqlock_policy for small trivially copyable T.
  * @tparam 15 anonymous type template parameters with default type void for future use.
  */
 template<
         typename T,
-        typename = void,
+        typename lock_policy = VARIABLE_UTIL_DEFAULT_LOCK_POLICY,
         typename = void,
         typename = void,
         typename = void,
@@ -43,9 +48,10 @@ class referable_unique final
  * Partial specification aimed to confirm
  * the first type parameter is non-const.
  * @tparam T Type
+ * @tparam lock_policy
  */
-template<typename T>
-class referable_unique<const T>
+template<typename T, typename lock_policy>
+class referable_unique<const T, lock_policy>
 {
     static_assert(
             !std::is_const<const T>::value,
@@ -53,28 +59,61 @@ class referable_unique<const T>
     );
 };
 
+/**
+ * Tag selecting the constructor of referable_unique
+ * whose content lives in storage it does not own, kept alive by a keeper
+ */
+struct external_storage_t final
+{
+    inline explicit external_storage_t() = default;
+};
+
+inline constexpr external_storage_t external_storage{};
+
+template<typename T, typename lock_policy>
+class referable_registry;
+
+template<typename T, typename lock_policy>
+class handle_cache;
 
 /**
+ * Objects constructed with a non-empty id are found by referable_registry<T, lock_policy>.
  * @tparam T non-const content type. It is guaranteed by std::enable_if_t<!std::is_const<T>::value, T>
+ * @tparam lock_policy type of Container::content_guard
  */
-template<typename T>
+template<typename T, typename lock_policy>
 class referable_unique<
-        T, std::enable_if_t<
+        T, lock_policy, std::enable_if_t<
                 (!std::is_const<T>::value) &&
-                (!type_util::is_class_template_instance<T, std::atomic>::value)
+                (!type_util::is_class_template_instance<T, std::atomic>::value) &&
+                (!type_util::class_template_instance_base<T, referable_base>::value) &&
+                (!std::is_base_of<guard_mode, lock_policy>::value)
         >
 > final
 {
 private:
     static_assert(std::is_const_v<T> == 0, "referable_unique requires a non-const content type");
     
-    friend class referable_unique<T, std::shared_timed_mutex>;
+    using unique_lock_type = typename lock_traits<lock_policy>::unique_lock_type;
+    using shared_lock_type = typename lock_traits<lock_policy>::shared_lock_type;
     
-    ///std::shared_ptr applied as unique pointer aimed to use std::weak_ptr
-    std::shared_ptr<T> content_shared_ptr;
-    //std::shared_ptr<std::atomic_uint64_t> content_weak_ptr_count;
+    template<
+            typename, typename, typename, typename, typename, typename, typename, typename, typename,
+            typename, typename, typename, typename, typename, typename, typename, typename
+    > friend
+    class referable_unique;
+    
+    friend class referable_registry<T, lock_policy>;
     
-    ///Data Class
+    friend class handle_cache<T, lock_policy>;
+    
+    /**
+     * Data Class
+     * Besides content_guard, every Container carries the version, the flags, the combining queue
+     * and the notifier used by weak_ptr::read, apply, wait_for_change and subscribe, whatever lock_policy is.
+     * They take 56 bytes on 64-bit targets and allocate nothing until they are used,
+     * and a view releasing the content bumps the version and loads the watcher count.
+     */
     class Container
     {
     private:
@@ -88,25 +127,173 @@ private:
         inline explicit Container(Container &&) = delete;
     
     public:
-        std::any content_id, content_label;
-        //todo:consider to use another data structure to store tag
+        referable_tag content_id, content_label;
+        ///guarantee thread safety of the content
+        lock_policy content_guard;
+        /**
+         * Sequence number of modifications of the content.
+         * It is odd while a view holds content_guard exclusively,
+         * so optimistic readers retry when it is odd or has changed.
+         */
+        std::atomic<std::uint64_t> content_version;
+        ///Mutations published by weak_ptr::apply, run by whichever thread holds content_guard exclusively
+        combining_queue<T> pending_requests;
+        ///Set when the owner is destroyed, so that handle_cache drops contents it keeps alive
+        std::atomic<bool> retired;
         /**
-         * content_guard: guarantee thread safety of the content
-         * state_holder:  UNUSED state holder of this container
+         * Set by the first weak_ptr::read, which pins the content with an epoch_guard instead of a reference.
+         * The owner then releases its references through epoch_domain, after every such reader has left.
          */
-        std::shared_timed_mutex content_guard, state_holder;
+        mutable std::atomic<bool> optimistic_readers;
+        ///Waiters of weak_ptr::wait_for_change and subscribers of weak_ptr::subscribe
+        change_notifier notifier;
+        ///Dereferenced by weak_ptr::read, which holds no reference to the content
+        const T *content_address;
         
         ///Default constructor
         inline explicit Container(
-                const std::any &id = std::any(), const std::any &label = std::any()
+                const referable_tag &id = referable_tag(), const referable_tag &label = referable_tag()
         ) noexcept :
                 content_id(id), content_label(label),
-                content_guard(), state_holder()
+                content_guard(),
+                content_version(0), pending_requests(), retired(false), optimistic_readers(false), notifier(),
+                content_address(nullptr)
+        {
+            if constexpr (is_instrumented_lock<lock_policy>::value) content_guard.bind(content_id, content_label);
+        }
+        
+        ///Called with content_guard locked exclusively, before the content is modified
+        inline void begin_write() noexcept
+        {
+            content_version.store(
+                    content_version.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed
+            );
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+        
+        ///Called with content_guard locked exclusively, after the content is modified
+        inline void end_write() noexcept
+        {
+            content_version.store(
+                    content_version.load(std::memory_order_relaxed) + 1, std::memory_order_release
+            );
+        }
+        
+        ///@return number of views released so far
+        inline std::uint64_t version() const noexcept
+        {
+            return content_version.load(std::memory_order_acquire) >> 1;
+        }
+        
+        /**
+         * Called after a view has released content_guard
+         * @param watched notifier.watched() read before content_guard was released
+         */
+        inline void notify_change(bool watched)
+        {
+            if (watched) notifier.notify(version());
+        }
+    };
+    
+    /**
+     * Seqlock read of the content.
+     * Copies the content with seqlock_copy guarded by content_version
+     * and passes the copy to function, so readers never write shared memory.
+     * @tparam function_t callable with const T &
+     * @param container Container of the content
+     * @param content the content
+     * @param function callable invoked once with a consistent copy of the content
+     * @return the result of function
+     */
+    template<typename function_t>
+    static inline decltype(auto) read_snapshot(
+            const Container &container, const T &content, function_t &&function
+    )
+    {
+        static_assert(
+                std::is_trivially_copyable_v<T>,
+                "optimistic read requires a trivially copyable content type"
+        );
+        alignas(T) unsigned char snapshot[sizeof(T)];
+        seqlock_copy(container.content_version, &content, snapshot, sizeof(T));
+        return std::forward<function_t>(function)(*std::launder(reinterpret_cast<const T *>(snapshot)));
+    }
+    
+    /**
+     * Result of weak_ptr::read,
+     * bool for function returning void, otherwise std::optional of the result
+     */
+    template<typename function_t>
+    using read_result_t = std::conditional_t<
+            std::is_void_v<std::invoke_result_t<function_t, const T &>>,
+            bool, std::optional<std::invoke_result_t<function_t, const T &>>
+    >;
+    
+    /**
+     * Result of weak_ptr::apply,
+     * bool for function returning void, otherwise std::optional of the result
+     */
+    template<typename function_t>
+    using apply_result_t = std::conditional_t<
+            std::is_void_v<std::invoke_result_t<function_t, T &>>,
+            bool, std::optional<std::remove_cv_t<std::remove_reference_t<std::invoke_result_t<function_t, T &>>>>
+    >;
+    
+    /**
+     * Storage used by in-place construction.
+     * The content and its Container live in one block,
+     * so that std::make_shared allocates content, Container and
+     * the shared strong/weak counts at once and keeps them adjacent.
+     * content_shared_ptr and container alias this block
+     * and therefore share one control block.
+     */
+    struct fused_block final
+    {
+        Container container;
+        T content;
+        
+        template<typename ...args_t>
+        inline explicit fused_block(
+                const referable_tag &id, const referable_tag &label, args_t &&...args
+        ) :
+                container(id, label),
+                content(std::forward<args_t>(args)...)
+        {}
+    };
+    
+    /**
+     * Storage used by the external storage constructor.
+     * The Container and the keeper of the content live in one block
+     * which content_shared_ptr and container alias, as with fused_block.
+     */
+    template<typename keeper_t>
+    struct external_block final
+    {
+        Container container;
+        keeper_t keeper;
+        
+        template<typename keeper_arg_t>
+        inline explicit external_block(
+                const referable_tag &id, const referable_tag &label, keeper_arg_t &&keeper_arg
+        ) :
+                container(id, label),
+                keeper(std::forward<keeper_arg_t>(keeper_arg))
         {}
     };
     
+    ///References of a destroyed owner kept until the optimistic readers have left their epoch_guard
+    struct deferred_release final
+    {
+        std::shared_ptr<T> content;
+        std::shared_ptr<Container> container;
+    };
+    
     std::shared_ptr<Container> container;
     
+    ///std::shared_ptr applied as unique pointer aimed to use std::weak_ptr
+    std::shared_ptr<T> content_shared_ptr;
+    //std::shared_ptr<std::atomic_uint64_t> content_weak_ptr_count;
+    
     /**
      * Disable unnecessary default constructor
      */
@@ -116,15 +303,15 @@ private:
      * Disable copy constructor
      */
     inline explicit referable_unique(
-            const referable_unique<T, std::shared_timed_mutex> &
+            const referable_unique &
     ) = delete;
     
     /**
      * 禁用拷贝赋值运算符
      * @return lvalue reference of current referable_unique
      */
-    inline referable_unique<T, std::shared_timed_mutex> &operator=(
-            const referable_unique<T, std::shared_timed_mutex> &
+    inline referable_unique &operator=(
+            const referable_unique &
     ) = delete;
     
     /**
@@ -133,17 +320,49 @@ private:
      * Even this declaration removed,const instances are unable to call the non-const version.
      * @return const lvalue reference of current referable_unique
      */
-    inline const referable_unique<T, std::shared_timed_mutex> &operator=(
-            const referable_unique<T, std::shared_timed_mutex> &
+    inline const referable_unique &operator=(
+            const referable_unique &
     ) const = delete;
     
     /**
      * 禁用移动赋值运算符
      * @return const lvalue reference of current referable_unique
      */
-    inline const referable_unique<T, std::shared_timed_mutex> &&operator=(
-            referable_unique<T, std::shared_timed_mutex> &&
+    inline const referable_unique &&operator=(
+            referable_unique &&
     ) const = delete;
+    
+    /**
+     * Register to referable_registry.
+     * Not registered if a live object already has the same id.
+     */
+    inline void enroll()
+    {
+        if (!container->content_id.empty()) referable_registry<T, lock_policy>::instance().insert(*this);
+    }
+    
+    ///Called by constructors creating a Container, once content_shared_ptr is set
+    inline void attach_container()
+    {
+        container->content_address = content_shared_ptr.get();
+        enroll();
+    }
+    
+    ///Deleter of contents constructed with deferred_destruction
+    static inline void retire_content(T *expired_content)
+    {
+        deferred_reclaimer::instance().retire(
+                expired_content, [](void *pointer) { delete static_cast<T *>(pointer); }
+        );
+    }
+    
+    ///Alias container and content_shared_ptr to a fused_block, called by in-place constructors
+    inline void adopt_block(const std::shared_ptr<fused_block> &block)
+    {
+        container = std::shared_ptr<Container>(block, &block->container);
+        content_shared_ptr = std::shared_ptr<T>(block, &block->content);
+        attach_container();
+    }
 
 public:
     /**
@@ -151,13 +370,11 @@ public:
      * @param original_referable_unique 原referable_unique<T>
      */
     inline explicit referable_unique(
-            referable_unique<T, std::shared_timed_mutex> &&original_referable_unique
+            referable_unique &&original_referable_unique
     ) noexcept :
             container(std::move(original_referable_unique.container)),
             content_shared_ptr(
-                    std::move<std::shared_ptr<T>>(
-                            original_referable_unique.content_shared_ptr
-                    )
+                    std::move(original_referable_unique.content_shared_ptr)
             )
     {}
     
@@ -168,15 +385,11 @@ public:
      */
     template<typename original_referable_unique_t>
     inline explicit referable_unique(
-            referable_unique<
-                    original_referable_unique_t, std::shared_timed_mutex
-            > &&original_referable_unique
+            referable_unique<original_referable_unique_t, lock_policy> &&original_referable_unique
     ) noexcept :
             container(std::move(original_referable_unique.container)),
             content_shared_ptr(
-                    std::move<
-                            std::shared_ptr<original_referable_unique_t>
-                    >(original_referable_unique.content_shared_ptr)
+                    std::move(original_referable_unique.content_shared_ptr)
             )
     {}
     
@@ -188,13 +401,15 @@ public:
     template<typename unique_ptr_t>
     inline explicit referable_unique(
             std::unique_ptr<unique_ptr_t> &&unique_ptr,
-            const std::any &id = std::any(), const std::any &label = std::any()
-    ) noexcept :
+            const referable_tag &id = referable_tag(), const referable_tag &label = referable_tag()
+    ) :
             container(std::make_shared<Container>(id, label)),
             content_shared_ptr(
                     std::forward<std::unique_ptr<unique_ptr_t>>(unique_ptr)
             )
-    {}
+    {
+        attach_container();
+    }
     
     /**
      * Commonly used constructor
@@ -204,13 +419,15 @@ public:
     template<typename shared_ptr_t>
     inline explicit referable_unique(
             std::shared_ptr<shared_ptr_t> &&shared_ptr,
-            const std::any &id = std::any(), const std::any &label = std::any()
-    ) noexcept :
+            const referable_tag &id = referable_tag(), const referable_tag &label = referable_tag()
+    ) :
             container(std::make_shared<Container>(id, label)),
             content_shared_ptr(
                     std::forward<std::shared_ptr<shared_ptr_t>>(shared_ptr)
             )
-    {}
+    {
+        attach_container();
+    }
     
     /**
      * Available constructor
@@ -220,11 +437,13 @@ public:
     template<typename raw_pointer_t>
     inline explicit referable_unique(
             raw_pointer_t *&&content_raw_pointer,
-            const std::any &id = std::any(), const std::any &label = std::any()
-    ) noexcept :
+            const referable_tag &id = referable_tag(), const referable_tag &label = referable_tag()
+    ) :
             container(std::make_shared<Container>(id, label)),
             content_shared_ptr(content_raw_pointer)
-    {}
+    {
+        attach_container();
+    }
     
     /**
      * Available constructor
@@ -234,12 +453,140 @@ public:
     template<typename raw_pointer_t>
     inline explicit referable_unique(
             raw_pointer_t *&content_raw_pointer,
-            const std::any &id = std::any(), const std::any &label = std::any()
-    ) noexcept :
+            const referable_tag &id = referable_tag(), const referable_tag &label = referable_tag()
+    ) :
             container(std::make_shared<Container>(id, label)),
             content_shared_ptr(content_raw_pointer)
     {
         content_raw_pointer = nullptr;
+        attach_container();
+    }
+    
+    /**
+     * In-place constructor
+     * Constructs the content from args inside a single allocation
+     * which also holds the Container and the reference counts.
+     * A non-empty id also allocates the node of referable_registry.
+     * @see make_referable_unique
+     * @tparam args_t types of arguments forwarded to the constructor of T
+     * @param id content id
+     * @param label content label
+     * @param args arguments forwarded to the constructor of T
+     */
+    template<typename ...args_t>
+    inline explicit referable_unique(
+            std::in_place_t,
+            const referable_tag &id, const referable_tag &label,
+            args_t &&...args
+    ) :
+            container(), content_shared_ptr()
+    {
+        adopt_block(std::make_shared<fused_block>(id, label, std::forward<args_t>(args)...));
+    }
+    
+    /**
+     * Allocator-aware in-place constructor
+     * Same as the in-place constructor, but the single block is obtained
+     * from allocator through std::allocate_shared instead of the global heap.
+     * The memory of the block is returned to allocator when the content has expired
+     * and the last view and weak_ptr are gone,
+     * so the memory resource behind allocator must outlive all of them.
+     * @see allocate_referable_unique
+     * @tparam allocator_t Allocator of any value type, for example std::pmr::polymorphic_allocator
+     * @tparam args_t types of arguments forwarded to the constructor of T
+     * @param allocator
+     * @param id content id
+     * @param label content label
+     * @param args arguments forwarded to the constructor of T
+     */
+    template<typename allocator_t, typename ...args_t>
+    inline explicit referable_unique(
+            std::allocator_arg_t, const allocator_t &allocator,
+            const referable_tag &id, const referable_tag &label,
+            args_t &&...args
+    ) :
+            container(), content_shared_ptr()
+    {
+        adopt_block(std::allocate_shared<fused_block>(allocator, id, label, std::forward<args_t>(args)...));
+    }
+    
+    /**
+     * In-place constructor with deferred destruction
+     * The destructor of the content runs on the thread of deferred_reclaimer
+     * instead of the thread releasing the owner or the last view,
+     * so the content is allocated apart from its Container.
+     * @see make_deferred_referable_unique
+     * @tparam args_t types of arguments forwarded to the constructor of T
+     * @param id content id
+     * @param label content label
+     * @param args arguments forwarded to the constructor of T
+     */
+    template<typename ...args_t>
+    inline explicit referable_unique(
+            deferred_destruction_t,
+            const referable_tag &id, const referable_tag &label,
+            args_t &&...args
+    ) :
+            container(std::make_shared<Container>(id, label)),
+            content_shared_ptr(new T(std::forward<args_t>(args)...), &retire_content)
+    {
+        attach_container();
+    }
+    
+    /**
+     * External storage constructor
+     * The content is not constructed nor destroyed by referable_unique,
+     * it lives in storage such as a mapped file which keeper keeps alive
+     * until the content has expired and the last view and weak_ptr are gone.
+     * Expiry is still per content, as keeper is stored in the block of the Container.
+     * @see restore_referable_snapshot
+     * @tparam keeper_t type of keeper, for example the std::shared_ptr of the storage
+     * @param id content id
+     * @param label content label
+     * @param content the content in the storage
+     * @param keeper
+     */
+    template<typename keeper_t>
+    inline explicit referable_unique(
+            external_storage_t,
+            const referable_tag &id, const referable_tag &label,
+            T *content, keeper_t &&keeper
+    ) :
+            container(), content_shared_ptr()
+    {
+        auto block = std::make_shared<external_block<std::decay_t<keeper_t>>>(
+                id, label, std::forward<keeper_t>(keeper)
+        );
+        container = std::shared_ptr<Container>(block, &block->container);
+        content_shared_ptr = std::shared_ptr<T>(std::move(block), content);
+        attach_container();
+    }
+    
+    /**
+     * Mark the content retired for handle_cache, which may still keep it alive, and wake its waiters.
+     * References are handed over to epoch_domain once weak_ptr::read has been used,
+     * so that readers which found the content not retired can still copy it.
+     * weak_ptrs report the content as expired from the moment it is retired.
+     */
+    inline ~referable_unique()
+    {
+        if (container)
+        {
+            container->retired.store(true, std::memory_order_seq_cst);
+            container->notifier.wake();
+            /// remove the registration made by enroll
+            if (!container->content_id.empty())
+                referable_registry<T, lock_policy>::instance().erase(container->content_id, container.get());
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                if (container->optimistic_readers.load(std::memory_order_seq_cst))
+                    epoch_domain::instance().retire(
+                            new deferred_release{std::move(content_shared_ptr), std::move(container)},
+                            [](void *pointer) { delete static_cast<deferred_release *>(pointer); },
+                            sizeof(T) + sizeof(Container)
+                    );
+            }
+        }
     }
     
     inline operator bool() const noexcept
@@ -247,10 +594,41 @@ public:
         return (container && content_shared_ptr);
     }
     
+    /**
+     * Tags are set on construction and never modified,
+     * so they are read without content_guard.
+     * @return id of the content
+     */
+    inline const referable_tag &id() const noexcept
+    {
+        return container->content_id;
+    }
+    
+    ///@return label of the content
+    inline const referable_tag &label() const noexcept
+    {
+        return container->content_label;
+    }
+    
+    ///@return number of views released so far, the version compared by weak_ptr::wait_for_change
+    inline std::uint64_t version() const noexcept
+    {
+        return container->version();
+    }
+    
     class const_view final
     {
     private:
-        friend class referable_unique<T, std::shared_timed_mutex>;
+        friend class referable_unique;
+        
+        friend class view_locker;
+
+#if defined(__cpp_impl_coroutine)
+        
+        template<typename, typename, typename, typename, typename> friend
+        class view_awaiter;
+
+#endif
         
         /**
          * These std::shared_ptr members are not empty only when
@@ -262,7 +640,7 @@ public:
         std::shared_ptr<T> content_shared_ptr;
         std::shared_ptr<Container> container_shared_ptr;
         
-        std::shared_lock<std::shared_timed_mutex> content_shared_lock;
+        shared_lock_type content_shared_lock;
         
         ///Disable default constructor
         inline explicit const_view() = delete;
@@ -278,12 +656,12 @@ public:
         inline explicit const_view(
                 std::shared_ptr<T> &&content,
                 std::shared_ptr<Container> &&container,
-                std::shared_lock<std::shared_timed_mutex> &&content_lock
+                shared_lock_type &&content_lock
         ) noexcept :
                 content_shared_ptr(std::forward<std::shared_ptr<T>>(content)),
                 container_shared_ptr(std::forward<std::shared_ptr<Container>>(container)),
                 content_shared_lock(
-                        std::forward<std::shared_lock<std::shared_timed_mutex>>(content_lock)
+                        std::forward<shared_lock_type>(content_lock)
                 )
         {}
     
@@ -305,6 +683,18 @@ public:
             );
         }
         
+        ///@return id of the content
+        inline const referable_tag &id() const noexcept
+        {
+            return container_shared_ptr->content_id;
+        }
+        
+        ///@return label of the content
+        inline const referable_tag &label() const noexcept
+        {
+            return container_shared_ptr->content_label;
+        }
+        
         inline const T &operator*()
         {
             return *content_shared_ptr;
@@ -319,7 +709,16 @@ public:
     class view final
     {
     private:
-        friend class referable_unique<T, std::shared_timed_mutex>;
+        friend class referable_unique;
+        
+        friend class view_locker;
+
+#if defined(__cpp_impl_coroutine)
+        
+        template<typename, typename, typename, typename, typename> friend
+        class view_awaiter;
+
+#endif
         
         /**
          * These std::shared_ptr members are not empty only when
@@ -331,7 +730,7 @@ public:
         std::shared_ptr<T> content_shared_ptr;
         std::shared_ptr<Container> container_shared_ptr;
         
-        std::unique_lock<std::shared_timed_mutex> content_unique_lock;
+        unique_lock_type content_unique_lock;
         
         ///Disable default constructor
         inline explicit view() = delete;
@@ -346,14 +745,16 @@ public:
         ///Constructor used by weak_ptr
         inline explicit view(
                 std::shared_ptr<T> &&content, std::shared_ptr<Container> &&container,
-                std::unique_lock<std::shared_timed_mutex> &&content_lock
+                unique_lock_type &&content_lock
         ) noexcept :
                 content_shared_ptr(std::forward<std::shared_ptr<T>>(content)),
                 container_shared_ptr(std::forward<std::shared_ptr<Container>>(container)),
                 content_unique_lock(
-                        std::forward<std::unique_lock<std::shared_timed_mutex>>(content_lock)
+                        std::forward<unique_lock_type>(content_lock)
                 )
-        {}
+        {
+            container_shared_ptr->begin_write();
+        }
     
     public:
         /// Move constructor
@@ -363,6 +764,22 @@ public:
                 content_unique_lock(std::move(original.content_unique_lock))
         {}
         
+        /**
+         * Run the mutations published meanwhile and publish the modification,
+         * then release content_guard and notify the watchers of the content
+         */
+        inline ~view()
+        {
+            if (container_shared_ptr)
+            {
+                container_shared_ptr->pending_requests.run_pending(*content_shared_ptr);
+                container_shared_ptr->end_write();
+                const bool watched = container_shared_ptr->notifier.watched();
+                content_unique_lock.unlock();
+                container_shared_ptr->notify_change(watched);
+            }
+        }
+        
         ///is this view valid
         inline operator bool() const
         {
@@ -373,6 +790,18 @@ public:
             );
         }
         
+        ///@return id of the content
+        inline const referable_tag &id() const noexcept
+        {
+            return container_shared_ptr->content_id;
+        }
+        
+        ///@return label of the content
+        inline const referable_tag &label() const noexcept
+        {
+            return container_shared_ptr->content_label;
+        }
+        
         inline T &operator*()
         {
             return *content_shared_ptr;
@@ -388,70 +817,408 @@ public:
             *content_shared_ptr = t;
             return *content_shared_ptr;
         }
+        
+        /**
+         * Turn this view into a const_view without releasing content_guard,
+         * readers waiting for this view are admitted at once.
+         * Only for lock policies supporting the upgrade lock. This view becomes invalid.
+         * @return const_view of the content
+         */
+        template<typename guard_t = lock_policy, typename = std::enable_if_t<is_upgradable_lock<guard_t>::value>>
+        inline const_view downgrade()
+        {
+            container_shared_ptr->pending_requests.run_pending(*content_shared_ptr);
+            container_shared_ptr->end_write();
+            const bool watched = container_shared_ptr->notifier.watched();
+            lock_policy *const content_guard = content_unique_lock.release();
+            content_guard->unlock_and_lock_shared();
+            /// subscribers run while the returned const_view is held
+            container_shared_ptr->notify_change(watched);
+            return const_view(
+                    std::move(content_shared_ptr), std::move(container_shared_ptr),
+                    shared_lock_type(*content_guard, std::adopt_lock)
+            );
+        }
     };
     
-    class weak_ptr final
+    /**
+     * Read access which coexists with const_views but excludes views and other upgradable_views,
+     * so that it can be promoted to a view without another writer getting in between.
+     * Only for lock policies supporting the upgrade lock, such as futex_shared_mutex.
+     */
+    class upgradable_view final
     {
     private:
-        std::weak_ptr<T> content_weak_ptr;
-        std::weak_ptr<Container> container_weak_ptr;
+        friend class referable_unique;
         
-        /**
-         * Disable default constructor
-         */
-        inline explicit weak_ptr() = delete;
+        std::shared_ptr<T> content_shared_ptr;
+        std::shared_ptr<Container> container_shared_ptr;
         
-        /**
-         * Disable unnecessary move constructor
-         */
-        inline explicit weak_ptr(weak_ptr &&) = delete;
+        upgrade_lock<lock_policy> content_upgrade_lock;
         
-        /**
-         * 禁用移动赋值运算符
-         * @return lvalue reference of current object
-         */
-        inline weak_ptr &operator=(weak_ptr &&) = delete;
+        ///Disable default constructor
+        inline explicit upgradable_view() = delete;
+        
+        ///Disable copy constructor
+        inline explicit upgradable_view(const upgradable_view &) = delete;
+        
+        inline const upgradable_view &operator=(const upgradable_view &) = delete;
+        
+        inline const upgradable_view &operator=(upgradable_view &&) = delete;
+        
+        ///Constructor used by weak_ptr
+        inline explicit upgradable_view(
+                std::shared_ptr<T> &&content, std::shared_ptr<Container> &&container,
+                upgrade_lock<lock_policy> &&content_lock
+        ) noexcept :
+                content_shared_ptr(std::move(content)),
+                container_shared_ptr(std::move(container)),
+                content_upgrade_lock(std::move(content_lock))
+        {}
     
     public:
-        /**
-         * Commonly used constructor
-         * @tparam referable_unique_t referable_unique content type
-         * @param referable_unique referable_unique<referable_unique_t>
-         */
-        template<typename referable_unique_t>
-        inline explicit weak_ptr(
-                const referable_unique<
-                        referable_unique_t, std::shared_timed_mutex
-                > &referable_unique
-        ) noexcept:
-                content_weak_ptr(referable_unique.content_shared_ptr),
-                container_weak_ptr(referable_unique.container)
+        /// Move constructor
+        inline explicit upgradable_view(upgradable_view &&original) :
+                content_shared_ptr(std::move(original.content_shared_ptr)),
+                container_shared_ptr(std::move(original.container_shared_ptr)),
+                content_upgrade_lock(std::move(original.content_upgrade_lock))
         {}
         
+        ///is this view valid
+        inline operator bool() const
+        {
+            return (
+                    (bool) container_shared_ptr &&
+                    (bool) content_shared_ptr &&
+                    (bool) content_upgrade_lock
+            );
+        }
+        
+        ///@return id of the content
+        inline const referable_tag &id() const noexcept
+        {
+            return container_shared_ptr->content_id;
+        }
+        
+        ///@return label of the content
+        inline const referable_tag &label() const noexcept
+        {
+            return container_shared_ptr->content_label;
+        }
+        
+        inline const T &operator*()
+        {
+            return *content_shared_ptr;
+        }
+        
+        inline const T *operator->()
+        {
+            return content_shared_ptr.get();
+        }
+        
         /**
-         * Copy constructor
-         * @param another 另一weak_ptr
+         * Promote to a view without releasing content_guard,
+         * waiting until the current const_views are destroyed.
+         * New const_views wait for the promotion. This view becomes invalid.
+         * @return view of the content, which has not been modified since this view was created
+         * @throw std::logic_error if this view is invalid, e.g. moved from or already promoted
          */
-        inline explicit weak_ptr(const weak_ptr &another) noexcept :
-                content_weak_ptr(another.content_weak_ptr),
-                container_weak_ptr(another.container_weak_ptr)
-        {}
+        inline view upgrade()
+        {
+            if (!content_upgrade_lock.owns_lock())
+                throw std::logic_error("upgradable_view: upgrade of an invalid view");
+            lock_policy *const content_guard = content_upgrade_lock.release();
+            content_guard->unlock_upgrade_and_lock();
+            return view(
+                    std::move(content_shared_ptr), std::move(container_shared_ptr),
+                    unique_lock_type(*content_guard, std::adopt_lock)
+            );
+        }
         
         /**
-         * Copy constructor
-         * @tparam original_type 原类型
-         * @param another 另一weak_ptr
+         * Promote to a view only if no const_view is left.
+         * This view becomes invalid if it has been promoted.
+         * @return view of the content, or std::nullopt if a const_view is left or this view is invalid
+         */
+        inline std::optional<view> try_upgrade()
+        {
+            if (!content_upgrade_lock.owns_lock()) return std::nullopt;
+            if (!container_shared_ptr->content_guard.try_unlock_upgrade_and_lock()) return std::nullopt;
+            lock_policy *const content_guard = content_upgrade_lock.release();
+            return std::optional<view>(
+                    view(
+                            std::move(content_shared_ptr), std::move(container_shared_ptr),
+                            unique_lock_type(*content_guard, std::adopt_lock)
+                    )
+            );
+        }
+        
+        /**
+         * Turn into a const_view without releasing content_guard,
+         * so that another upgradable_view can be created. This view becomes invalid.
+         * @return const_view of the content
+         * @throw std::logic_error if this view is invalid, e.g. moved from or already promoted
+         */
+        inline const_view downgrade()
+        {
+            if (!content_upgrade_lock.owns_lock())
+                throw std::logic_error("upgradable_view: downgrade of an invalid view");
+            lock_policy *const content_guard = content_upgrade_lock.release();
+            content_guard->unlock_upgrade_and_lock_shared();
+            return const_view(
+                    std::move(content_shared_ptr), std::move(container_shared_ptr),
+                    shared_lock_type(*content_guard, std::adopt_lock)
+            );
+        }
+    };
+    
+    /**
+     * const_view taken by the owner with borrow_const.
+     * It holds a reference to the content instead of a std::shared_ptr,
+     * so it must not outlive the referable_unique which owns the content.
+     */
+    class borrowed_const_view final
+    {
+    private:
+        friend class referable_unique;
+        
+        friend class handle_cache<T, lock_policy>;
+        
+        const T &content;
+        const Container &container;
+        shared_lock_type content_shared_lock;
+        
+        ///Disable default constructor
+        inline explicit borrowed_const_view() = delete;
+        
+        ///Disable copy constructor
+        inline explicit borrowed_const_view(const borrowed_const_view &) = delete;
+        
+        inline const borrowed_const_view &operator=(const borrowed_const_view &) = delete;
+        
+        inline const borrowed_const_view &operator=(borrowed_const_view &&) = delete;
+        
+        ///Constructor used by referable_unique
+        inline explicit borrowed_const_view(
+                const T &borrowed_content, const Container &borrowed_container, shared_lock_type &&content_lock
+        ) noexcept :
+                content(borrowed_content), container(borrowed_container),
+                content_shared_lock(std::move(content_lock))
+        {}
+    
+    public:
+        /// Move constructor
+        inline explicit borrowed_const_view(borrowed_const_view &&original) :
+                content(original.content), container(original.container),
+                content_shared_lock(std::move(original.content_shared_lock))
+        {}
+        
+        ///is this view valid
+        inline operator bool() const
+        {
+            return (bool) content_shared_lock;
+        }
+        
+        ///@return id of the content
+        inline const referable_tag &id() const noexcept
+        {
+            return container.content_id;
+        }
+        
+        ///@return label of the content
+        inline const referable_tag &label() const noexcept
+        {
+            return container.content_label;
+        }
+        
+        inline const T &operator*()
+        {
+            return content;
+        }
+        
+        inline const T *operator->()
+        {
+            return &content;
+        }
+    };
+    
+    /**
+     * view taken by the owner with borrow.
+     * It holds a reference to the content instead of a std::shared_ptr,
+     * so it must not outlive the referable_unique which owns the content.
+     */
+    class borrowed_view final
+    {
+    private:
+        friend class referable_unique;
+        
+        friend class handle_cache<T, lock_policy>;
+        
+        T &content;
+        Container &container;
+        unique_lock_type content_unique_lock;
+        
+        ///Disable default constructor
+        inline explicit borrowed_view() = delete;
+        
+        ///Disable copy constructor
+        inline explicit borrowed_view(const borrowed_view &) = delete;
+        
+        inline const borrowed_view &operator=(const borrowed_view &) = delete;
+        
+        inline const borrowed_view &operator=(borrowed_view &&) = delete;
+        
+        ///Constructor used by referable_unique
+        inline explicit borrowed_view(
+                T &borrowed_content, Container &borrowed_container, unique_lock_type &&content_lock
+        ) noexcept :
+                content(borrowed_content), container(borrowed_container),
+                content_unique_lock(std::move(content_lock))
+        {
+            container.begin_write();
+        }
+    
+    public:
+        /// Move constructor
+        inline explicit borrowed_view(borrowed_view &&original) :
+                content(original.content), container(original.container),
+                content_unique_lock(std::move(original.content_unique_lock))
+        {}
+        
+        /**
+         * Run the mutations published meanwhile and publish the modification,
+         * then release content_guard and notify the watchers of the content
+         */
+        inline ~borrowed_view()
+        {
+            if (content_unique_lock)
+            {
+                container.pending_requests.run_pending(content);
+                container.end_write();
+                const bool watched = container.notifier.watched();
+                content_unique_lock.unlock();
+                container.notify_change(watched);
+            }
+        }
+        
+        ///is this view valid
+        inline operator bool() const
+        {
+            return (bool) content_unique_lock;
+        }
+        
+        ///@return id of the content
+        inline const referable_tag &id() const noexcept
+        {
+            return container.content_id;
+        }
+        
+        ///@return label of the content
+        inline const referable_tag &label() const noexcept
+        {
+            return container.content_label;
+        }
+        
+        inline T &operator*()
+        {
+            return content;
+        }
+        
+        inline T *operator->()
+        {
+            return &content;
+        }
+        
+        inline T &operator=(const T &t)
+        {
+            content = t;
+            return content;
+        }
+    };
+    
+    class weak_ptr final
+    {
+    private:
+        friend class view_locker;
+        
+        friend class handle_cache<T, lock_policy>;
+        
+        std::weak_ptr<T> content_weak_ptr;
+        std::weak_ptr<Container> container_weak_ptr;
+        /**
+         * Key of handle_cache. Also dereferenced by read inside an epoch_guard
+         * while the content is not retired, which locks neither std::weak_ptr.
+         */
+        const Container *container_raw_ptr;
+        
+        /**
+         * Disable default constructor
+         */
+        inline explicit weak_ptr() = delete;
+        
+        /**
+         * Disable unnecessary move constructor
+         */
+        inline explicit weak_ptr(weak_ptr &&) = delete;
+        
+        /**
+         * 禁用移动赋值运算符
+         * @return lvalue reference of current object
+         */
+        inline weak_ptr &operator=(weak_ptr &&) = delete;
+    
+    public:
+        /**
+         * Commonly used constructor
+         * @tparam referable_unique_t referable_unique content type
+         * @param referable_unique referable_unique<referable_unique_t>
+         */
+        template<typename referable_unique_t>
+        inline explicit weak_ptr(
+                const referable_unique<referable_unique_t, lock_policy> &referable_unique
+        ) noexcept:
+                content_weak_ptr(referable_unique.content_shared_ptr),
+                container_weak_ptr(referable_unique.container),
+                container_raw_ptr(referable_unique.container.get())
+        {}
+        
+        /**
+         * Copy constructor
+         * @param another 另一weak_ptr
+         */
+        inline explicit weak_ptr(const weak_ptr &another) noexcept :
+                content_weak_ptr(another.content_weak_ptr),
+                container_weak_ptr(another.container_weak_ptr),
+                container_raw_ptr(another.container_raw_ptr)
+        {}
+        
+        /**
+         * Copy constructor
+         * @tparam original_type 原类型
+         * @param another 另一weak_ptr
          */
         template<typename original_type>
         inline explicit weak_ptr(
-                const typename referable_unique<
-                        original_type, std::shared_timed_mutex
-                >::weak_ptr &another
+                const typename referable_unique<original_type, lock_policy>::weak_ptr &another
         ) noexcept :
                 content_weak_ptr(another.content_weak_ptr),
-                container_weak_ptr(another.container_weak_ptr)
+                container_weak_ptr(another.container_weak_ptr),
+                container_raw_ptr(another.container_raw_ptr)
         {}
         
+        /**
+         * 拷贝赋值运算符
+         * @param another 另一weak_ptr
+         * @return 当前weak_ptr的左值引用
+         */
+        inline weak_ptr &operator=(const weak_ptr &another) noexcept
+        {
+            this->content_weak_ptr = another.content_weak_ptr;
+            this->container_weak_ptr = another.container_weak_ptr;
+            this->container_raw_ptr = another.container_raw_ptr;
+            return *this;
+        }
+        
         /**
          * 拷贝赋值运算符
          * @tparam original_type 原类型
@@ -460,13 +1227,12 @@ public:
          */
         template<typename original_type>
         inline weak_ptr &operator=(
-                const typename referable_unique<
-                        original_type, std::shared_timed_mutex
-                >::weak_ptr &another
+                const typename referable_unique<original_type, lock_policy>::weak_ptr &another
         ) noexcept
         {
             this->content_weak_ptr = another.content_weak_ptr;
             this->container_weak_ptr = another.container_weak_ptr;
+            this->container_raw_ptr = another.container_raw_ptr;
             return *this;
         }
         
@@ -479,12 +1245,172 @@ public:
          */
         template<typename original_type>
         inline const weak_ptr &operator=(
-                const typename referable_unique<original_type, std::shared_timed_mutex>::weak_ptr &
+                const typename referable_unique<original_type, lock_policy>::weak_ptr &
         ) const noexcept = delete;
         
+        ///@return false once the owner has been destroyed, even while its release is deferred for read
         inline operator bool() noexcept
         {
-            return !(content_weak_ptr.expired() || container_weak_ptr.expired());
+            if (content_weak_ptr.expired()) return false;
+            auto container_shared_pointer = container_weak_ptr.lock();
+            return container_shared_pointer && !container_shared_pointer->retired.load(std::memory_order_acquire);
+        }
+        
+        /**
+         * @return id of the content, or std::nullopt when the content has expired
+         */
+        inline std::optional<referable_tag> id() const noexcept
+        {
+            if (auto container_shared_pointer = container_weak_ptr.lock();
+                    container_shared_pointer && !container_shared_pointer->retired.load(std::memory_order_acquire))
+                return container_shared_pointer->content_id;
+            return std::nullopt;
+        }
+        
+        /**
+         * @return label of the content, or std::nullopt when the content has expired
+         */
+        inline std::optional<referable_tag> label() const noexcept
+        {
+            if (auto container_shared_pointer = container_weak_ptr.lock();
+                    container_shared_pointer && !container_shared_pointer->retired.load(std::memory_order_acquire))
+                return container_shared_pointer->content_label;
+            return std::nullopt;
+        }
+        
+        /**
+         * @return number of views released so far, or std::nullopt when the content has expired
+         */
+        inline std::optional<std::uint64_t> version() const noexcept
+        {
+            if (auto container_shared_pointer = container_weak_ptr.lock();
+                    container_shared_pointer && !container_shared_pointer->retired.load(std::memory_order_acquire))
+                return container_shared_pointer->version();
+            return std::nullopt;
+        }
+        
+        /**
+         * Block without polling until a view of the content is released after last_version,
+         * or until the owner is destroyed.
+         * Registers as a watcher while holding content_guard shared, which waits for a view held meanwhile,
+         * so must not be called by a thread holding a view of the same content.
+         * @param last_version version seen by the caller
+         * @return change_status::changed with the new version, or change_status::expired
+         */
+        inline change_result wait_for_change(std::uint64_t last_version) const
+        {
+            return wait_change(last_version, std::nullopt);
+        }
+        
+        /**
+         * Timed version of wait_for_change
+         * @return change_status::changed with the new version, change_status::timed_out or change_status::expired
+         */
+        template<class Rep, class Period>
+        inline change_result wait_for_change(
+                std::uint64_t last_version, const std::chrono::duration<Rep, Period> &timeout_duration
+        ) const
+        {
+            return wait_change(
+                    last_version,
+                    std::chrono::steady_clock::now() +
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout_duration)
+            );
+        }
+        
+        /**
+         * Call callback with the new version whenever a view of the content is released.
+         * It runs on the releasing thread after content_guard has been released,
+         * or while the const_view returned by view::downgrade is held.
+         * Views released while subscribe is running may not be notified.
+         * Callbacks must not modify the same content, but may subscribe to or unsubscribe from it.
+         * Exceptions thrown by callbacks are caught and dropped.
+         * @tparam function_t callable with std::uint64_t
+         * @param callback
+         * @return subscription which unsubscribes on destruction, empty if the content has expired
+         */
+        template<typename function_t>
+        inline subscription subscribe(function_t &&callback) const
+        {
+            std::shared_ptr<Container> container_shared_pointer(lock_container());
+            if (!container_shared_pointer) return subscription();
+            const std::uint64_t id = container_shared_pointer->notifier.subscribe(
+                    std::function<void(std::uint64_t)>(std::forward<function_t>(callback))
+            );
+            return subscription(
+                    std::shared_ptr<change_notifier>(container_shared_pointer, &container_shared_pointer->notifier), id
+            );
+        }
+        
+        /**
+         * Optimistic read without content_guard, only for trivially copyable T.
+         * function receives a consistent copy of the content,
+         * readers retry when a view modified the content during the copy.
+         * The content is pinned by an epoch_guard instead of a reference count,
+         * so apart from the first read of a content, readers write nothing to shared memory.
+         * Must not be called by a thread holding a view of the same content.
+         * @tparam function_t callable with const T &
+         * @param function callable invoked once with a copy of the content
+         * @return std::optional of the result of function,
+         * or bool when function returns void. Empty or false once the owner has been destroyed.
+         */
+        template<typename function_t>
+        inline read_result_t<function_t> read(function_t &&function) const
+        {
+            epoch_guard content_epoch_guard;
+            /// the weak reference keeps the storage of the Container, so its flags can be read once expired
+            if (this->container_weak_ptr.expired()) return read_result_t<function_t>();
+            if (!container_raw_ptr->optimistic_readers.load(std::memory_order_relaxed))
+                container_raw_ptr->optimistic_readers.store(true, std::memory_order_seq_cst);
+            /// not retired after publishing optimistic_readers: the owner releases through epoch_domain
+            if (container_raw_ptr->retired.load(std::memory_order_seq_cst)) return read_result_t<function_t>();
+            const T &content = *container_raw_ptr->content_address;
+            if constexpr (std::is_void_v<std::invoke_result_t<function_t, const T &>>)
+            {
+                read_snapshot(*container_raw_ptr, content, std::forward<function_t>(function));
+                return true;
+            }
+            else
+                return read_result_t<function_t>(
+                        read_snapshot(*container_raw_ptr, content, std::forward<function_t>(function))
+                );
+        }
+        
+        /**
+         * Flat-combining write. function is published to the content and run with content_guard locked
+         * exclusively, either by the thread holding it or by this thread when it is free,
+         * so concurrent writers share one critical section instead of handing the lock over.
+         * Must not be called by a thread holding a view or a const_view of the same content.
+         * @tparam function_t callable with T &
+         * @param function callable invoked once with the content, possibly on another thread
+         * @return std::optional of the result of function, a copy of the referred object when it returns a reference,
+         * or bool when function returns void. Empty or false if the content has expired.
+         * @throw the exception thrown by function
+         */
+        template<typename function_t>
+        inline apply_result_t<function_t> apply(function_t &&function) const
+        {
+            apply_request<T, std::remove_reference_t<function_t>> request(function);
+            if (!submit(request)) return apply_result_t<function_t>();
+            if constexpr (std::is_void_v<std::invoke_result_t<function_t, T &>>) return true;
+            else return apply_result_t<function_t>(std::move(*request.result));
+        }
+        
+        /**
+         * Flat-combining write of several functions, published together and run in order
+         * within the same critical section. A throwing function stops the batch.
+         * Must not be called by a thread holding a view or a const_view of the same content.
+         * @tparam iterator_t input iterator of callables with T &
+         * @param first
+         * @param last
+         * @return false if the content has expired
+         * @throw the exception thrown by a function
+         */
+        template<typename iterator_t>
+        inline bool apply_batch(iterator_t first, iterator_t last) const
+        {
+            apply_batch_request<T, iterator_t> request(first, last);
+            return submit(request);
         }
         
         inline std::optional<const_view> get_const_view()
@@ -494,12 +1420,14 @@ public:
             /// in constructor of these shared pointers
             /// exception std::bad_weak_ptr will be thrown
             /// when content has expired or container has expired
+            /// or as if they had expired once the owner has been destroyed
+            if (container_shared_ptr->retired.load(std::memory_order_acquire)) throw std::bad_weak_ptr();
             return std::optional<const_view>(
                     const_view(
                             std::move(content_shared_pointer),
                             std::move(container_shared_ptr),
-                            std::move<std::shared_lock<std::shared_timed_mutex>>(
-                                    std::shared_lock<std::shared_timed_mutex>(
+                            std::move<shared_lock_type>(
+                                    shared_lock_type(
                                             container_shared_ptr->content_guard
                                     )
                             )
@@ -517,7 +1445,9 @@ public:
             /// in constructor of these shared pointers
             /// exception std::bad_weak_ptr will be thrown
             /// when content has expired or container has expired
-            if (std::shared_lock<std::shared_timed_mutex> content_guard_lock(
+            /// or as if they had expired once the owner has been destroyed
+            if (container_shared_ptr->retired.load(std::memory_order_acquire)) throw std::bad_weak_ptr();
+            if (shared_lock_type content_guard_lock(
                         container_shared_ptr->content_guard, timeout_duration
                 );content_guard_lock)
             {
@@ -532,80 +1462,415 @@ public:
             else return std::optional<const_view>();
         }
         
-        inline std::optional<view> get_view()
+        inline std::optional<view> get_view()
+        {
+            std::shared_ptr<T> content_shared_pointer(this->content_weak_ptr);
+            std::shared_ptr<Container> container_shared_ptr(this->container_weak_ptr);
+            /// in constructor of these shared pointers
+            /// exception std::bad_weak_ptr will be thrown
+            /// when content has expired or container has expired
+            /// or as if they had expired once the owner has been destroyed
+            if (container_shared_ptr->retired.load(std::memory_order_acquire)) throw std::bad_weak_ptr();
+            return std::optional<view>(
+                    view(
+                            std::move(content_shared_pointer),
+                            std::move(container_shared_ptr),
+                            std::move<unique_lock_type>(
+                                    unique_lock_type(
+                                            container_shared_ptr->content_guard
+                                    )
+                            )
+                    )
+            );
+        }
+        
+        template<class Rep, class Period>
+        inline std::optional<view> get_view(
+                const std::chrono::duration<Rep, Period> &timeout_duration
+        )
+        {
+            std::shared_ptr<T> content_shared_pointer(this->content_weak_ptr);
+            std::shared_ptr<Container> container_shared_ptr(this->container_weak_ptr);
+            /// in constructor of these shared pointers
+            /// exception std::bad_weak_ptr will be thrown
+            /// when content has expired or container has expired
+            /// or as if they had expired once the owner has been destroyed
+            if (container_shared_ptr->retired.load(std::memory_order_acquire)) throw std::bad_weak_ptr();
+            if (unique_lock_type content_guard_lock(
+                        container_shared_ptr->content_guard, timeout_duration
+                );content_guard_lock)
+            {
+                return std::optional<view>(
+                        view(
+                                std::move(content_shared_pointer),
+                                std::move(container_shared_ptr),
+                                std::move(content_guard_lock)
+                        )
+                );
+            }
+            else return std::optional<view>();
+        }
+
+#if defined(__cpp_impl_coroutine)
+        
+        /**
+         * co_await async_const_view(executor) suspends the coroutine while the content is locked exclusively
+         * instead of blocking the thread. The coroutine is resumed through executor
+         * when the guard has been acquired, which requires lock_policy awaitable_mutex.
+         * @tparam executor_t callable with a nullary function, which it must invoke later on any thread
+         * @param executor
+         * @return awaitable yielding access_result<const_view>,
+         * whose status is access_status::acquired or access_status::expired
+         */
+        template<
+                typename executor_t, typename guard_t = lock_policy,
+                typename = std::enable_if_t<is_awaitable_lock<guard_t>::value>
+        >
+        inline view_awaiter<const_view, shared_lock_type, T, Container, executor_t>
+        async_const_view(executor_t executor) const
+        {
+            return view_awaiter<const_view, shared_lock_type, T, Container, executor_t>(
+                    this->content_weak_ptr.lock(), lock_container(),
+                    std::move(executor), true, std::nullopt
+            );
+        }
+        
+        /**
+         * Timed version of async_const_view
+         * @return awaitable yielding access_result<const_view>,
+         * whose status is access_status::acquired, access_status::expired or access_status::timed_out
+         */
+        template<
+                typename executor_t, class Rep, class Period, typename guard_t = lock_policy,
+                typename = std::enable_if_t<is_awaitable_lock<guard_t>::value>
+        >
+        inline view_awaiter<const_view, shared_lock_type, T, Container, executor_t> async_const_view(
+                executor_t executor, const std::chrono::duration<Rep, Period> &timeout_duration
+        ) const
+        {
+            return view_awaiter<const_view, shared_lock_type, T, Container, executor_t>(
+                    this->content_weak_ptr.lock(), lock_container(),
+                    std::move(executor), true,
+                    std::chrono::steady_clock::now() +
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout_duration)
+            );
+        }
+        
+        /**
+         * co_await async_view(executor) suspends the coroutine while the content is locked
+         * instead of blocking the thread. The coroutine is resumed through executor
+         * when the guard has been acquired, which requires lock_policy awaitable_mutex.
+         * @tparam executor_t callable with a nullary function, which it must invoke later on any thread
+         * @param executor
+         * @return awaitable yielding access_result<view>,
+         * whose status is access_status::acquired or access_status::expired
+         */
+        template<
+                typename executor_t, typename guard_t = lock_policy,
+                typename = std::enable_if_t<is_awaitable_lock<guard_t>::value>
+        >
+        inline view_awaiter<view, unique_lock_type, T, Container, executor_t>
+        async_view(executor_t executor) const
+        {
+            return view_awaiter<view, unique_lock_type, T, Container, executor_t>(
+                    this->content_weak_ptr.lock(), lock_container(),
+                    std::move(executor), false, std::nullopt
+            );
+        }
+        
+        /**
+         * Timed version of async_view
+         * @return awaitable yielding access_result<view>,
+         * whose status is access_status::acquired, access_status::expired or access_status::timed_out
+         */
+        template<
+                typename executor_t, class Rep, class Period, typename guard_t = lock_policy,
+                typename = std::enable_if_t<is_awaitable_lock<guard_t>::value>
+        >
+        inline view_awaiter<view, unique_lock_type, T, Container, executor_t> async_view(
+                executor_t executor, const std::chrono::duration<Rep, Period> &timeout_duration
+        ) const
+        {
+            return view_awaiter<view, unique_lock_type, T, Container, executor_t>(
+                    this->content_weak_ptr.lock(), lock_container(),
+                    std::move(executor), false,
+                    std::chrono::steady_clock::now() +
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout_duration)
+            );
+        }
+
+#endif
+        
+        /**
+         * Blocking version of get_const_view which reports expiry instead of throwing
+         * @return access_status::acquired or access_status::expired
+         */
+        inline access_result<const_view> try_get_const_view() const
+        {
+            return try_acquire<const_view, shared_lock_type>(access_status::acquired);
+        }
+        
+        /**
+         * Timed version of get_const_view which reports expiry instead of throwing
+         * @return access_status::acquired, access_status::expired or access_status::timed_out
+         */
+        template<class Rep, class Period>
+        inline access_result<const_view> try_get_const_view(
+                const std::chrono::duration<Rep, Period> &timeout_duration
+        ) const
+        {
+            return try_acquire<const_view, shared_lock_type>(access_status::timed_out, timeout_duration);
+        }
+        
+        /**
+         * Create a const_view only if the content can be locked without waiting
+         * @return access_status::acquired, access_status::expired or access_status::contended
+         */
+        inline access_result<const_view> try_lock_const_view() const
+        {
+            return try_acquire<const_view, shared_lock_type>(access_status::contended, std::try_to_lock);
+        }
+        
+        /**
+         * Blocking version of get_view which reports expiry instead of throwing
+         * @return access_status::acquired or access_status::expired
+         */
+        inline access_result<view> try_get_view() const
+        {
+            return try_acquire<view, unique_lock_type>(access_status::acquired);
+        }
+        
+        /**
+         * Timed version of get_view which reports expiry instead of throwing
+         * @return access_status::acquired, access_status::expired or access_status::timed_out
+         */
+        template<class Rep, class Period>
+        inline access_result<view> try_get_view(
+                const std::chrono::duration<Rep, Period> &timeout_duration
+        ) const
+        {
+            return try_acquire<view, unique_lock_type>(access_status::timed_out, timeout_duration);
+        }
+        
+        /**
+         * Create a view only if the content can be locked without waiting
+         * @return access_status::acquired, access_status::expired or access_status::contended
+         */
+        inline access_result<view> try_lock_view() const
+        {
+            return try_acquire<view, unique_lock_type>(access_status::contended, std::try_to_lock);
+        }
+        
+        /**
+         * Only for lock policies supporting the upgrade lock, such as futex_shared_mutex.
+         * Waits while a view or another upgradable_view exists.
+         * @return std::optional<upgradable_view>
+         * @throw std::bad_weak_ptr when the content has expired
+         */
+        template<typename guard_t = lock_policy, typename = std::enable_if_t<is_upgradable_lock<guard_t>::value>>
+        inline std::optional<upgradable_view> get_upgradable_view()
         {
             std::shared_ptr<T> content_shared_pointer(this->content_weak_ptr);
             std::shared_ptr<Container> container_shared_ptr(this->container_weak_ptr);
             /// in constructor of these shared pointers
             /// exception std::bad_weak_ptr will be thrown
             /// when content has expired or container has expired
-            return std::optional<view>(
-                    view(
+            /// or as if they had expired once the owner has been destroyed
+            if (container_shared_ptr->retired.load(std::memory_order_acquire)) throw std::bad_weak_ptr();
+            upgrade_lock<lock_policy> content_guard_lock(container_shared_ptr->content_guard);
+            return std::optional<upgradable_view>(
+                    upgradable_view(
                             std::move(content_shared_pointer),
                             std::move(container_shared_ptr),
-                            std::move<std::unique_lock<std::shared_timed_mutex>>(
-                                    std::unique_lock<std::shared_timed_mutex>(
-                                            container_shared_ptr->content_guard
-                                    )
-                            )
+                            std::move(content_guard_lock)
                     )
             );
         }
         
-        template<class Rep, class Period>
-        inline std::optional<view> get_view(
-                const std::chrono::duration<Rep, Period> &timeout_duration
-        )
+        /**
+         * Blocking version of get_upgradable_view which reports expiry instead of throwing
+         * @return access_status::acquired or access_status::expired
+         */
+        template<typename guard_t = lock_policy, typename = std::enable_if_t<is_upgradable_lock<guard_t>::value>>
+        inline access_result<upgradable_view> try_get_upgradable_view() const
         {
-            std::shared_ptr<T> content_shared_pointer(this->content_weak_ptr);
-            std::shared_ptr<Container> container_shared_ptr(this->container_weak_ptr);
-            /// in constructor of these shared pointers
-            /// exception std::bad_weak_ptr will be thrown
-            /// when content has expired or container has expired
-            if (std::unique_lock<std::shared_timed_mutex> content_guard_lock(
-                        container_shared_ptr->content_guard, timeout_duration
-                );content_guard_lock)
+            return try_acquire<upgradable_view, upgrade_lock<lock_policy>>(access_status::acquired);
+        }
+        
+        /**
+         * Create an upgradable_view only if the content can be locked without waiting
+         * @return access_status::acquired, access_status::expired or access_status::contended
+         */
+        template<typename guard_t = lock_policy, typename = std::enable_if_t<is_upgradable_lock<guard_t>::value>>
+        inline access_result<upgradable_view> try_lock_upgradable_view() const
+        {
+            return try_acquire<upgradable_view, upgrade_lock<lock_policy>>(
+                    access_status::contended, std::try_to_lock
+            );
+        }
+    
+    private:
+        /**
+         * Lock the Container, which stays reachable while the release of a destroyed owner
+         * is deferred for read, so an empty pointer is returned once the owner has been destroyed
+         */
+        inline std::shared_ptr<Container> lock_container() const noexcept
+        {
+            std::shared_ptr<Container> container_shared_pointer(this->container_weak_ptr.lock());
+            if (container_shared_pointer && container_shared_pointer->retired.load(std::memory_order_acquire))
+                return nullptr;
+            return container_shared_pointer;
+        }
+        
+        /**
+         * Wait on the futex word of the notifier while the version is last_version
+         * @param deadline time to give up waiting, std::nullopt to wait without limit
+         */
+        inline change_result wait_change(
+                std::uint64_t last_version, const std::optional<std::chrono::steady_clock::time_point> &deadline
+        ) const
+        {
+            /// pins the Container but not the content, so the owner can still be destroyed meanwhile
+            std::shared_ptr<Container> container_shared_pointer(lock_container());
+            if (!container_shared_pointer) return change_result(change_status::expired, last_version);
+            change_notifier &notifier = container_shared_pointer->notifier;
             {
-                return std::optional<view>(
-                        view(
-                                std::move(content_shared_pointer),
-                                std::move(container_shared_ptr),
-                                std::move(content_guard_lock)
-                        )
-                );
+                /// views only notify while they see a watcher, see change_notifier::watched
+                shared_lock_type registration_lock(container_shared_pointer->content_guard);
+                notifier.add_watcher();
             }
-            else return std::optional<const_view>();
+            struct watcher_registration final
+            {
+                change_notifier &notifier;
+                
+                inline ~watcher_registration()
+                {
+                    notifier.remove_watcher();
+                }
+            } registration{notifier};
+            for (;;)
+            {
+                const std::uint32_t observed = notifier.observe();
+                if (container_shared_pointer->retired.load(std::memory_order_acquire) || content_weak_ptr.expired())
+                    return change_result(change_status::expired, last_version);
+                if (const std::uint64_t version = container_shared_pointer->version(); version != last_version)
+                    return change_result(change_status::changed, version);
+                std::optional<std::chrono::nanoseconds> timeout_duration;
+                if (deadline)
+                {
+                    timeout_duration = *deadline - std::chrono::steady_clock::now();
+                    if (timeout_duration->count() <= 0) return change_result(change_status::timed_out, last_version);
+                }
+                notifier.wait(observed, timeout_duration);
+            }
+        }
+        
+        /**
+         * Publish request and wait until it has been run
+         * @return false if the content has expired
+         */
+        inline bool submit(combining_request<T> &request) const
+        {
+            std::shared_ptr<T> content_shared_pointer(this->content_weak_ptr.lock());
+            std::shared_ptr<Container> container_shared_pointer(lock_container());
+            if (!content_shared_pointer || !container_shared_pointer) return false;
+            container_shared_pointer->pending_requests.publish(request);
+            bool combined = false, watched = false;
+            combining_queue<T>::template combine_or_wait<unique_lock_type>(
+                    request, container_shared_pointer->content_guard,
+                    [&]()
+                    {
+                        container_shared_pointer->begin_write();
+                        container_shared_pointer->pending_requests.run_pending(*content_shared_pointer);
+                        container_shared_pointer->end_write();
+                        combined = true;
+                        watched = watched || container_shared_pointer->notifier.watched();
+                    }
+            );
+            if (combined) container_shared_pointer->notify_change(watched);
+            request.rethrow_failure();
+            return true;
+        }
+        
+        /**
+         * Pin the content with std::weak_ptr::lock, which never throws, and lock it
+         * @tparam view_type view, const_view or upgradable_view
+         * @tparam lock_type guard type held by view_type
+         * @tparam lock_args_t types of the arguments following the mutex in the constructor of lock_type
+         * @param failure status returned when the lock is not owned after construction
+         * @param lock_args std::try_to_lock, a timeout duration or nothing
+         */
+        template<typename view_type, typename lock_type, typename ...lock_args_t>
+        inline access_result<view_type> try_acquire(access_status failure, lock_args_t &&...lock_args) const
+        {
+            std::shared_ptr<T> content_shared_pointer(this->content_weak_ptr.lock());
+            std::shared_ptr<Container> container_shared_pointer(lock_container());
+            if (!content_shared_pointer || !container_shared_pointer)
+                return access_result<view_type>(access_status::expired);
+            lock_type content_guard_lock(
+                    container_shared_pointer->content_guard, std::forward<lock_args_t>(lock_args)...
+            );
+            if (!content_guard_lock) return access_result<view_type>(failure);
+            return access_result<view_type>(
+                    view_type(
+                            std::move(content_shared_pointer),
+                            std::move(container_shared_pointer),
+                            std::move(content_guard_lock)
+                    )
+            );
         }
     };
     
+    /**
+     * The view shares the content with this referable_unique, which keeps owning it
+     * @see borrow for a view without reference counting
+     */
     inline std::optional<view> operator*() noexcept
     {
-        /// in constructor of these shared pointers
-        /// exception std::bad_weak_ptr will be thrown
-        /// when content has expired or container has expired
-        return std::make_optional<view>(
-                std::move(content_shared_ptr),
-                std::move(container),
-                std::unique_lock<std::shared_timed_mutex>(
-                        container->content_guard
+        return std::optional<view>(
+                view(
+                        std::shared_ptr<T>(content_shared_ptr),
+                        std::shared_ptr<Container>(container),
+                        unique_lock_type(container->content_guard)
                 )
         );
     }
     
+    /**
+     * The const_view shares the content with this referable_unique, which keeps owning it
+     * @see borrow_const for a const_view without reference counting
+     */
     inline std::optional<const_view> operator*() const noexcept
     {
-        /// in constructor of these shared pointers
-        /// exception std::bad_weak_ptr will be thrown
-        /// when content has expired or container has expired
-        return std::make_optional<const_view>(
-                std::move(content_shared_ptr),
-                std::move(container),
-                std::shared_lock<std::shared_timed_mutex>(
-                        container->content_guard
+        return std::optional<const_view>(
+                const_view(
+                        std::shared_ptr<T>(content_shared_ptr),
+                        std::shared_ptr<Container>(container),
+                        shared_lock_type(container->content_guard)
                 )
         );
     }
     
+    /**
+     * Lock the content exclusively without touching a reference count.
+     * The owner keeps the content alive, so the view must not outlive it.
+     * @return borrowed_view
+     */
+    inline borrowed_view borrow()
+    {
+        return borrowed_view(*content_shared_ptr, *container, unique_lock_type(container->content_guard));
+    }
+    
+    /**
+     * Lock the content shared without touching a reference count.
+     * The owner keeps the content alive, so the view must not outlive it.
+     * @return borrowed_const_view
+     */
+    inline borrowed_const_view borrow_const() const
+    {
+        return borrowed_const_view(*content_shared_ptr, *container, shared_lock_type(container->content_guard));
+    }
+    
     inline T *operator->() noexcept
     {
         return this->content_shared_ptr.get();
@@ -615,15 +1880,131 @@ public:
     {
         return this->content_shared_ptr.get();
     }
+    
+    /**
+     * Optimistic read without content_guard, only for trivially copyable T.
+     * The owner keeps the content alive, so no reference count is touched.
+     * @see weak_ptr::read
+     * @tparam function_t callable with const T &
+     * @param function callable invoked once with a consistent copy of the content
+     * @return the result of function
+     */
+    template<typename function_t>
+    inline decltype(auto) read(function_t &&function) const
+    {
+        return read_snapshot(*container, *content_shared_ptr, std::forward<function_t>(function));
+    }
 };
 
+/**
+ * Constructs a referable_unique<T> with a single allocation
+ * holding the content, its Container and the reference counts.
+ * @tparam T non-const content type
+ * @tparam lock_policy type of Container::content_guard
+ * @tparam args_t types of arguments forwarded to the constructor of T
+ * @param args arguments forwarded to the constructor of T
+ * @return referable_unique<T, lock_policy>
+ */
+template<typename T, typename lock_policy = VARIABLE_UTIL_DEFAULT_LOCK_POLICY, typename ...args_t>
+inline referable_unique<T, lock_policy> make_referable_unique(args_t &&...args)
+{
+    return referable_unique<T, lock_policy>(
+            std::in_place, referable_tag(), referable_tag(), std::forward<args_t>(args)...
+    );
+}
+
+/**
+ * Tagged version of make_referable_unique.
+ * A non-empty id also allocates the node of referable_registry, so it costs two allocations.
+ * @tparam T non-const content type
+ * @tparam lock_policy type of Container::content_guard
+ * @tparam args_t types of arguments forwarded to the constructor of T
+ * @param id content id
+ * @param label content label
+ * @param args arguments forwarded to the constructor of T
+ * @return referable_unique<T, lock_policy>
+ */
+template<typename T, typename lock_policy = VARIABLE_UTIL_DEFAULT_LOCK_POLICY, typename ...args_t>
+inline referable_unique<T, lock_policy> make_tagged_referable_unique(
+        const referable_tag &id, const referable_tag &label, args_t &&...args
+)
+{
+    return referable_unique<T, lock_policy>(
+            std::in_place, id, label, std::forward<args_t>(args)...
+    );
+}
+
+/**
+ * Constructs a referable_unique<T> in a single block obtained from allocator,
+ * so that short-lived objects can be kept out of the global heap,
+ * for example in a std::pmr::synchronized_pool_resource
+ * or in a std::pmr::monotonic_buffer_resource released once per generation.
+ * @tparam T non-const content type
+ * @tparam lock_policy type of Container::content_guard
+ * @tparam allocator_t Allocator of any value type
+ * @tparam args_t types of arguments forwarded to the constructor of T
+ * @param allocator
+ * @param args arguments forwarded to the constructor of T
+ * @return referable_unique<T, lock_policy>
+ */
+template<typename T, typename lock_policy = VARIABLE_UTIL_DEFAULT_LOCK_POLICY, typename allocator_t, typename ...args_t>
+inline referable_unique<T, lock_policy> allocate_referable_unique(const allocator_t &allocator, args_t &&...args)
+{
+    return referable_unique<T, lock_policy>(
+            std::allocator_arg, allocator, referable_tag(), referable_tag(), std::forward<args_t>(args)...
+    );
+}
+
+/**
+ * Tagged version of allocate_referable_unique
+ * @tparam T non-const content type
+ * @tparam lock_policy type of Container::content_guard
+ * @tparam allocator_t Allocator of any value type
+ * @tparam args_t types of arguments forwarded to the constructor of T
+ * @param allocator
+ * @param id content id
+ * @param label content label
+ * @param args arguments forwarded to the constructor of T
+ * @return referable_unique<T, lock_policy>
+ */
+template<typename T, typename lock_policy = VARIABLE_UTIL_DEFAULT_LOCK_POLICY, typename allocator_t, typename ...args_t>
+inline referable_unique<T, lock_policy> allocate_tagged_referable_unique(
+        const allocator_t &allocator, const referable_tag &id, const referable_tag &label, args_t &&...args
+)
+{
+    return referable_unique<T, lock_policy>(
+            std::allocator_arg, allocator, id, label, std::forward<args_t>(args)...
+    );
+}
+
+/**
+ * Constructs a referable_unique<T> whose content is destroyed by deferred_reclaimer
+ * @tparam T non-const content type
+ * @tparam lock_policy type of Container::content_guard
+ * @tparam args_t types of arguments forwarded to the constructor of T
+ * @param args arguments forwarded to the constructor of T
+ * @return referable_unique<T, lock_policy>
+ */
+template<typename T, typename lock_policy = VARIABLE_UTIL_DEFAULT_LOCK_POLICY, typename ...args_t>
+inline referable_unique<T, lock_policy> make_deferred_referable_unique(args_t &&...args)
+{
+    return referable_unique<T, lock_policy>(
+            deferred_destruction, referable_tag(), referable_tag(), std::forward<args_t>(args)...
+    );
+}
+
 /**
  * Partial specification for std::atomic<T>
  * @tparam T non-const content type. It is guaranteed by std::enable_if_t<!std::is_const<T>::value, T>
+ * @tparam lock_policy unused because std::atomic<T> guarantees thread safety by itself
  */
-template<typename T>
+template<typename T, typename lock_policy>
 class referable_unique<
-        std::atomic<T>, std::enable_if_t<(!std::is_const<T>::value) && std::is_trivially_copyable<T>::value>
+        std::atomic<T>, lock_policy,
+        std::enable_if_t<
+                (!std::is_const<T>::value) && std::is_trivially_copyable<T>::value &&
+                (!std::is_base_of<guard_mode, lock_policy>::value)
+        >
 > final
 {
 private:
@@ -636,10 +2017,26 @@ private:
             "referable_unique requires a trivially copyable content type"
     );
     
-    friend class referable_unique<std::atomic<T>>;
+    template<
+            typename, typename, typename, typename, typename, typename, typename, typename, typename,
+            typename, typename, typename, typename, typename, typename, typename, typename
+    > friend
+    class referable_unique;
     
     std::shared_ptr<std::atomic<T>> atomic_content_shared_ptr;
     
+    /**
+     * Result of batch,
+     * bool for function returning void, otherwise std::optional of the result
+     */
+    template<typename function_t>
+    using batch_result_t = std::conditional_t<
+            std::is_void_v<std::invoke_result_t<function_t, std::atomic<T> &>>,
+            bool, std::optional<
+                    std::remove_cv_t<std::remove_reference_t<std::invoke_result_t<function_t, std::atomic<T> &>>>
+            >
+    >;
+    
     /**
      * Disable default constructor
      */
@@ -648,23 +2045,23 @@ private:
     /**
      * Disable copy constructor
      */
-    inline explicit referable_unique(const referable_unique<std::atomic<T>> &) noexcept = delete;
+    inline explicit referable_unique(const referable_unique &) noexcept = delete;
     
     /**
      * 禁用拷贝赋值运算符
      */
-    inline referable_unique<std::atomic<T>> &operator=(
-            const referable_unique<std::atomic<T>> &
+    inline referable_unique &operator=(
+            const referable_unique &
     ) noexcept = delete;
     
     /**
      * 禁用拷贝赋值运算符（const版本）
      * This declaration is redundant because const instance can only call const method.
      * Even this declaration removed,const instances are unable to call the non-const version.
-     * @return const referable_unique<std::atomic<T>> &
+     * @return const referable_unique &
      */
-    inline const referable_unique<std::atomic<T>> &operator=(
-            const referable_unique<std::atomic<T>> &
+    inline const referable_unique &operator=(
+            const referable_unique &
     ) const noexcept = delete;
 
 public:
@@ -672,11 +2069,9 @@ public:
      * Move constructor
      * @param original_referable_unique
      */
-    inline explicit referable_unique(referable_unique<std::atomic<T>> &&original_referable_unique) noexcept :
+    inline explicit referable_unique(referable_unique &&original_referable_unique) noexcept :
             atomic_content_shared_ptr(
-                    std::move<
-                            std::shared_ptr<std::atomic<T>>
-                    >(original_referable_unique.atomic_content_shared_ptr)
+                    std::move(original_referable_unique.atomic_content_shared_ptr)
             )
     {}
     
@@ -684,10 +2079,10 @@ public:
      * 禁用移动赋值运算符（const版本）
      * This declaration is redundant because const instance can only call const method.
      * Even this declaration removed,const instances are unable to call the non-const version.
-     * @return const referable_unique<std::atomic<T>> &
+     * @return const referable_unique &
      */
-    inline const referable_unique<std::atomic<T>> &operator=(
-            referable_unique<std::atomic<T>> &&
+    inline const referable_unique &operator=(
+            referable_unique &&
     ) const = delete;
     
     /**
@@ -762,17 +2157,151 @@ public:
     
     /**
      * 重载赋值运算符
-     * 原子地以t替换原子变量当前值并返回替换后的值
+     * 原子地以t替换原子变量当前值并返回t，与std::atomic<T>::operator=相同
      * referable_unique具有内容的所有权，可以确保内容有效
      * 所以与weak_ptr::operator=(const T &t)->bool的返回值不同
      * 以便于连续赋值
      * @param t new content
-     * @return content after substitution
+     * @return t
      */
     inline T operator=(const T &t)
     {
         atomic_content_shared_ptr->store(t);
-        return atomic_content_shared_ptr->load();
+        return t;
+    }
+    
+    /**
+     * @param order memory order of the load
+     * @return current content
+     */
+    inline T load(std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+        return atomic_content_shared_ptr->load(order);
+    }
+    
+    /**
+     * @param desired new content
+     * @param order memory order of the store
+     */
+    inline void store(const T &desired, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        atomic_content_shared_ptr->store(desired, order);
+    }
+    
+    /**
+     * @param desired new content
+     * @param order memory order of the exchange
+     * @return content before the exchange
+     */
+    inline T exchange(const T &desired, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return atomic_content_shared_ptr->exchange(desired, order);
+    }
+    
+    /**
+     * @see std::atomic<T>::compare_exchange_weak
+     * @return whether the content was equal to expected and has been replaced by desired,
+     * otherwise expected is set to the content
+     */
+    inline bool compare_exchange_weak(
+            T &expected, const T &desired, std::memory_order success, std::memory_order failure
+    ) noexcept
+    {
+        return atomic_content_shared_ptr->compare_exchange_weak(expected, desired, success, failure);
+    }
+    
+    inline bool compare_exchange_weak(
+            T &expected, const T &desired, std::memory_order order = std::memory_order_seq_cst
+    ) noexcept
+    {
+        return atomic_content_shared_ptr->compare_exchange_weak(expected, desired, order);
+    }
+    
+    /**
+     * @see std::atomic<T>::compare_exchange_strong
+     * @return whether the content was equal to expected and has been replaced by desired,
+     * otherwise expected is set to the content
+     */
+    inline bool compare_exchange_strong(
+            T &expected, const T &desired, std::memory_order success, std::memory_order failure
+    ) noexcept
+    {
+        return atomic_content_shared_ptr->compare_exchange_strong(expected, desired, success, failure);
+    }
+    
+    inline bool compare_exchange_strong(
+            T &expected, const T &desired, std::memory_order order = std::memory_order_seq_cst
+    ) noexcept
+    {
+        return atomic_content_shared_ptr->compare_exchange_strong(expected, desired, order);
+    }
+    
+    /**
+     * Only for T supported by std::atomic<T>::fetch_add, integral and pointer types
+     * @return content before the addition
+     */
+    template<typename operand_t, typename atomic_t = std::atomic<T>>
+    inline auto fetch_add(operand_t operand, std::memory_order order = std::memory_order_seq_cst) noexcept
+    -> decltype(std::declval<atomic_t &>().fetch_add(operand, order))
+    {
+        return atomic_content_shared_ptr->fetch_add(operand, order);
+    }
+    
+    /**
+     * Only for T supported by std::atomic<T>::fetch_sub, integral and pointer types
+     * @return content before the subtraction
+     */
+    template<typename operand_t, typename atomic_t = std::atomic<T>>
+    inline auto fetch_sub(operand_t operand, std::memory_order order = std::memory_order_seq_cst) noexcept
+    -> decltype(std::declval<atomic_t &>().fetch_sub(operand, order))
+    {
+        return atomic_content_shared_ptr->fetch_sub(operand, order);
+    }
+    
+    /**
+     * Only for integral T
+     * @return content before the operation
+     */
+    template<typename operand_t, typename atomic_t = std::atomic<T>>
+    inline auto fetch_and(operand_t operand, std::memory_order order = std::memory_order_seq_cst) noexcept
+    -> decltype(std::declval<atomic_t &>().fetch_and(operand, order))
+    {
+        return atomic_content_shared_ptr->fetch_and(operand, order);
+    }
+    
+    /**
+     * Only for integral T
+     * @return content before the operation
+     */
+    template<typename operand_t, typename atomic_t = std::atomic<T>>
+    inline auto fetch_or(operand_t operand, std::memory_order order = std::memory_order_seq_cst) noexcept
+    -> decltype(std::declval<atomic_t &>().fetch_or(operand, order))
+    {
+        return atomic_content_shared_ptr->fetch_or(operand, order);
+    }
+    
+    /**
+     * Only for integral T
+     * @return content before the operation
+     */
+    template<typename operand_t, typename atomic_t = std::atomic<T>>
+    inline auto fetch_xor(operand_t operand, std::memory_order order = std::memory_order_seq_cst) noexcept
+    -> decltype(std::declval<atomic_t &>().fetch_xor(operand, order))
+    {
+        return atomic_content_shared_ptr->fetch_xor(operand, order);
+    }
+    
+    /**
+     * Applies several operations to the content
+     * @see weak_ptr::batch
+     * @tparam function_t callable with std::atomic<T> &
+     * @param function
+     * @return the result of function
+     */
+    template<typename function_t>
+    inline decltype(auto) batch(function_t &&function)
+    {
+        return std::forward<function_t>(function)(*atomic_content_shared_ptr);
     }
     
     class weak_ptr final
@@ -812,10 +2341,21 @@ public:
          */
         template<typename another_type>
         inline explicit weak_ptr(
-                const typename referable_unique<std::atomic<another_type>>::weak_ptr &another
+                const typename referable_unique<std::atomic<another_type>, lock_policy>::weak_ptr &another
         ) noexcept : atomic_content_weak_ptr(another.atomic_content_weak_ptr)
         {}
         
+        /**
+         * 拷贝赋值运算符
+         * @param another the const lvalue reference of weak_ptr
+         * @return the lvalue reference of this weak_ptr
+         */
+        inline weak_ptr &operator=(const weak_ptr &another) noexcept
+        {
+            this->atomic_content_weak_ptr = another.atomic_content_weak_ptr;
+            return *this;
+        }
+        
         /**
          * 拷贝赋值运算符
          * @tparam another_type
@@ -824,10 +2364,11 @@ public:
          */
         template<typename another_type>
         inline weak_ptr &operator=(
-                const typename referable_unique<std::atomic<another_type>>::weak_ptr &another
+                const typename referable_unique<std::atomic<another_type>, lock_policy>::weak_ptr &another
         ) noexcept
         {
             this->atomic_content_weak_ptr = another.atomic_content_weak_ptr;
+            return *this;
         }
         
         /**
@@ -837,7 +2378,7 @@ public:
          */
         template<typename referable_unique_t>
         inline explicit weak_ptr(
-                const referable_unique <std::atomic<referable_unique_t>> &referable_unique__
+                const referable_unique<std::atomic<referable_unique_t>, lock_policy> &referable_unique__
         ) noexcept :atomic_content_weak_ptr(referable_unique__.atomic_content_shared_ptr)
         {}
         
@@ -854,6 +2395,7 @@ public:
                         std::move(temp_atomic_shared_ptr->load())
                 );
             }
+            else return std::optional<T>();
         }
         
         /**
@@ -871,6 +2413,168 @@ public:
             }
             else return false;
         }
+        
+        /**
+         * Every other operation locks the control block once,
+         * batch locks it once for any number of operations.
+         * @tparam function_t callable with std::atomic<T> &
+         * @param function callable invoked once with the content unless it has expired
+         * @return std::optional of the result of function, a copy of the referred object when it returns a reference,
+         * or bool when function returns void. Empty or false if the content has expired.
+         */
+        template<typename function_t>
+        inline batch_result_t<function_t> batch(function_t &&function) const
+        {
+            std::shared_ptr<std::atomic<T>> atomic_content_shared_pointer(atomic_content_weak_ptr.lock());
+            if (!atomic_content_shared_pointer) return batch_result_t<function_t>();
+            if constexpr (std::is_void_v<std::invoke_result_t<function_t, std::atomic<T> &>>)
+            {
+                std::forward<function_t>(function)(*atomic_content_shared_pointer);
+                return true;
+            }
+            else
+                return batch_result_t<function_t>(
+                        std::forward<function_t>(function)(*atomic_content_shared_pointer)
+                );
+        }
+        
+        /**
+         * @param order memory order of the load
+         * @return content, or std::nullopt if it has expired
+         */
+        inline std::optional<T> load(std::memory_order order = std::memory_order_seq_cst) const noexcept
+        {
+            return batch([order](std::atomic<T> &content) { return content.load(order); });
+        }
+        
+        /**
+         * @param desired new content
+         * @param order memory order of the store
+         * @return false if the content has expired
+         */
+        inline bool store(const T &desired, std::memory_order order = std::memory_order_seq_cst) const noexcept
+        {
+            return batch([&desired, order](std::atomic<T> &content) { content.store(desired, order); });
+        }
+        
+        /**
+         * @param desired new content
+         * @param order memory order of the exchange
+         * @return content before the exchange, or std::nullopt if it has expired
+         */
+        inline std::optional<T> exchange(
+                const T &desired, std::memory_order order = std::memory_order_seq_cst
+        ) const noexcept
+        {
+            return batch(
+                    [&desired, order](std::atomic<T> &content) { return content.exchange(desired, order); }
+            );
+        }
+        
+        /**
+         * @see std::atomic<T>::compare_exchange_weak
+         * @return whether the content has been replaced by desired, or std::nullopt if it has expired
+         */
+        inline std::optional<bool> compare_exchange_weak(
+                T &expected, const T &desired, std::memory_order success, std::memory_order failure
+        ) const noexcept
+        {
+            return batch(
+                    [&](std::atomic<T> &content)
+                    {
+                        return content.compare_exchange_weak(expected, desired, success, failure);
+                    }
+            );
+        }
+        
+        inline std::optional<bool> compare_exchange_weak(
+                T &expected, const T &desired, std::memory_order order = std::memory_order_seq_cst
+        ) const noexcept
+        {
+            return batch(
+                    [&](std::atomic<T> &content) { return content.compare_exchange_weak(expected, desired, order); }
+            );
+        }
+        
+        /**
+         * @see std::atomic<T>::compare_exchange_strong
+         * @return whether the content has been replaced by desired, or std::nullopt if it has expired
+         */
+        inline std::optional<bool> compare_exchange_strong(
+                T &expected, const T &desired, std::memory_order success, std::memory_order failure
+        ) const noexcept
+        {
+            return batch(
+                    [&](std::atomic<T> &content)
+                    {
+                        return content.compare_exchange_strong(expected, desired, success, failure);
+                    }
+            );
+        }
+        
+        inline std::optional<bool> compare_exchange_strong(
+                T &expected, const T &desired, std::memory_order order = std::memory_order_seq_cst
+        ) const noexcept
+        {
+            return batch(
+                    [&](std::atomic<T> &content) { return content.compare_exchange_strong(expected, desired, order); }
+            );
+        }
+        
+        /**
+         * Only for T supported by std::atomic<T>::fetch_add, integral and pointer types
+         * @return content before the addition, or std::nullopt if it has expired
+         */
+        template<typename operand_t, typename atomic_t = std::atomic<T>>
+        inline auto fetch_add(operand_t operand, std::memory_order order = std::memory_order_seq_cst) const noexcept
+        -> decltype(std::declval<atomic_t &>().fetch_add(operand, order), std::optional<T>())
+        {
+            return batch([=](std::atomic<T> &content) { return content.fetch_add(operand, order); });
+        }
+        
+        /**
+         * Only for T supported by std::atomic<T>::fetch_sub, integral and pointer types
+         * @return content before the subtraction, or std::nullopt if it has expired
+         */
+        template<typename operand_t, typename atomic_t = std::atomic<T>>
+        inline auto fetch_sub(operand_t operand, std::memory_order order = std::memory_order_seq_cst) const noexcept
+        -> decltype(std::declval<atomic_t &>().fetch_sub(operand, order), std::optional<T>())
+        {
+            return batch([=](std::atomic<T> &content) { return content.fetch_sub(operand, order); });
+        }
+        
+        /**
+         * Only for integral T
+         * @return content before the operation, or std::nullopt if it has expired
+         */
+        template<typename operand_t, typename atomic_t = std::atomic<T>>
+        inline auto fetch_and(operand_t operand, std::memory_order order = std::memory_order_seq_cst) const noexcept
+        -> decltype(std::declval<atomic_t &>().fetch_and(operand, order), std::optional<T>())
+        {
+            return batch([=](std::atomic<T> &content) { return content.fetch_and(operand, order); });
+        }
+        
+        /**
+         * Only for integral T
+         * @return content before the operation, or std::nullopt if it has expired
+         */
+        template<typename operand_t, typename atomic_t = std::atomic<T>>
+        inline auto fetch_or(operand_t operand, std::memory_order order = std::memory_order_seq_cst) const noexcept
+        -> decltype(std::declval<atomic_t &>().fetch_or(operand, order), std::optional<T>())
+        {
+            return batch([=](std::atomic<T> &content) { return content.fetch_or(operand, order); });
+        }
+        
+        /**
+         * Only for integral T
+         * @return content before the operation, or std::nullopt if it has expired
+         */
+        template<typename operand_t, typename atomic_t = std::atomic<T>>
+        inline auto fetch_xor(operand_t operand, std::memory_order order = std::memory_order_seq_cst) const noexcept
+        -> decltype(std::declval<atomic_t &>().fetch_xor(operand, order), std::optional<T>())
+        {
+            return batch([=](std::atomic<T> &content) { return content.fetch_xor(operand, order); });
+        }
     };
 };
 
@@ -0,0 +1,647 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__a7d2c94e_1f3b_4e60_8c5a_f29b06e1d7c3__referable_unique_intrusive_hpp
+#define HEADER_GUARD__a7d2c94e_1f3b_4e60_8c5a_f29b06e1d7c3__referable_unique_intrusive_hpp
+
+#include "variable_util_includes.h"
+
+/**
+ * Partial specification for content types derived from referable_base.
+ * content_guard and tags live inside the content and the reference counts in front of it, in the same allocation,
+ * so there is no Container and no std::shared_ptr control block:
+ * the content is the only allocation and every handle is a single pointer.
+ * The content is destroyed when the owner and every view are gone,
+ * its memory and the reference counts are freed when the last weak_ptr is gone as well.
+ * @tparam T non-const content type publicly derived from referable_base
+ * @tparam lock_policy ignored, content_guard is of the lock_policy of referable_base
+ */
+template<typename T, typename lock_policy>
+class referable_unique<
+        T, lock_policy, std::enable_if_t<
+                (!std::is_const<T>::value) &&
+                type_util::class_template_instance_base<T, referable_base>::value &&
+                (!std::is_base_of<guard_mode, lock_policy>::value)
+        >
+> final
+{
+private:
+    static_assert(std::is_const_v<T> == 0, "referable_unique requires a non-const content type");
+    
+    using base_type = typename type_util::class_template_instance_base<T, referable_base>::type;
+    using guard_type = typename base_type::lock_type;
+    using unique_lock_type = typename lock_traits<guard_type>::unique_lock_type;
+    using shared_lock_type = typename lock_traits<guard_type>::shared_lock_type;
+    
+    /**
+     * Allocated in front of the content, so that weak_ptr can still read them after the content is destroyed.
+     * strong_count: the owner and every view
+     * weak_count:   every weak_ptr, plus one for all strong references together
+     */
+    struct reference_counts final
+    {
+        std::atomic<std::uint32_t> strong_count, weak_count;
+    };
+    
+    static constexpr std::size_t allocation_alignment = std::max(alignof(T), alignof(reference_counts));
+    
+    ///Offset of the content from the start of its allocation, where the reference counts are
+    static constexpr std::size_t content_offset =
+            (sizeof(reference_counts) + allocation_alignment - 1) / allocation_alignment * allocation_alignment;
+    
+    static inline base_type &base_of(T *content) noexcept
+    {
+        return *static_cast<base_type *>(content);
+    }
+    
+    static inline reference_counts &counts_of(T *content) noexcept
+    {
+        return *std::launder(reinterpret_cast<reference_counts *>(reinterpret_cast<char *>(content) - content_offset));
+    }
+    
+    ///Free the memory of the content and its reference counts when the last weak reference is released
+    static inline void release_weak(T *content) noexcept
+    {
+        reference_counts &counts = counts_of(content);
+        if (counts.weak_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            counts.~reference_counts();
+            ::operator delete(static_cast<void *>(&counts), std::align_val_t(allocation_alignment));
+        }
+    }
+    
+    ///Destroy the content when the last strong reference is released
+    static inline void release_strong(T *content) noexcept
+    {
+        if (counts_of(content).strong_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            content->~T();
+            release_weak(content);
+        }
+    }
+    
+    /**
+     * Take a strong reference unless the content has been destroyed
+     * @return false if the content has expired
+     */
+    static inline bool try_acquire_strong(T *content) noexcept
+    {
+        std::atomic<std::uint32_t> &strong_count = counts_of(content).strong_count;
+        std::uint32_t count = strong_count.load(std::memory_order_relaxed);
+        while (count != 0)
+        {
+            if (strong_count.compare_exchange_weak(
+                    count, count + 1, std::memory_order_acquire, std::memory_order_relaxed
+            ))
+                return true;
+        }
+        return false;
+    }
+    
+    ///A strong reference held by a view
+    class content_pin final
+    {
+    private:
+        T *content;
+        
+        inline explicit content_pin(const content_pin &) = delete;
+        
+        inline content_pin &operator=(const content_pin &) = delete;
+        
+        inline content_pin &operator=(content_pin &&) = delete;
+    
+    public:
+        ///Adopt a strong reference which is already taken
+        inline explicit content_pin(T *pinned_content) noexcept : content(pinned_content)
+        {}
+        
+        inline content_pin(content_pin &&original) noexcept : content(original.content)
+        {
+            original.content = nullptr;
+        }
+        
+        inline ~content_pin()
+        {
+            if (content) release_strong(content);
+        }
+        
+        inline T *get() const noexcept
+        {
+            return content;
+        }
+    };
+    
+    T *content;
+    
+    /**
+     * Disable unnecessary default constructor
+     */
+    inline explicit referable_unique() = delete;
+    
+    /**
+     * Disable copy constructor
+     */
+    inline explicit referable_unique(const referable_unique &) = delete;
+    
+    /**
+     * 禁用拷贝赋值运算符
+     * @return lvalue reference of current referable_unique
+     */
+    inline referable_unique &operator=(const referable_unique &) = delete;
+    
+    /**
+     * 禁用移动赋值运算符
+     * @return lvalue reference of current referable_unique
+     */
+    inline referable_unique &operator=(referable_unique &&) = delete;
+
+public:
+    /**
+     * Move constructor
+     * @param original_referable_unique 原referable_unique<T>
+     */
+    inline explicit referable_unique(referable_unique &&original_referable_unique) noexcept :
+            content(original_referable_unique.content)
+    {
+        original_referable_unique.content = nullptr;
+    }
+    
+    /**
+     * In-place constructor
+     * Constructs the content from args in its own allocation,
+     * which also holds the reference counts in front of the content.
+     * @see make_referable_unique
+     * @tparam args_t types of arguments forwarded to the constructor of T
+     * @param id content id
+     * @param label content label
+     * @param args arguments forwarded to the constructor of T
+     */
+    template<typename ...args_t>
+    inline explicit referable_unique(
+            std::in_place_t,
+            const referable_tag &id, const referable_tag &label,
+            args_t &&...args
+    ) :
+            content(nullptr)
+    {
+        void *const storage = ::operator new(content_offset + sizeof(T), std::align_val_t(allocation_alignment));
+        try
+        {
+            content = ::new(static_cast<char *>(storage) + content_offset) T(std::forward<args_t>(args)...);
+        }
+        catch (...)
+        {
+            ::operator delete(storage, std::align_val_t(allocation_alignment));
+            throw;
+        }
+        base_type &base = base_of(content);
+        base.content_id = id;
+        base.content_label = label;
+        if constexpr (is_instrumented_lock<guard_type>::value) base.content_guard.bind(id, label);
+        reference_counts *const counts = ::new(storage) reference_counts();
+        counts->strong_count.store(1, std::memory_order_relaxed);
+        counts->weak_count.store(1, std::memory_order_relaxed);
+    }
+    
+    inline ~referable_unique()
+    {
+        if (content) release_strong(content);
+    }
+    
+    inline operator bool() const noexcept
+    {
+        return content != nullptr;
+    }
+    
+    ///@return id of the content
+    inline const referable_tag &id() const noexcept
+    {
+        return base_of(content).content_id;
+    }
+    
+    ///@return label of the content
+    inline const referable_tag &label() const noexcept
+    {
+        return base_of(content).content_label;
+    }
+    
+    class const_view final
+    {
+    private:
+        friend class referable_unique;
+        
+        content_pin pinned_content;
+        shared_lock_type content_shared_lock;
+        
+        ///Disable default constructor
+        inline explicit const_view() = delete;
+        
+        ///Disable copy constructor
+        inline explicit const_view(const const_view &) = delete;
+        
+        inline const const_view &operator=(const const_view &) = delete;
+        
+        inline const const_view &operator=(const_view &&) = delete;
+        
+        ///Constructor used by weak_ptr
+        inline explicit const_view(content_pin &&content, shared_lock_type &&content_lock) noexcept :
+                pinned_content(std::move(content)),
+                content_shared_lock(std::move(content_lock))
+        {}
+    
+    public:
+        /// Move constructor
+        inline explicit const_view(const_view &&original) :
+                pinned_content(std::move(original.pinned_content)),
+                content_shared_lock(std::move(original.content_shared_lock))
+        {}
+        
+        ///is this view valid
+        inline operator bool() const
+        {
+            return pinned_content.get() != nullptr && (bool) content_shared_lock;
+        }
+        
+        ///@return id of the content
+        inline const referable_tag &id() const noexcept
+        {
+            return base_of(pinned_content.get()).content_id;
+        }
+        
+        ///@return label of the content
+        inline const referable_tag &label() const noexcept
+        {
+            return base_of(pinned_content.get()).content_label;
+        }
+        
+        inline const T &operator*()
+        {
+            return *pinned_content.get();
+        }
+        
+        inline const T *operator->()
+        {
+            return pinned_content.get();
+        }
+    };
+    
+    class view final
+    {
+    private:
+        friend class referable_unique;
+        
+        content_pin pinned_content;
+        unique_lock_type content_unique_lock;
+        
+        ///Disable default constructor
+        inline explicit view() = delete;
+        
+        ///Disable copy constructor
+        inline explicit view(const view &) = delete;
+        
+        inline const view &operator=(const view &) = delete;
+        
+        inline const view &operator=(view &&) = delete;
+        
+        ///Constructor used by weak_ptr
+        inline explicit view(content_pin &&content, unique_lock_type &&content_lock) noexcept :
+                pinned_content(std::move(content)),
+                content_unique_lock(std::move(content_lock))
+        {}
+    
+    public:
+        /// Move constructor
+        inline explicit view(view &&original) :
+                pinned_content(std::move(original.pinned_content)),
+                content_unique_lock(std::move(original.content_unique_lock))
+        {}
+        
+        ///is this view valid
+        inline operator bool() const
+        {
+            return pinned_content.get() != nullptr && (bool) content_unique_lock;
+        }
+        
+        ///@return id of the content
+        inline const referable_tag &id() const noexcept
+        {
+            return base_of(pinned_content.get()).content_id;
+        }
+        
+        ///@return label of the content
+        inline const referable_tag &label() const noexcept
+        {
+            return base_of(pinned_content.get()).content_label;
+        }
+        
+        inline T &operator*()
+        {
+            return *pinned_content.get();
+        }
+        
+        inline T *operator->()
+        {
+            return pinned_content.get();
+        }
+        
+        ///The referable_base part of the content is kept
+        inline T &operator=(const T &t)
+        {
+            *pinned_content.get() = t;
+            return *pinned_content.get();
+        }
+    };
+    
+    class weak_ptr final
+    {
+    private:
+        ///Holds a weak reference unless it is nullptr
+        T *content;
+        
+        /**
+         * Disable default constructor
+         */
+        inline explicit weak_ptr() = delete;
+        
+        /**
+         * Disable unnecessary move constructor
+         */
+        inline explicit weak_ptr(weak_ptr &&) = delete;
+        
+        /**
+         * 禁用移动赋值运算符
+         * @return lvalue reference of current object
+         */
+        inline weak_ptr &operator=(weak_ptr &&) = delete;
+        
+        ///Take a weak reference of content
+        static inline T *acquire_weak(T *content) noexcept
+        {
+            if (content) counts_of(content).weak_count.fetch_add(1, std::memory_order_relaxed);
+            return content;
+        }
+        
+        /**
+         * Take a strong reference for a view
+         * @return empty content_pin if the content has expired
+         */
+        inline content_pin pin() const noexcept
+        {
+            return content_pin(content && try_acquire_strong(content) ? content : nullptr);
+        }
+    
+    public:
+        /**
+         * Commonly used constructor
+         * @param referable_unique__
+         */
+        inline explicit weak_ptr(const referable_unique &referable_unique__) noexcept :
+                content(acquire_weak(referable_unique__.content))
+        {}
+        
+        /**
+         * Copy constructor
+         * @param another 另一weak_ptr
+         */
+        inline explicit weak_ptr(const weak_ptr &another) noexcept :
+                content(acquire_weak(another.content))
+        {}
+        
+        /**
+         * 拷贝赋值运算符
+         * @param another 另一weak_ptr
+         * @return 当前weak_ptr的左值引用
+         */
+        inline weak_ptr &operator=(const weak_ptr &another) noexcept
+        {
+            T *const previous_content = content;
+            content = acquire_weak(another.content);
+            if (previous_content) release_weak(previous_content);
+            return *this;
+        }
+        
+        inline ~weak_ptr()
+        {
+            if (content) release_weak(content);
+        }
+        
+        inline operator bool() const noexcept
+        {
+            return content && counts_of(content).strong_count.load(std::memory_order_acquire) != 0;
+        }
+        
+        /**
+         * @return id of the content, or std::nullopt when the content has expired
+         */
+        inline std::optional<referable_tag> id() const noexcept
+        {
+            if (content_pin pinned_content = pin(); pinned_content.get())
+                return base_of(pinned_content.get()).content_id;
+            return std::nullopt;
+        }
+        
+        /**
+         * @return label of the content, or std::nullopt when the content has expired
+         */
+        inline std::optional<referable_tag> label() const noexcept
+        {
+            if (content_pin pinned_content = pin(); pinned_content.get())
+                return base_of(pinned_content.get()).content_label;
+            return std::nullopt;
+        }
+        
+        /**
+         * @return std::optional<const_view>
+         * @throw std::bad_weak_ptr when the content has expired
+         */
+        inline std::optional<const_view> get_const_view()
+        {
+            content_pin pinned_content(pin_or_throw());
+            shared_lock_type content_guard_lock(base_of(pinned_content.get()).content_guard);
+            return std::optional<const_view>(
+                    const_view(std::move(pinned_content), std::move(content_guard_lock))
+            );
+        }
+        
+        /**
+         * @return std::optional<const_view>, empty when timed out
+         * @throw std::bad_weak_ptr when the content has expired
+         */
+        template<class Rep, class Period>
+        inline std::optional<const_view> get_const_view(
+                const std::chrono::duration<Rep, Period> &timeout_duration
+        )
+        {
+            content_pin pinned_content(pin_or_throw());
+            if (shared_lock_type content_guard_lock(
+                        base_of(pinned_content.get()).content_guard, timeout_duration
+                );content_guard_lock)
+            {
+                return std::optional<const_view>(
+                        const_view(std::move(pinned_content), std::move(content_guard_lock))
+                );
+            }
+            else return std::optional<const_view>();
+        }
+        
+        /**
+         * @return std::optional<view>
+         * @throw std::bad_weak_ptr when the content has expired
+         */
+        inline std::optional<view> get_view()
+        {
+            content_pin pinned_content(pin_or_throw());
+            unique_lock_type content_guard_lock(base_of(pinned_content.get()).content_guard);
+            return std::optional<view>(
+                    view(std::move(pinned_content), std::move(content_guard_lock))
+            );
+        }
+        
+        /**
+         * @return std::optional<view>, empty when timed out
+         * @throw std::bad_weak_ptr when the content has expired
+         */
+        template<class Rep, class Period>
+        inline std::optional<view> get_view(
+                const std::chrono::duration<Rep, Period> &timeout_duration
+        )
+        {
+            content_pin pinned_content(pin_or_throw());
+            if (unique_lock_type content_guard_lock(
+                        base_of(pinned_content.get()).content_guard, timeout_duration
+                );content_guard_lock)
+            {
+                return std::optional<view>(
+                        view(std::move(pinned_content), std::move(content_guard_lock))
+                );
+            }
+            else return std::optional<view>();
+        }
+        
+        /**
+         * Blocking version of get_const_view which reports expiry instead of throwing
+         * @return access_status::acquired or access_status::expired
+         */
+        inline access_result<const_view> try_get_const_view() const
+        {
+            return try_acquire<const_view, shared_lock_type>(access_status::acquired);
+        }
+        
+        /**
+         * Timed version of get_const_view which reports expiry instead of throwing
+         * @return access_status::acquired, access_status::expired or access_status::timed_out
+         */
+        template<class Rep, class Period>
+        inline access_result<const_view> try_get_const_view(
+                const std::chrono::duration<Rep, Period> &timeout_duration
+        ) const
+        {
+            return try_acquire<const_view, shared_lock_type>(access_status::timed_out, timeout_duration);
+        }
+        
+        /**
+         * Create a const_view only if the content can be locked without waiting
+         * @return access_status::acquired, access_status::expired or access_status::contended
+         */
+        inline access_result<const_view> try_lock_const_view() const
+        {
+            return try_acquire<const_view, shared_lock_type>(access_status::contended, std::try_to_lock);
+        }
+        
+        /**
+         * Blocking version of get_view which reports expiry instead of throwing
+         * @return access_status::acquired or access_status::expired
+         */
+        inline access_result<view> try_get_view() const
+        {
+            return try_acquire<view, unique_lock_type>(access_status::acquired);
+        }
+        
+        /**
+         * Timed version of get_view which reports expiry instead of throwing
+         * @return access_status::acquired, access_status::expired or access_status::timed_out
+         */
+        template<class Rep, class Period>
+        inline access_result<view> try_get_view(
+                const std::chrono::duration<Rep, Period> &timeout_duration
+        ) const
+        {
+            return try_acquire<view, unique_lock_type>(access_status::timed_out, timeout_duration);
+        }
+        
+        /**
+         * Create a view only if the content can be locked without waiting
+         * @return access_status::acquired, access_status::expired or access_status::contended
+         */
+        inline access_result<view> try_lock_view() const
+        {
+            return try_acquire<view, unique_lock_type>(access_status::contended, std::try_to_lock);
+        }
+    
+    private:
+        ///Same as the std::shared_ptr constructor from an expired std::weak_ptr
+        inline content_pin pin_or_throw() const
+        {
+            content_pin pinned_content(pin());
+            if (!pinned_content.get()) throw std::bad_weak_ptr();
+            return pinned_content;
+        }
+        
+        /**
+         * Pin the content, which never throws, and lock it
+         * @tparam view_type view or const_view
+         * @tparam lock_type guard type held by view_type
+         * @tparam lock_args_t types of the arguments following the mutex in the constructor of lock_type
+         * @param failure status returned when the lock is not owned after construction
+         * @param lock_args std::try_to_lock, a timeout duration or nothing
+         */
+        template<typename view_type, typename lock_type, typename ...lock_args_t>
+        inline access_result<view_type> try_acquire(access_status failure, lock_args_t &&...lock_args) const
+        {
+            content_pin pinned_content(pin());
+            if (!pinned_content.get()) return access_result<view_type>(access_status::expired);
+            lock_type content_guard_lock(
+                    base_of(pinned_content.get()).content_guard, std::forward<lock_args_t>(lock_args)...
+            );
+            if (!content_guard_lock) return access_result<view_type>(failure);
+            return access_result<view_type>(view_type(std::move(pinned_content), std::move(content_guard_lock)));
+        }
+    };
+    
+    /**
+     * Lock the content through the owner, which keeps it alive
+     * @return std::optional<view>
+     */
+    inline std::optional<view> operator*()
+    {
+        counts_of(content).strong_count.fetch_add(1, std::memory_order_relaxed);
+        content_pin pinned_content(content);
+        unique_lock_type content_guard_lock(base_of(content).content_guard);
+        return std::optional<view>(view(std::move(pinned_content), std::move(content_guard_lock)));
+    }
+    
+    /**
+     * Lock the content through the owner, which keeps it alive
+     * @return std::optional<const_view>
+     */
+    inline std::optional<const_view> operator*() const
+    {
+        counts_of(content).strong_count.fetch_add(1, std::memory_order_relaxed);
+        content_pin pinned_content(content);
+        shared_lock_type content_guard_lock(base_of(content).content_guard);
+        return std::optional<const_view>(const_view(std::move(pinned_content), std::move(content_guard_lock)));
+    }
+    
+    inline T *operator->() noexcept
+    {
+        return content;
+    }
+    
+    inline const T *operator->() const noexcept
+    {
+        return content;
+    }
+};
+
+#endif //HEADER_GUARD__a7d2c94e_1f3b_4e60_8c5a_f29b06e1d7c3__referable_unique_intrusive_hpp
@@ -0,0 +1,661 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__4c81e9a6_d2f0_4b37_95e8_7a3c1f6b0e24__referable_unique_lock_free_hpp
+#define HEADER_GUARD__4c81e9a6_d2f0_4b37_95e8_7a3c1f6b0e24__referable_unique_lock_free_hpp
+
+#include "variable_util_includes.h"
+
+/**
+ * Lock policy storing the content in a std::atomic<T>.
+ * const_view takes a copy with one atomic load, so readers never wait.
+ */
+struct atomic_storage_policy final : guard_mode
+{
+};
+
+/**
+ * Lock policy storing the content behind a sequence counter.
+ * const_view takes a copy and retries while a view is publishing its modification,
+ * so readers never take a lock.
+ */
+struct seqlock_policy final : guard_mode
+{
+};
+
+///Largest content which storage_policy_t keeps out of a mutex
+inline constexpr std::size_t lock_free_storage_limit = 64;
+
+/**
+ * Storage picked at compile time:
+ * atomic_storage_policy for small trivially copyable T whose std::atomic<T> is always lock-free,
+ * seqlock_policy for other small trivially copyable T,
+ * and VARIABLE_UTIL_DEFAULT_LOCK_POLICY for everything else.
+ * @tparam T non-const content type
+ */
+template<typename T>
+using storage_policy_t = std::conditional_t<
+        std::is_trivially_copyable<T>::value && sizeof(T) <= lock_free_storage_limit &&
+        !type_util::is_class_template_instance<T, std::atomic>::value,
+        std::conditional_t<type_util::is_always_lock_free<T>::value, atomic_storage_policy, seqlock_policy>,
+        VARIABLE_UTIL_DEFAULT_LOCK_POLICY
+>;
+
+/**
+ * referable_unique with the storage picked by storage_policy_t.
+ * view and const_view offer the same interface with every storage.
+ * @tparam T non-const content type
+ */
+template<typename T>
+using automatic_referable_unique = referable_unique<T, storage_policy_t<T>>;
+
+/**
+ * Partial specification for trivially copyable T with atomic_storage_policy or seqlock_policy.
+ * const_view holds a consistent copy of the content taken without a lock.
+ * view holds a private copy which is published when the view is destroyed,
+ * views exclude each other through a flag which readers never look at.
+ * @tparam T non-const trivially copyable content type
+ * @tparam lock_policy atomic_storage_policy or seqlock_policy
+ */
+template<typename T, typename lock_policy>
+class referable_unique<
+        T, lock_policy, std::enable_if_t<
+                (!std::is_const<T>::value) && std::is_trivially_copyable<T>::value &&
+                (std::is_same<lock_policy, atomic_storage_policy>::value ||
+                 std::is_same<lock_policy, seqlock_policy>::value)
+        >
+> final
+{
+private:
+    static_assert(std::is_const_v<T> == 0, "referable_unique requires a non-const content type");
+    
+    static constexpr bool atomic_storage = std::is_same<lock_policy, atomic_storage_policy>::value;
+    
+    static_assert(
+            !atomic_storage || type_util::is_always_lock_free<T>::value,
+            "atomic_storage_policy requires a content type whose std::atomic is always lock-free"
+    );
+    
+    ///Data Class
+    class Container
+    {
+    private:
+        inline explicit Container(const Container &) = delete;
+        
+        inline explicit Container(Container &&) = delete;
+        
+        /**
+         * Only used by seqlock_policy.
+         * It is odd while a view is copying its modification into content.
+         */
+        std::atomic<std::uint64_t> content_version;
+        std::conditional_t<atomic_storage, std::atomic<T>, T> content;
+        ///Held by the only view, never touched by readers
+        std::atomic<bool> writer_flag;
+    
+    public:
+        referable_tag content_id, content_label;
+        
+        template<typename ...args_t>
+        inline explicit Container(
+                const referable_tag &id, const referable_tag &label, args_t &&...args
+        ) :
+                content_version(0),
+                content(T(std::forward<args_t>(args)...)),
+                writer_flag(false),
+                content_id(id), content_label(label)
+        {}
+        
+        ///@return a consistent copy of the content
+        inline T load() const noexcept
+        {
+            if constexpr (atomic_storage) return content.load(std::memory_order_acquire);
+            else
+            {
+                alignas(T) unsigned char snapshot[sizeof(T)];
+                seqlock_copy(content_version, &content, snapshot, sizeof(T));
+                return *std::launder(reinterpret_cast<T *>(snapshot));
+            }
+        }
+        
+        ///Publish the modification of the view holding writer_flag
+        inline void store(const T &modified_content) noexcept
+        {
+            if constexpr (atomic_storage) content.store(modified_content, std::memory_order_release);
+            else
+            {
+                const std::uint64_t version = content_version.load(std::memory_order_relaxed);
+                content_version.store(version + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                std::memcpy(&content, &modified_content, sizeof(T));
+                content_version.store(version + 2, std::memory_order_release);
+            }
+        }
+        
+        inline bool try_lock_writer() noexcept
+        {
+            return !writer_flag.load(std::memory_order_relaxed) &&
+                   !writer_flag.exchange(true, std::memory_order_acquire);
+        }
+        
+        /**
+         * Wait for writer_flag until deadline
+         * @return false if timed out
+         */
+        inline bool lock_writer(const std::optional<std::chrono::steady_clock::time_point> &deadline) noexcept
+        {
+            for (unsigned spin_count = 0; !try_lock_writer(); ++spin_count)
+            {
+                if (deadline && std::chrono::steady_clock::now() >= *deadline) return false;
+                if (spin_count < 64) cpu_relax();
+                else std::this_thread::yield();
+            }
+            return true;
+        }
+        
+        inline void unlock_writer() noexcept
+        {
+            writer_flag.store(false, std::memory_order_release);
+        }
+    };
+    
+    std::shared_ptr<Container> container;
+    
+    /**
+     * Disable unnecessary default constructor
+     */
+    inline explicit referable_unique() = delete;
+    
+    /**
+     * Disable copy constructor
+     */
+    inline explicit referable_unique(const referable_unique &) = delete;
+    
+    /**
+     * 禁用拷贝赋值运算符
+     * @return lvalue reference of current referable_unique
+     */
+    inline referable_unique &operator=(const referable_unique &) = delete;
+    
+    /**
+     * Result of read,
+     * bool for function returning void, otherwise std::optional of the result
+     */
+    template<typename function_t>
+    using read_result_t = std::conditional_t<
+            std::is_void_v<std::invoke_result_t<function_t, const T &>>,
+            bool, std::optional<std::invoke_result_t<function_t, const T &>>
+    >;
+
+public:
+    /**
+     * Move constructor
+     * @param original_referable_unique 原referable_unique<T>
+     */
+    inline explicit referable_unique(referable_unique &&original_referable_unique) noexcept :
+            container(std::move(original_referable_unique.container))
+    {}
+    
+    /**
+     * Commonly used constructor
+     * @param initial_content
+     * @param id content id
+     * @param label content label
+     */
+    inline explicit referable_unique(
+            const T &initial_content,
+            const referable_tag &id = referable_tag(), const referable_tag &label = referable_tag()
+    ) :
+            container(std::make_shared<Container>(id, label, initial_content))
+    {}
+    
+    /**
+     * In-place constructor
+     * @see make_referable_unique
+     * @tparam args_t types of arguments forwarded to the constructor of T
+     * @param id content id
+     * @param label content label
+     * @param args arguments forwarded to the constructor of T
+     */
+    template<typename ...args_t>
+    inline explicit referable_unique(
+            std::in_place_t,
+            const referable_tag &id, const referable_tag &label,
+            args_t &&...args
+    ) :
+            container(std::make_shared<Container>(id, label, std::forward<args_t>(args)...))
+    {}
+    
+    inline operator bool() const noexcept
+    {
+        return (bool) container;
+    }
+    
+    ///@return id of the content
+    inline const referable_tag &id() const noexcept
+    {
+        return container->content_id;
+    }
+    
+    ///@return label of the content
+    inline const referable_tag &label() const noexcept
+    {
+        return container->content_label;
+    }
+    
+    class const_view final
+    {
+    private:
+        friend class referable_unique;
+        
+        std::shared_ptr<Container> container_shared_ptr;
+        T content_snapshot;
+        
+        ///Disable default constructor
+        inline explicit const_view() = delete;
+        
+        ///Disable copy constructor
+        inline explicit const_view(const const_view &) = delete;
+        
+        inline const const_view &operator=(const const_view &) = delete;
+        
+        inline const const_view &operator=(const_view &&) = delete;
+        
+        ///Constructor used by weak_ptr
+        inline explicit const_view(std::shared_ptr<Container> &&container) noexcept :
+                container_shared_ptr(std::move(container)),
+                content_snapshot(container_shared_ptr->load())
+        {}
+    
+    public:
+        /// Move constructor
+        inline explicit const_view(const_view &&original) :
+                container_shared_ptr(std::move(original.container_shared_ptr)),
+                content_snapshot(original.content_snapshot)
+        {}
+        
+        ///is this view valid
+        inline operator bool() const
+        {
+            return (bool) container_shared_ptr;
+        }
+        
+        ///@return id of the content
+        inline const referable_tag &id() const noexcept
+        {
+            return container_shared_ptr->content_id;
+        }
+        
+        ///@return label of the content
+        inline const referable_tag &label() const noexcept
+        {
+            return container_shared_ptr->content_label;
+        }
+        
+        inline const T &operator*()
+        {
+            return content_snapshot;
+        }
+        
+        inline const T *operator->()
+        {
+            return &content_snapshot;
+        }
+    };
+    
+    class view final
+    {
+    private:
+        friend class referable_unique;
+        
+        std::shared_ptr<Container> container_shared_ptr;
+        T content_copy;
+        
+        ///Disable default constructor
+        inline explicit view() = delete;
+        
+        ///Disable copy constructor
+        inline explicit view(const view &) = delete;
+        
+        inline const view &operator=(const view &) = delete;
+        
+        inline const view &operator=(view &&) = delete;
+        
+        ///Constructor used by weak_ptr after the writer flag is taken
+        inline explicit view(std::shared_ptr<Container> &&container) noexcept :
+                container_shared_ptr(std::move(container)),
+                content_copy(container_shared_ptr->load())
+        {}
+    
+    public:
+        /// Move constructor
+        inline explicit view(view &&original) :
+                container_shared_ptr(std::move(original.container_shared_ptr)),
+                content_copy(original.content_copy)
+        {}
+        
+        ///Publish the modification and let the next view in
+        inline ~view()
+        {
+            if (container_shared_ptr)
+            {
+                container_shared_ptr->store(content_copy);
+                container_shared_ptr->unlock_writer();
+            }
+        }
+        
+        ///is this view valid
+        inline operator bool() const
+        {
+            return (bool) container_shared_ptr;
+        }
+        
+        ///@return id of the content
+        inline const referable_tag &id() const noexcept
+        {
+            return container_shared_ptr->content_id;
+        }
+        
+        ///@return label of the content
+        inline const referable_tag &label() const noexcept
+        {
+            return container_shared_ptr->content_label;
+        }
+        
+        inline T &operator*()
+        {
+            return content_copy;
+        }
+        
+        inline T *operator->()
+        {
+            return &content_copy;
+        }
+        
+        inline T &operator=(const T &t)
+        {
+            content_copy = t;
+            return content_copy;
+        }
+    };
+    
+    class weak_ptr final
+    {
+    private:
+        std::weak_ptr<Container> container_weak_ptr;
+        
+        /**
+         * Disable default constructor
+         */
+        inline explicit weak_ptr() = delete;
+        
+        /**
+         * Disable unnecessary move constructor
+         */
+        inline explicit weak_ptr(weak_ptr &&) = delete;
+        
+        /**
+         * 禁用移动赋值运算符
+         * @return lvalue reference of current object
+         */
+        inline weak_ptr &operator=(weak_ptr &&) = delete;
+    
+    public:
+        /**
+         * Commonly used constructor
+         * @param referable_unique__
+         */
+        inline explicit weak_ptr(const referable_unique &referable_unique__) noexcept :
+                container_weak_ptr(referable_unique__.container)
+        {}
+        
+        /**
+         * Copy constructor
+         * @param another 另一weak_ptr
+         */
+        inline explicit weak_ptr(const weak_ptr &another) noexcept :
+                container_weak_ptr(another.container_weak_ptr)
+        {}
+        
+        /**
+         * 拷贝赋值运算符
+         * @param another 另一weak_ptr
+         * @return 当前weak_ptr的左值引用
+         */
+        inline weak_ptr &operator=(const weak_ptr &another) noexcept
+        {
+            this->container_weak_ptr = another.container_weak_ptr;
+            return *this;
+        }
+        
+        inline operator bool() const noexcept
+        {
+            return !container_weak_ptr.expired();
+        }
+        
+        /**
+         * @return id of the content, or std::nullopt when the content has expired
+         */
+        inline std::optional<referable_tag> id() const noexcept
+        {
+            if (auto container_shared_pointer = container_weak_ptr.lock(); container_shared_pointer)
+                return container_shared_pointer->content_id;
+            return std::nullopt;
+        }
+        
+        /**
+         * @return label of the content, or std::nullopt when the content has expired
+         */
+        inline std::optional<referable_tag> label() const noexcept
+        {
+            if (auto container_shared_pointer = container_weak_ptr.lock(); container_shared_pointer)
+                return container_shared_pointer->content_label;
+            return std::nullopt;
+        }
+        
+        /**
+         * Read a consistent copy of the content without a lock
+         * @tparam function_t callable with const T &
+         * @param function callable invoked once with a copy of the content
+         * @return std::optional of the result of function,
+         * or bool when function returns void. Empty or false if the content has expired.
+         */
+        template<typename function_t>
+        inline read_result_t<function_t> read(function_t &&function) const
+        {
+            std::shared_ptr<Container> container_shared_pointer(this->container_weak_ptr.lock());
+            if (!container_shared_pointer) return read_result_t<function_t>();
+            const T content_snapshot(container_shared_pointer->load());
+            if constexpr (std::is_void_v<std::invoke_result_t<function_t, const T &>>)
+            {
+                std::forward<function_t>(function)(content_snapshot);
+                return true;
+            }
+            else return read_result_t<function_t>(std::forward<function_t>(function)(content_snapshot));
+        }
+        
+        /**
+         * Never waits
+         * @return std::optional<const_view>
+         * @throw std::bad_weak_ptr when the content has expired
+         */
+        inline std::optional<const_view> get_const_view()
+        {
+            return std::optional<const_view>(const_view(std::shared_ptr<Container>(this->container_weak_ptr)));
+        }
+        
+        /**
+         * Never waits, so it never times out
+         * @return std::optional<const_view>
+         * @throw std::bad_weak_ptr when the content has expired
+         */
+        template<class Rep, class Period>
+        inline std::optional<const_view> get_const_view(const std::chrono::duration<Rep, Period> &)
+        {
+            return get_const_view();
+        }
+        
+        /**
+         * Waits while another view exists
+         * @return std::optional<view>
+         * @throw std::bad_weak_ptr when the content has expired
+         */
+        inline std::optional<view> get_view()
+        {
+            std::shared_ptr<Container> container_shared_pointer(this->container_weak_ptr);
+            container_shared_pointer->lock_writer(std::nullopt);
+            return std::optional<view>(view(std::move(container_shared_pointer)));
+        }
+        
+        /**
+         * @return std::optional<view>, empty when timed out
+         * @throw std::bad_weak_ptr when the content has expired
+         */
+        template<class Rep, class Period>
+        inline std::optional<view> get_view(const std::chrono::duration<Rep, Period> &timeout_duration)
+        {
+            std::shared_ptr<Container> container_shared_pointer(this->container_weak_ptr);
+            if (!container_shared_pointer->lock_writer(deadline_after(timeout_duration)))
+                return std::optional<view>();
+            return std::optional<view>(view(std::move(container_shared_pointer)));
+        }
+        
+        /**
+         * Version of get_const_view which reports expiry instead of throwing
+         * @return access_status::acquired or access_status::expired
+         */
+        inline access_result<const_view> try_get_const_view() const
+        {
+            std::shared_ptr<Container> container_shared_pointer(this->container_weak_ptr.lock());
+            if (!container_shared_pointer) return access_result<const_view>(access_status::expired);
+            return access_result<const_view>(const_view(std::move(container_shared_pointer)));
+        }
+        
+        /**
+         * Never times out
+         * @return access_status::acquired or access_status::expired
+         */
+        template<class Rep, class Period>
+        inline access_result<const_view> try_get_const_view(const std::chrono::duration<Rep, Period> &) const
+        {
+            return try_get_const_view();
+        }
+        
+        /**
+         * Never contended
+         * @return access_status::acquired or access_status::expired
+         */
+        inline access_result<const_view> try_lock_const_view() const
+        {
+            return try_get_const_view();
+        }
+        
+        /**
+         * Blocking version of get_view which reports expiry instead of throwing
+         * @return access_status::acquired or access_status::expired
+         */
+        inline access_result<view> try_get_view() const
+        {
+            return try_acquire_view(access_status::acquired, std::nullopt, false);
+        }
+        
+        /**
+         * Timed version of get_view which reports expiry instead of throwing
+         * @return access_status::acquired, access_status::expired or access_status::timed_out
+         */
+        template<class Rep, class Period>
+        inline access_result<view> try_get_view(const std::chrono::duration<Rep, Period> &timeout_duration) const
+        {
+            return try_acquire_view(access_status::timed_out, deadline_after(timeout_duration), false);
+        }
+        
+        /**
+         * Create a view only if no other view exists
+         * @return access_status::acquired, access_status::expired or access_status::contended
+         */
+        inline access_result<view> try_lock_view() const
+        {
+            return try_acquire_view(access_status::contended, std::nullopt, true);
+        }
+    
+    private:
+        template<class Rep, class Period>
+        static inline std::chrono::steady_clock::time_point deadline_after(
+                const std::chrono::duration<Rep, Period> &timeout_duration
+        )
+        {
+            return std::chrono::steady_clock::now() +
+                   std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout_duration);
+        }
+        
+        /**
+         * Pin the Container with std::weak_ptr::lock, which never throws, and take the writer flag
+         * @param failure status returned when the writer flag is not taken
+         * @param deadline time to give up waiting, std::nullopt to wait without limit
+         * @param only_try give up at once when another view exists
+         */
+        inline access_result<view> try_acquire_view(
+                access_status failure,
+                const std::optional<std::chrono::steady_clock::time_point> &deadline,
+                bool only_try
+        ) const
+        {
+            std::shared_ptr<Container> container_shared_pointer(this->container_weak_ptr.lock());
+            if (!container_shared_pointer) return access_result<view>(access_status::expired);
+            if (only_try ? !container_shared_pointer->try_lock_writer() :
+                !container_shared_pointer->lock_writer(deadline))
+                return access_result<view>(failure);
+            return access_result<view>(view(std::move(container_shared_pointer)));
+        }
+    };
+    
+    /**
+     * Waits while another view exists
+     * @return std::optional<view>
+     */
+    inline std::optional<view> operator*()
+    {
+        container->lock_writer(std::nullopt);
+        return std::optional<view>(view(std::shared_ptr<Container>(container)));
+    }
+    
+    /**
+     * Never waits
+     * @return std::optional<const_view>
+     */
+    inline std::optional<const_view> operator*() const
+    {
+        return std::optional<const_view>(const_view(std::shared_ptr<Container>(container)));
+    }
+    
+    /**
+     * Read a consistent copy of the content without a lock
+     * @tparam function_t callable with const T &
+     * @param function callable invoked once with a copy of the content
+     * @return the result of function
+     */
+    template<typename function_t>
+    inline decltype(auto) read(function_t &&function) const
+    {
+        const T content_snapshot(container->load());
+        return std::forward<function_t>(function)(content_snapshot);
+    }
+};
+
+/**
+ * Constructs a referable_unique<T> with the storage picked by storage_policy_t
+ * @tparam T non-const content type
+ * @tparam args_t types of arguments forwarded to the constructor of T
+ * @param args arguments forwarded to the constructor of T
+ * @return automatic_referable_unique<T>
+ */
+template<typename T, typename ...args_t>
+inline automatic_referable_unique<T> make_automatic_referable_unique(args_t &&...args)
+{
+    return automatic_referable_unique<T>(
+            std::in_place, referable_tag(), referable_tag(), std::forward<args_t>(args)...
+    );
+}
+
+#endif //HEADER_GUARD__4c81e9a6_d2f0_4b37_95e8_7a3c1f6b0e24__referable_unique_lock_free_hpp
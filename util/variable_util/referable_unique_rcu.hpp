@@ -0,0 +1,631 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__aa70c47b_7256_451c_a600_72371443eaa6__referable_unique_rcu_hpp
+#define HEADER_GUARD__aa70c47b_7256_451c_a600_72371443eaa6__referable_unique_rcu_hpp
+
+#include "variable_util_includes.h"
+
+/**
+ * Lock policy selecting the read-copy-update specialization of referable_unique.
+ * Readers never block and never touch a reference count.
+ * A view edits a private copy of the content, which is published when the view is destroyed,
+ * while const_views created before keep reading the previous version.
+ * Retired versions are reclaimed by epoch_domain.
+ */
+struct rcu_policy final : guard_mode
+{
+};
+
+/**
+ * Partial specification for rcu_policy
+ * @tparam T non-const copy constructible content type
+ */
+template<typename T>
+class referable_unique<
+        T, rcu_policy,
+        std::enable_if_t<
+                (!std::is_const<T>::value) &&
+                (!type_util::is_class_template_instance<T, std::atomic>::value)
+        >
+> final
+{
+private:
+    static_assert(std::is_const_v<T> == 0, "referable_unique requires a non-const content type");
+    static_assert(
+            std::is_copy_constructible_v<T>,
+            "rcu_policy requires a copy constructible content type"
+    );
+    
+    ///Data Class
+    class Container
+    {
+    private:
+        /**
+         * Disable copy constructor and move constructor
+         * because not only these constructors are unnecessary
+         * but also mutex members of this class are NOT copyable or movable
+         */
+        inline explicit Container(const Container &) = delete;
+        
+        inline explicit Container(Container &&) = delete;
+    
+    public:
+        referable_tag content_id, content_label;
+        /**
+         * current_content: the published version of the content
+         * writer_guard:    serializes views, readers never take it
+         */
+        std::atomic<T *> current_content;
+        std::timed_mutex writer_guard;
+        
+        inline explicit Container(const referable_tag &id, const referable_tag &label) noexcept :
+                content_id(id), content_label(label),
+                current_content(nullptr), writer_guard()
+        {}
+        
+        ///No reader can be left when a Container is destroyed by epoch_domain
+        inline ~Container()
+        {
+            delete current_content.load(std::memory_order_relaxed);
+        }
+    };
+    
+    /**
+     * The deleter hands the Container over to epoch_domain,
+     * so that weak_ptr can dereference it inside an epoch_guard
+     * without holding a strong reference.
+     * @param content initial version of the content
+     * @param id content id
+     * @param label content label
+     * @return std::shared_ptr<Container>
+     */
+    static inline std::shared_ptr<Container> make_container(
+            std::unique_ptr<T> &&content, const referable_tag &id, const referable_tag &label
+    )
+    {
+        auto *new_container = new Container(id, label);
+        new_container->current_content.store(content.release(), std::memory_order_relaxed);
+        return std::shared_ptr<Container>(
+                new_container,
+                [](Container *expired_container)
+                {
+                    epoch_domain::instance().retire(
+                            expired_container,
+                            [](void *pointer) { delete static_cast<Container *>(pointer); },
+                            sizeof(Container)
+                    );
+                }
+        );
+    }
+    
+    std::shared_ptr<Container> container;
+    
+    /**
+     * Disable unnecessary default constructor
+     */
+    inline explicit referable_unique() = delete;
+    
+    /**
+     * Disable copy constructor
+     */
+    inline explicit referable_unique(const referable_unique &) = delete;
+    
+    /**
+     * 禁用拷贝赋值运算符
+     * @return lvalue reference of current referable_unique
+     */
+    inline referable_unique &operator=(const referable_unique &) = delete;
+
+public:
+    /**
+     * Move constructor
+     * @param original_referable_unique 原referable_unique<T, rcu_policy>
+     */
+    inline explicit referable_unique(referable_unique &&original_referable_unique) noexcept :
+            container(std::move(original_referable_unique.container))
+    {}
+    
+    /**
+     * Commonly used constructor
+     * @param unique_ptr initial version of the content
+     * @param id content id
+     * @param label content label
+     */
+    inline explicit referable_unique(
+            std::unique_ptr<T> &&unique_ptr,
+            const referable_tag &id = referable_tag(), const referable_tag &label = referable_tag()
+    ) :
+            container(make_container(std::move(unique_ptr), id, label))
+    {}
+    
+    /**
+     * Available constructor
+     * @param content_raw_pointer 指向内容的裸指针的右值引用
+     * @param id content id
+     * @param label content label
+     */
+    inline explicit referable_unique(
+            T *&&content_raw_pointer,
+            const referable_tag &id = referable_tag(), const referable_tag &label = referable_tag()
+    ) :
+            container(make_container(std::unique_ptr<T>(content_raw_pointer), id, label))
+    {}
+    
+    /**
+     * Available constructor
+     * @param content_raw_pointer 指向内容的裸指针的左值引用，构造后将该指针置为nullptr
+     * @param id content id
+     * @param label content label
+     */
+    inline explicit referable_unique(
+            T *&content_raw_pointer,
+            const referable_tag &id = referable_tag(), const referable_tag &label = referable_tag()
+    ) :
+            container(make_container(std::unique_ptr<T>(content_raw_pointer), id, label))
+    {
+        content_raw_pointer = nullptr;
+    }
+    
+    /**
+     * In-place constructor
+     * @see make_referable_unique
+     * @tparam args_t types of arguments forwarded to the constructor of T
+     * @param id content id
+     * @param label content label
+     * @param args arguments forwarded to the constructor of T
+     */
+    template<typename ...args_t>
+    inline explicit referable_unique(
+            std::in_place_t,
+            const referable_tag &id, const referable_tag &label,
+            args_t &&...args
+    ) :
+            container(make_container(std::make_unique<T>(std::forward<args_t>(args)...), id, label))
+    {}
+    
+    inline operator bool() const noexcept
+    {
+        return (bool) container;
+    }
+    
+    ///@return id of the content
+    inline const referable_tag &id() const noexcept
+    {
+        return container->content_id;
+    }
+    
+    ///@return label of the content
+    inline const referable_tag &label() const noexcept
+    {
+        return container->content_label;
+    }
+    
+    class const_view final
+    {
+    private:
+        friend class referable_unique;
+        
+        /**
+         * The version of the content observed when this view was created.
+         * It stays alive as long as content_epoch_guard pins the epoch.
+         */
+        epoch_guard content_epoch_guard;
+        const Container *container_pointer;
+        const T *content_pointer;
+        
+        ///Disable default constructor
+        inline explicit const_view() = delete;
+        
+        ///Disable copy constructor
+        inline explicit const_view(const const_view &) = delete;
+        
+        inline const const_view &operator=(const const_view &) = delete;
+        
+        inline const const_view &operator=(const_view &&) = delete;
+        
+        ///Constructor used by weak_ptr
+        inline explicit const_view(
+                epoch_guard &&guard, const Container *container, const T *content
+        ) noexcept :
+                content_epoch_guard(std::move(guard)),
+                container_pointer(container),
+                content_pointer(content)
+        {}
+    
+    public:
+        /**
+         * Move constructor
+         * A const_view pins the epoch of the thread which created it,
+         * so it must not be moved to another thread.
+         */
+        inline explicit const_view(const_view &&original) noexcept :
+                content_epoch_guard(std::move(original.content_epoch_guard)),
+                container_pointer(std::exchange(original.container_pointer, nullptr)),
+                content_pointer(std::exchange(original.content_pointer, nullptr))
+        {}
+        
+        ///is this view valid
+        inline operator bool() const
+        {
+            return content_pointer != nullptr;
+        }
+        
+        ///@return id of the content
+        inline const referable_tag &id() const noexcept
+        {
+            return container_pointer->content_id;
+        }
+        
+        ///@return label of the content
+        inline const referable_tag &label() const noexcept
+        {
+            return container_pointer->content_label;
+        }
+        
+        inline const T &operator*()
+        {
+            return *content_pointer;
+        }
+        
+        inline const T *operator->()
+        {
+            return content_pointer;
+        }
+    };
+    
+    class view final
+    {
+    private:
+        friend class referable_unique;
+        
+        std::shared_ptr<Container> container_shared_ptr;
+        std::unique_lock<std::timed_mutex> writer_lock;
+        ///Private copy of the content edited by this view
+        std::unique_ptr<T> draft;
+        
+        ///Disable default constructor
+        inline explicit view() = delete;
+        
+        ///Disable copy constructor
+        inline explicit view(const view &) = delete;
+        
+        inline const view &operator=(const view &) = delete;
+        
+        inline const view &operator=(view &&) = delete;
+        
+        ///Constructor used by weak_ptr, copies the published version
+        inline explicit view(
+                std::shared_ptr<Container> &&container,
+                std::unique_lock<std::timed_mutex> &&content_lock
+        ) :
+                container_shared_ptr(std::forward<std::shared_ptr<Container>>(container)),
+                writer_lock(std::forward<std::unique_lock<std::timed_mutex>>(content_lock)),
+                draft(
+                        std::make_unique<T>(
+                                *container_shared_ptr->current_content.load(std::memory_order_acquire)
+                        )
+                )
+        {}
+    
+    public:
+        /// Move constructor
+        inline explicit view(view &&original) :
+                container_shared_ptr(std::move(original.container_shared_ptr)),
+                writer_lock(std::move(original.writer_lock)),
+                draft(std::move(original.draft))
+        {}
+        
+        /**
+         * Publish the draft before writer_lock is released.
+         * The previous version is retired to epoch_domain after writer_lock is released,
+         * so that writers waiting for the lock are not held up by the collection.
+         */
+        inline ~view()
+        {
+            if (!draft) return;
+            T *previous_content = container_shared_ptr->current_content.exchange(
+                    draft.release(), std::memory_order_acq_rel
+            );
+            if (writer_lock.owns_lock()) writer_lock.unlock();
+            epoch_domain::instance().retire(
+                    previous_content, [](void *pointer) { delete static_cast<T *>(pointer); }, sizeof(T)
+            );
+        }
+        
+        ///is this view valid
+        inline operator bool() const
+        {
+            return (
+                    (bool) container_shared_ptr &&
+                    (bool) draft &&
+                    (bool) writer_lock
+            );
+        }
+        
+        ///@return id of the content
+        inline const referable_tag &id() const noexcept
+        {
+            return container_shared_ptr->content_id;
+        }
+        
+        ///@return label of the content
+        inline const referable_tag &label() const noexcept
+        {
+            return container_shared_ptr->content_label;
+        }
+        
+        inline T &operator*()
+        {
+            return *draft;
+        }
+        
+        inline T *operator->()
+        {
+            return draft.get();
+        }
+        
+        inline T &operator=(const T &t)
+        {
+            *draft = t;
+            return *draft;
+        }
+    };
+    
+    class weak_ptr final
+    {
+    private:
+        std::weak_ptr<Container> container_weak_ptr;
+        /**
+         * Dereferenced only inside an epoch_guard after container_weak_ptr is checked,
+         * because an expired Container is destroyed by epoch_domain.
+         */
+        Container *container_raw_ptr;
+        
+        /**
+         * Disable default constructor
+         */
+        inline explicit weak_ptr() = delete;
+    
+    public:
+        /**
+         * Commonly used constructor
+         * @param referable_unique referable_unique<T, rcu_policy>
+         */
+        inline explicit weak_ptr(const referable_unique &referable_unique) noexcept :
+                container_weak_ptr(referable_unique.container),
+                container_raw_ptr(referable_unique.container.get())
+        {}
+        
+        /**
+         * Copy constructor
+         * @param another 另一weak_ptr
+         */
+        inline explicit weak_ptr(const weak_ptr &another) noexcept :
+                container_weak_ptr(another.container_weak_ptr),
+                container_raw_ptr(another.container_raw_ptr)
+        {}
+        
+        /**
+         * 拷贝赋值运算符
+         * @param another 另一weak_ptr
+         * @return 当前weak_ptr的左值引用
+         */
+        inline weak_ptr &operator=(const weak_ptr &another) noexcept
+        {
+            this->container_weak_ptr = another.container_weak_ptr;
+            this->container_raw_ptr = another.container_raw_ptr;
+            return *this;
+        }
+        
+        inline operator bool() const noexcept
+        {
+            return !container_weak_ptr.expired();
+        }
+        
+        /**
+         * Read inside an epoch_guard, without touching a reference count
+         * @return id of the content, or std::nullopt when the content has expired
+         */
+        inline std::optional<referable_tag> id() const noexcept
+        {
+            epoch_guard content_epoch_guard;
+            if (container_weak_ptr.expired()) return std::nullopt;
+            return container_raw_ptr->content_id;
+        }
+        
+        /**
+         * Read inside an epoch_guard, without touching a reference count
+         * @return label of the content, or std::nullopt when the content has expired
+         */
+        inline std::optional<referable_tag> label() const noexcept
+        {
+            epoch_guard content_epoch_guard;
+            if (container_weak_ptr.expired()) return std::nullopt;
+            return container_raw_ptr->content_label;
+        }
+        
+        /**
+         * Never blocks and never touches a reference count.
+         * The returned const_view must be destroyed by the calling thread.
+         * @return std::optional<const_view>, empty when the content has expired
+         */
+        inline std::optional<const_view> get_const_view() const
+        {
+            epoch_guard content_epoch_guard;
+            if (container_weak_ptr.expired()) return std::optional<const_view>();
+            return std::optional<const_view>(
+                    const_view(
+                            std::move(content_epoch_guard), container_raw_ptr,
+                            container_raw_ptr->current_content.load(std::memory_order_acquire)
+                    )
+            );
+        }
+        
+        /**
+         * Same as get_const_view() because readers never wait
+         * @return std::optional<const_view>, empty when the content has expired
+         */
+        template<class Rep, class Period>
+        inline std::optional<const_view> get_const_view(
+                const std::chrono::duration<Rep, Period> &
+        ) const
+        {
+            return get_const_view();
+        }
+        
+        /**
+         * Read the published version without creating a const_view
+         * @tparam function_t callable with const T &
+         * @param function callable invoked once with the published version
+         * @return std::optional of the result of function,
+         * or bool when function returns void. Empty or false if the content has expired.
+         */
+        template<typename function_t>
+        inline std::conditional_t<
+                std::is_void_v<std::invoke_result_t<function_t, const T &>>,
+                bool, std::optional<std::invoke_result_t<function_t, const T &>>
+        > read(function_t &&function) const
+        {
+            epoch_guard content_epoch_guard;
+            if (container_weak_ptr.expired()) return {};
+            const T &content = *container_raw_ptr->current_content.load(std::memory_order_acquire);
+            if constexpr (std::is_void_v<std::invoke_result_t<function_t, const T &>>)
+            {
+                std::forward<function_t>(function)(content);
+                return true;
+            }
+            else return std::make_optional(std::forward<function_t>(function)(content));
+        }
+        
+        inline std::optional<view> get_view()
+        {
+            std::shared_ptr<Container> container_shared_ptr(this->container_weak_ptr);
+            /// in constructor of this shared pointer
+            /// exception std::bad_weak_ptr will be thrown
+            /// when container has expired
+            std::unique_lock<std::timed_mutex> writer_lock(container_shared_ptr->writer_guard);
+            return std::optional<view>(
+                    view(std::move(container_shared_ptr), std::move(writer_lock))
+            );
+        }
+        
+        template<class Rep, class Period>
+        inline std::optional<view> get_view(
+                const std::chrono::duration<Rep, Period> &timeout_duration
+        )
+        {
+            std::shared_ptr<Container> container_shared_ptr(this->container_weak_ptr);
+            /// in constructor of this shared pointer
+            /// exception std::bad_weak_ptr will be thrown
+            /// when container has expired
+            if (std::unique_lock<std::timed_mutex> writer_lock(
+                        container_shared_ptr->writer_guard, timeout_duration
+                );writer_lock)
+            {
+                return std::optional<view>(
+                        view(std::move(container_shared_ptr), std::move(writer_lock))
+                );
+            }
+            else return std::optional<view>();
+        }
+        
+        /**
+         * Same as get_const_view() because readers never wait
+         * @return access_status::acquired or access_status::expired
+         */
+        inline access_result<const_view> try_get_const_view() const
+        {
+            epoch_guard content_epoch_guard;
+            if (container_weak_ptr.expired()) return access_result<const_view>(access_status::expired);
+            return access_result<const_view>(
+                    const_view(
+                            std::move(content_epoch_guard), container_raw_ptr,
+                            container_raw_ptr->current_content.load(std::memory_order_acquire)
+                    )
+            );
+        }
+        
+        ///Same as try_get_const_view() because readers never wait
+        template<class Rep, class Period>
+        inline access_result<const_view> try_get_const_view(
+                const std::chrono::duration<Rep, Period> &
+        ) const
+        {
+            return try_get_const_view();
+        }
+        
+        ///Same as try_get_const_view() because readers never wait
+        inline access_result<const_view> try_lock_const_view() const
+        {
+            return try_get_const_view();
+        }
+        
+        /**
+         * Blocking version of get_view which reports expiry instead of throwing
+         * @return access_status::acquired or access_status::expired
+         */
+        inline access_result<view> try_get_view() const
+        {
+            return try_acquire(access_status::acquired);
+        }
+        
+        /**
+         * Timed version of get_view which reports expiry instead of throwing
+         * @return access_status::acquired, access_status::expired or access_status::timed_out
+         */
+        template<class Rep, class Period>
+        inline access_result<view> try_get_view(
+                const std::chrono::duration<Rep, Period> &timeout_duration
+        ) const
+        {
+            return try_acquire(access_status::timed_out, timeout_duration);
+        }
+        
+        /**
+         * Create a view only if no other view of the content exists
+         * @return access_status::acquired, access_status::expired or access_status::contended
+         */
+        inline access_result<view> try_lock_view() const
+        {
+            return try_acquire(access_status::contended, std::try_to_lock);
+        }
+    
+    private:
+        /**
+         * Pin the Container with std::weak_ptr::lock, which never throws, and lock writer_guard
+         * @tparam lock_args_t types of the arguments following the mutex in the constructor of std::unique_lock
+         * @param failure status returned when the lock is not owned after construction
+         * @param lock_args std::try_to_lock, a timeout duration or nothing
+         */
+        template<typename ...lock_args_t>
+        inline access_result<view> try_acquire(access_status failure, lock_args_t &&...lock_args) const
+        {
+            std::shared_ptr<Container> container_shared_ptr(this->container_weak_ptr.lock());
+            if (!container_shared_ptr) return access_result<view>(access_status::expired);
+            std::unique_lock<std::timed_mutex> writer_lock(
+                    container_shared_ptr->writer_guard, std::forward<lock_args_t>(lock_args)...
+            );
+            if (!writer_lock) return access_result<view>(failure);
+            return access_result<view>(view(std::move(container_shared_ptr), std::move(writer_lock)));
+        }
+    };
+    
+    /**
+     * Read the published version, the owner keeps the content alive
+     * @tparam function_t callable with const T &
+     * @param function callable invoked once with the published version
+     * @return the result of function
+     */
+    template<typename function_t>
+    inline decltype(auto) read(function_t &&function) const
+    {
+        epoch_guard content_epoch_guard;
+        return std::forward<function_t>(function)(
+                *container->current_content.load(std::memory_order_acquire)
+        );
+    }
+};
+
+#endif //HEADER_GUARD__aa70c47b_7256_451c_a600_72371443eaa6__referable_unique_rcu_hpp
@@ -0,0 +1,700 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__a2c7e419_6f08_4d5b_b3e1_98d4f0c27a6e__referable_unique_replicated_hpp
+#define HEADER_GUARD__a2c7e419_6f08_4d5b_b3e1_98d4f0c27a6e__referable_unique_replicated_hpp
+
+#include "variable_util_includes.h"
+
+/**
+ * NUMA nodes of the machine and the node of each CPU, read once from sysfs.
+ * Machines without NUMA information are seen as a single node.
+ */
+class numa_topology final
+{
+private:
+    std::vector<std::uint16_t> cpu_nodes;
+    std::size_t nodes;
+    
+    inline explicit numa_topology(const numa_topology &) = delete;
+    
+    inline numa_topology &operator=(const numa_topology &) = delete;
+    
+    inline explicit numa_topology() : cpu_nodes(), nodes(1)
+    {
+#if defined(__linux__)
+        for (std::size_t node = 0; node < 1024; ++node)
+        {
+            const std::string path = "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+            std::FILE *cpulist = std::fopen(path.c_str(), "r");
+            if (!cpulist) break;
+            char line[4096] = {};
+            const bool read = std::fgets(line, sizeof(line), cpulist) != nullptr;
+            std::fclose(cpulist);
+            if (!read) break;
+            /// ranges like 0-3,8-11
+            for (char *cursor = line; *cursor && *cursor != '\n';)
+            {
+                char *end = nullptr;
+                const unsigned long first = std::strtoul(cursor, &end, 10);
+                if (end == cursor) break;
+                unsigned long last = first;
+                cursor = end;
+                if (*cursor == '-')
+                {
+                    last = std::strtoul(cursor + 1, &end, 10);
+                    cursor = end;
+                }
+                if (last >= 65536) break;
+                if (cpu_nodes.size() <= last) cpu_nodes.resize(last + 1, 0);
+                for (unsigned long cpu = first; cpu <= last; ++cpu)
+                    cpu_nodes[cpu] = static_cast<std::uint16_t>(node);
+                if (*cursor == ',') ++cursor;
+            }
+            nodes = node + 1;
+        }
+#endif
+    }
+
+public:
+    static inline const numa_topology &instance()
+    {
+        static const numa_topology topology;
+        return topology;
+    }
+    
+    inline std::size_t node_count() const noexcept
+    {
+        return nodes;
+    }
+    
+    ///NUMA node of the CPU running the calling thread, 0 where it is unknown
+    inline std::size_t current_node() const noexcept
+    {
+#if defined(__linux__)
+        if (const int cpu = sched_getcpu(); cpu >= 0 && static_cast<std::size_t>(cpu) < cpu_nodes.size())
+            return cpu_nodes[cpu];
+#endif
+        return 0;
+    }
+};
+
+/**
+ * Lock policy selecting the replicated specialization of referable_unique for read-mostly contents.
+ * Each NUMA node holds its own copy of the content guarded by its own replica_lock_policy,
+ * so that a const_view touches only memory of the node of the reader.
+ * @tparam replica_lock_policy lock policy of the primary copy and of each replica
+ */
+template<typename replica_lock_policy = VARIABLE_UTIL_DEFAULT_LOCK_POLICY>
+struct numa_replicated_policy final : guard_mode
+{
+};
+
+/**
+ * Partial specification for numa_replicated_policy.
+ * A view modifies the primary copy and bumps its version when it is destroyed.
+ * A const_view locks the replica of the calling node,
+ * which the reader first copies from the primary copy when the version has moved,
+ * so the replica and the memory it allocates are first touched on that node.
+ * A const_view sees the content as modified by the last view destroyed before it was created
+ * and does not exclude a view, whose modification reaches the readers when it is destroyed.
+ * Lifetime and expiry are the same as with other lock policies.
+ * @tparam T non-const copyable content type
+ * @tparam replica_lock_policy
+ */
+template<typename T, typename replica_lock_policy>
+class referable_unique<
+        T, numa_replicated_policy<replica_lock_policy>, std::enable_if_t<
+                (!std::is_const<T>::value) &&
+                std::is_copy_constructible<T>::value && std::is_copy_assignable<T>::value
+        >
+> final
+{
+private:
+    static_assert(std::is_const_v<T> == 0, "referable_unique requires a non-const content type");
+    
+    using unique_lock_type = typename lock_traits<replica_lock_policy>::unique_lock_type;
+    using shared_lock_type = typename lock_traits<replica_lock_policy>::shared_lock_type;
+    
+    ///Copy of the content on one NUMA node
+    struct alignas(64) replica final
+    {
+        replica_lock_policy content_guard;
+        ///Version of the primary copy this replica was copied from, guarded by content_guard
+        std::uint64_t content_version;
+        T content;
+        
+        inline explicit replica(std::uint64_t version, const T &primary_content) :
+                content_guard(), content_version(version), content(primary_content)
+        {}
+    };
+    
+    ///Data Class
+    class Container
+    {
+    private:
+        inline explicit Container(const Container &) = delete;
+        
+        inline explicit Container(Container &&) = delete;
+        
+        std::unique_ptr<std::atomic<replica *>[]> replicas;
+        const std::size_t replica_count;
+    
+    public:
+        referable_tag content_id, content_label;
+        ///Guard of the primary copy, held exclusively by views and shared by readers refreshing a replica
+        replica_lock_policy content_guard;
+        T content;
+        ///Number of views destroyed, read by every reader so it has its own cache line
+        alignas(64) std::atomic<std::uint64_t> content_version;
+        
+        template<typename ...args_t>
+        inline explicit Container(
+                const referable_tag &id, const referable_tag &label, args_t &&...args
+        ) :
+                replicas(new std::atomic<replica *>[numa_topology::instance().node_count()]),
+                replica_count(numa_topology::instance().node_count()),
+                content_id(id), content_label(label),
+                content_guard(), content(std::forward<args_t>(args)...),
+                content_version(0)
+        {
+            for (std::size_t node = 0; node < replica_count; ++node)
+                replicas[node].store(nullptr, std::memory_order_relaxed);
+        }
+        
+        inline ~Container()
+        {
+            for (std::size_t node = 0; node < replica_count; ++node)
+                delete replicas[node].load(std::memory_order_relaxed);
+        }
+        
+        /**
+         * Replica of the node of the calling thread,
+         * created by the first reader of the node so that it is allocated there
+         * @param lock_args std::try_to_lock, a deadline or nothing
+         * @return nullptr if the primary copy could not be locked to create it
+         */
+        template<typename ...lock_args_t>
+        inline replica *local_replica(const lock_args_t &...lock_args)
+        {
+            std::atomic<replica *> &slot = replicas[numa_topology::instance().current_node() % replica_count];
+            if (replica *const existing = slot.load(std::memory_order_acquire)) return existing;
+            shared_lock_type primary_lock(content_guard, lock_args...);
+            if (!primary_lock) return nullptr;
+            auto created = std::make_unique<replica>(content_version.load(std::memory_order_relaxed), content);
+            primary_lock.unlock();
+            replica *expected = nullptr;
+            if (slot.compare_exchange_strong(expected, created.get(), std::memory_order_acq_rel))
+                return created.release();
+            return expected;
+        }
+        
+        /**
+         * Copy the primary copy into local unless another reader has done it
+         * @return false if a guard could not be locked
+         */
+        template<typename ...lock_args_t>
+        inline bool refresh(replica &local, const lock_args_t &...lock_args)
+        {
+            unique_lock_type replica_lock(local.content_guard, lock_args...);
+            if (!replica_lock) return false;
+            if (local.content_version == content_version.load(std::memory_order_acquire)) return true;
+            shared_lock_type primary_lock(content_guard, lock_args...);
+            if (!primary_lock) return false;
+            local.content = content;
+            local.content_version = content_version.load(std::memory_order_relaxed);
+            return true;
+        }
+    };
+    
+    std::shared_ptr<Container> container;
+    
+    /**
+     * Disable unnecessary default constructor
+     */
+    inline explicit referable_unique() = delete;
+    
+    /**
+     * Disable copy constructor
+     */
+    inline explicit referable_unique(const referable_unique &) = delete;
+    
+    /**
+     * 禁用拷贝赋值运算符
+     * @return lvalue reference of current referable_unique
+     */
+    inline referable_unique &operator=(const referable_unique &) = delete;
+
+public:
+    /**
+     * Move constructor
+     * @param original_referable_unique 原referable_unique<T>
+     */
+    inline explicit referable_unique(referable_unique &&original_referable_unique) noexcept :
+            container(std::move(original_referable_unique.container))
+    {}
+    
+    /**
+     * Commonly used constructor
+     * @param initial_content
+     * @param id content id
+     * @param label content label
+     */
+    inline explicit referable_unique(
+            const T &initial_content,
+            const referable_tag &id = referable_tag(), const referable_tag &label = referable_tag()
+    ) :
+            container(std::make_shared<Container>(id, label, initial_content))
+    {}
+    
+    /**
+     * In-place constructor
+     * @see make_referable_unique
+     * @tparam args_t types of arguments forwarded to the constructor of T
+     * @param id content id
+     * @param label content label
+     * @param args arguments forwarded to the constructor of T
+     */
+    template<typename ...args_t>
+    inline explicit referable_unique(
+            std::in_place_t,
+            const referable_tag &id, const referable_tag &label,
+            args_t &&...args
+    ) :
+            container(std::make_shared<Container>(id, label, std::forward<args_t>(args)...))
+    {}
+    
+    inline operator bool() const noexcept
+    {
+        return (bool) container;
+    }
+    
+    ///@return id of the content
+    inline const referable_tag &id() const noexcept
+    {
+        return container->content_id;
+    }
+    
+    ///@return label of the content
+    inline const referable_tag &label() const noexcept
+    {
+        return container->content_label;
+    }
+    
+    class const_view final
+    {
+    private:
+        friend class referable_unique;
+        
+        std::shared_ptr<Container> container_shared_ptr;
+        replica *local_replica;
+        shared_lock_type replica_shared_lock;
+        
+        ///Disable default constructor
+        inline explicit const_view() = delete;
+        
+        ///Disable copy constructor
+        inline explicit const_view(const const_view &) = delete;
+        
+        inline const const_view &operator=(const const_view &) = delete;
+        
+        inline const const_view &operator=(const_view &&) = delete;
+        
+        ///Constructor used by weak_ptr
+        inline explicit const_view(
+                std::shared_ptr<Container> &&container, replica *local, shared_lock_type &&replica_lock
+        ) noexcept :
+                container_shared_ptr(std::move(container)),
+                local_replica(local),
+                replica_shared_lock(std::move(replica_lock))
+        {}
+    
+    public:
+        /// Move constructor
+        inline explicit const_view(const_view &&original) :
+                container_shared_ptr(std::move(original.container_shared_ptr)),
+                local_replica(original.local_replica),
+                replica_shared_lock(std::move(original.replica_shared_lock))
+        {}
+        
+        ///is this view valid
+        inline operator bool() const
+        {
+            return (bool) container_shared_ptr && (bool) replica_shared_lock;
+        }
+        
+        ///@return id of the content
+        inline const referable_tag &id() const noexcept
+        {
+            return container_shared_ptr->content_id;
+        }
+        
+        ///@return label of the content
+        inline const referable_tag &label() const noexcept
+        {
+            return container_shared_ptr->content_label;
+        }
+        
+        inline const T &operator*()
+        {
+            return local_replica->content;
+        }
+        
+        inline const T *operator->()
+        {
+            return &local_replica->content;
+        }
+    };
+    
+    class view final
+    {
+    private:
+        friend class referable_unique;
+        
+        std::shared_ptr<Container> container_shared_ptr;
+        unique_lock_type content_unique_lock;
+        
+        ///Disable default constructor
+        inline explicit view() = delete;
+        
+        ///Disable copy constructor
+        inline explicit view(const view &) = delete;
+        
+        inline const view &operator=(const view &) = delete;
+        
+        inline const view &operator=(view &&) = delete;
+        
+        ///Constructor used by weak_ptr
+        inline explicit view(std::shared_ptr<Container> &&container, unique_lock_type &&content_lock) noexcept :
+                container_shared_ptr(std::move(container)),
+                content_unique_lock(std::move(content_lock))
+        {}
+    
+    public:
+        /// Move constructor
+        inline explicit view(view &&original) :
+                container_shared_ptr(std::move(original.container_shared_ptr)),
+                content_unique_lock(std::move(original.content_unique_lock))
+        {}
+        
+        ///Make the replicas stale before content_unique_lock is released
+        inline ~view()
+        {
+            if (container_shared_ptr && content_unique_lock)
+                container_shared_ptr->content_version.fetch_add(1, std::memory_order_release);
+        }
+        
+        ///is this view valid
+        inline operator bool() const
+        {
+            return (bool) container_shared_ptr && (bool) content_unique_lock;
+        }
+        
+        ///@return id of the content
+        inline const referable_tag &id() const noexcept
+        {
+            return container_shared_ptr->content_id;
+        }
+        
+        ///@return label of the content
+        inline const referable_tag &label() const noexcept
+        {
+            return container_shared_ptr->content_label;
+        }
+        
+        inline T &operator*()
+        {
+            return container_shared_ptr->content;
+        }
+        
+        inline T *operator->()
+        {
+            return &container_shared_ptr->content;
+        }
+        
+        inline T &operator=(const T &t)
+        {
+            container_shared_ptr->content = t;
+            return container_shared_ptr->content;
+        }
+    };
+    
+    class weak_ptr final
+    {
+    private:
+        friend class referable_unique;
+        
+        std::weak_ptr<Container> container_weak_ptr;
+        
+        /**
+         * Disable default constructor
+         */
+        inline explicit weak_ptr() = delete;
+        
+        /**
+         * Disable unnecessary move constructor
+         */
+        inline explicit weak_ptr(weak_ptr &&) = delete;
+        
+        /**
+         * 禁用移动赋值运算符
+         * @return lvalue reference of current object
+         */
+        inline weak_ptr &operator=(weak_ptr &&) = delete;
+    
+    public:
+        /**
+         * Commonly used constructor
+         * @param referable_unique__
+         */
+        inline explicit weak_ptr(const referable_unique &referable_unique__) noexcept :
+                container_weak_ptr(referable_unique__.container)
+        {}
+        
+        /**
+         * Copy constructor
+         * @param another 另一weak_ptr
+         */
+        inline explicit weak_ptr(const weak_ptr &another) noexcept :
+                container_weak_ptr(another.container_weak_ptr)
+        {}
+        
+        /**
+         * 拷贝赋值运算符
+         * @param another 另一weak_ptr
+         * @return 当前weak_ptr的左值引用
+         */
+        inline weak_ptr &operator=(const weak_ptr &another) noexcept
+        {
+            this->container_weak_ptr = another.container_weak_ptr;
+            return *this;
+        }
+        
+        inline operator bool() const noexcept
+        {
+            return !container_weak_ptr.expired();
+        }
+        
+        /**
+         * @return id of the content, or std::nullopt when the content has expired
+         */
+        inline std::optional<referable_tag> id() const noexcept
+        {
+            if (auto container_shared_pointer = container_weak_ptr.lock(); container_shared_pointer)
+                return container_shared_pointer->content_id;
+            return std::nullopt;
+        }
+        
+        /**
+         * @return label of the content, or std::nullopt when the content has expired
+         */
+        inline std::optional<referable_tag> label() const noexcept
+        {
+            if (auto container_shared_pointer = container_weak_ptr.lock(); container_shared_pointer)
+                return container_shared_pointer->content_label;
+            return std::nullopt;
+        }
+        
+        /**
+         * Locks the replica of the calling node
+         * @return std::optional<const_view>
+         * @throw std::bad_weak_ptr when the content has expired
+         */
+        inline std::optional<const_view> get_const_view()
+        {
+            return std::optional<const_view>(
+                    acquire_const_view(std::shared_ptr<Container>(this->container_weak_ptr))
+            );
+        }
+        
+        /**
+         * @return std::optional<const_view>, empty when timed out
+         * @throw std::bad_weak_ptr when the content has expired
+         */
+        template<class Rep, class Period>
+        inline std::optional<const_view> get_const_view(const std::chrono::duration<Rep, Period> &timeout_duration)
+        {
+            return acquire_const_view(
+                    std::shared_ptr<Container>(this->container_weak_ptr), deadline_after(timeout_duration)
+            );
+        }
+        
+        /**
+         * @return std::optional<view>
+         * @throw std::bad_weak_ptr when the content has expired
+         */
+        inline std::optional<view> get_view()
+        {
+            std::shared_ptr<Container> container_shared_pointer(this->container_weak_ptr);
+            unique_lock_type content_guard_lock(container_shared_pointer->content_guard);
+            return std::optional<view>(view(std::move(container_shared_pointer), std::move(content_guard_lock)));
+        }
+        
+        /**
+         * @return std::optional<view>, empty when timed out
+         * @throw std::bad_weak_ptr when the content has expired
+         */
+        template<class Rep, class Period>
+        inline std::optional<view> get_view(const std::chrono::duration<Rep, Period> &timeout_duration)
+        {
+            std::shared_ptr<Container> container_shared_pointer(this->container_weak_ptr);
+            if (unique_lock_type content_guard_lock(
+                        container_shared_pointer->content_guard, timeout_duration
+                ); content_guard_lock)
+                return std::optional<view>(
+                        view(std::move(container_shared_pointer), std::move(content_guard_lock))
+                );
+            return std::optional<view>();
+        }
+        
+        /**
+         * Blocking version of get_const_view which reports expiry instead of throwing
+         * @return access_status::acquired or access_status::expired
+         */
+        inline access_result<const_view> try_get_const_view() const
+        {
+            return try_acquire_const_view(access_status::acquired);
+        }
+        
+        /**
+         * Timed version of get_const_view which reports expiry instead of throwing
+         * @return access_status::acquired, access_status::expired or access_status::timed_out
+         */
+        template<class Rep, class Period>
+        inline access_result<const_view> try_get_const_view(
+                const std::chrono::duration<Rep, Period> &timeout_duration
+        ) const
+        {
+            return try_acquire_const_view(access_status::timed_out, deadline_after(timeout_duration));
+        }
+        
+        /**
+         * Create a const_view only if the replica, and the primary copy when the replica is stale,
+         * can be locked without waiting
+         * @return access_status::acquired, access_status::expired or access_status::contended
+         */
+        inline access_result<const_view> try_lock_const_view() const
+        {
+            return try_acquire_const_view(access_status::contended, std::try_to_lock);
+        }
+        
+        /**
+         * Blocking version of get_view which reports expiry instead of throwing
+         * @return access_status::acquired or access_status::expired
+         */
+        inline access_result<view> try_get_view() const
+        {
+            return try_acquire_view(access_status::acquired);
+        }
+        
+        /**
+         * Timed version of get_view which reports expiry instead of throwing
+         * @return access_status::acquired, access_status::expired or access_status::timed_out
+         */
+        template<class Rep, class Period>
+        inline access_result<view> try_get_view(const std::chrono::duration<Rep, Period> &timeout_duration) const
+        {
+            return try_acquire_view(access_status::timed_out, timeout_duration);
+        }
+        
+        /**
+         * Create a view only if the primary copy can be locked without waiting
+         * @return access_status::acquired, access_status::expired or access_status::contended
+         */
+        inline access_result<view> try_lock_view() const
+        {
+            return try_acquire_view(access_status::contended, std::try_to_lock);
+        }
+    
+    private:
+        template<class Rep, class Period>
+        static inline std::chrono::steady_clock::time_point deadline_after(
+                const std::chrono::duration<Rep, Period> &timeout_duration
+        )
+        {
+            return std::chrono::steady_clock::now() +
+                   std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout_duration);
+        }
+        
+        /**
+         * Lock the replica of the calling node, refreshing it while it is stale
+         * @param container_shared_pointer pinned Container
+         * @param lock_args std::try_to_lock, a deadline or nothing, applied to every lock taken
+         * @return empty if a guard could not be locked
+         */
+        template<typename ...lock_args_t>
+        static inline std::optional<const_view> acquire_const_view(
+                std::shared_ptr<Container> &&container_shared_pointer, const lock_args_t &...lock_args
+        )
+        {
+            replica *const local = container_shared_pointer->local_replica(lock_args...);
+            if (!local) return std::optional<const_view>();
+            for (;;)
+            {
+                shared_lock_type replica_lock(local->content_guard, lock_args...);
+                if (!replica_lock) return std::optional<const_view>();
+                if (local->content_version ==
+                    container_shared_pointer->content_version.load(std::memory_order_acquire))
+                    return std::optional<const_view>(
+                            const_view(std::move(container_shared_pointer), local, std::move(replica_lock))
+                    );
+                replica_lock.unlock();
+                if (!container_shared_pointer->refresh(*local, lock_args...)) return std::optional<const_view>();
+            }
+        }
+        
+        /**
+         * Pin the Container with std::weak_ptr::lock, which never throws, and lock the local replica
+         * @param failure status returned when a guard is not locked
+         * @param lock_args std::try_to_lock, a deadline or nothing
+         */
+        template<typename ...lock_args_t>
+        inline access_result<const_view> try_acquire_const_view(
+                access_status failure, const lock_args_t &...lock_args
+        ) const
+        {
+            std::shared_ptr<Container> container_shared_pointer(this->container_weak_ptr.lock());
+            if (!container_shared_pointer) return access_result<const_view>(access_status::expired);
+            std::optional<const_view> acquired(acquire_const_view(std::move(container_shared_pointer), lock_args...));
+            if (!acquired) return access_result<const_view>(failure);
+            return access_result<const_view>(std::move(*acquired));
+        }
+        
+        /**
+         * Pin the Container with std::weak_ptr::lock, which never throws, and lock the primary copy
+         * @param failure status returned when the lock is not owned after construction
+         * @param lock_args std::try_to_lock, a timeout duration or nothing
+         */
+        template<typename ...lock_args_t>
+        inline access_result<view> try_acquire_view(access_status failure, const lock_args_t &...lock_args) const
+        {
+            std::shared_ptr<Container> container_shared_pointer(this->container_weak_ptr.lock());
+            if (!container_shared_pointer) return access_result<view>(access_status::expired);
+            unique_lock_type content_guard_lock(container_shared_pointer->content_guard, lock_args...);
+            if (!content_guard_lock) return access_result<view>(failure);
+            return access_result<view>(view(std::move(container_shared_pointer), std::move(content_guard_lock)));
+        }
+    };
+    
+    /**
+     * Locks the primary copy exclusively
+     * @return std::optional<view>
+     */
+    inline std::optional<view> operator*()
+    {
+        unique_lock_type content_guard_lock(container->content_guard);
+        return std::optional<view>(view(std::shared_ptr<Container>(container), std::move(content_guard_lock)));
+    }
+    
+    /**
+     * Locks the replica of the calling node
+     * @return std::optional<const_view>
+     */
+    inline std::optional<const_view> operator*() const
+    {
+        return weak_ptr::acquire_const_view(std::shared_ptr<Container>(container));
+    }
+};
+
+#endif //HEADER_GUARD__a2c7e419_6f08_4d5b_b3e1_98d4f0c27a6e__referable_unique_replicated_hpp
@@ -0,0 +1,304 @@
+//
+// Created in October 2026
+//
+
+#ifndef HEADER_GUARD__e3a58c02_7d1b_4e96_9f4a_16b0c7d2e85f__referable_unique_sharded_hpp
+#define HEADER_GUARD__e3a58c02_7d1b_4e96_9f4a_16b0c7d2e85f__referable_unique_sharded_hpp
+
+#include "variable_util_includes.h"
+
+/**
+ * Lock policy selecting the distributed counter specialization of referable_unique<std::atomic<T>>.
+ * The counter is split into cache line sized slots, one per CPU,
+ * so that concurrent increments from different CPUs never share a cache line.
+ * Increments are local to the slot of the calling CPU and reads sum every slot,
+ * which makes reads more expensive and not linearizable with concurrent increments.
+ */
+struct sharded_counter_policy final : guard_mode
+{
+};
+
+/**
+ * Partial specification for std::atomic<T> with sharded_counter_policy
+ * @tparam T non-const integral content type
+ */
+template<typename T>
+class referable_unique<
+        std::atomic<T>, sharded_counter_policy,
+        std::enable_if_t<(!std::is_const<T>::value) && std::is_integral<T>::value>
+> final
+{
+private:
+    static_assert(std::is_const_v<T> == 0, "referable_unique requires a non-const content type");
+    
+    ///Data Class
+    class Container
+    {
+    private:
+        struct alignas(64) slot final
+        {
+            std::atomic<T> value{0};
+        };
+        
+        inline explicit Container(const Container &) = delete;
+        
+        inline explicit Container(Container &&) = delete;
+        
+        ///Number of slots, the number of CPUs rounded up to a power of 2
+        static inline std::size_t default_slot_count() noexcept
+        {
+            const std::size_t cpu_count = std::max(1u, std::thread::hardware_concurrency());
+            std::size_t slot_count = 1;
+            while (slot_count < cpu_count && slot_count < 256) slot_count <<= 1;
+            return slot_count;
+        }
+        
+        /**
+         * CPU running the calling thread,
+         * or a stable index of the calling thread where the CPU is unknown
+         */
+        static inline std::size_t slot_hint() noexcept
+        {
+#if defined(__linux__)
+            if (const int cpu = sched_getcpu(); cpu >= 0) return static_cast<std::size_t>(cpu);
+#endif
+            static std::atomic<std::size_t> next_thread_index(0);
+            static thread_local const std::size_t thread_index =
+                    next_thread_index.fetch_add(1, std::memory_order_relaxed);
+            return thread_index;
+        }
+    
+    public:
+        std::vector<slot> slots;
+        const std::size_t slot_mask;
+        
+        inline explicit Container(const T &initial_content) :
+                slots(default_slot_count()), slot_mask(slots.size() - 1)
+        {
+            slots.front().value.store(initial_content, std::memory_order_relaxed);
+        }
+        
+        ///Slot of the calling CPU
+        inline std::atomic<T> &local_slot() noexcept
+        {
+            return slots[slot_hint() & slot_mask].value;
+        }
+        
+        inline T sum(std::memory_order order) const noexcept
+        {
+            T total = 0;
+            for (const slot &each: slots) total += each.value.load(order);
+            return total;
+        }
+    };
+    
+    /**
+     * The deleter hands the Container over to epoch_domain,
+     * so that weak_ptr can update it inside an epoch_guard
+     * without incrementing the shared reference count, which would be contended again.
+     * @param initial_content
+     * @return std::shared_ptr<Container>
+     */
+    static inline std::shared_ptr<Container> make_container(const T &initial_content)
+    {
+        return std::shared_ptr<Container>(
+                new Container(initial_content),
+                [](Container *expired_container)
+                {
+                    epoch_domain::instance().retire(
+                            expired_container,
+                            [](void *pointer) { delete static_cast<Container *>(pointer); },
+                            sizeof(Container)
+                    );
+                }
+        );
+    }
+    
+    std::shared_ptr<Container> container;
+    
+    /**
+     * Disable default constructor
+     */
+    inline explicit referable_unique() noexcept = delete;
+    
+    /**
+     * Disable copy constructor
+     */
+    inline explicit referable_unique(const referable_unique &) noexcept = delete;
+    
+    /**
+     * 禁用拷贝赋值运算符
+     */
+    inline referable_unique &operator=(const referable_unique &) noexcept = delete;
+
+public:
+    /**
+     * Move constructor
+     * @param original_referable_unique
+     */
+    inline explicit referable_unique(referable_unique &&original_referable_unique) noexcept :
+            container(std::move(original_referable_unique.container))
+    {}
+    
+    /**
+     * Commonly used constructor
+     * @param initial_content
+     */
+    inline explicit referable_unique(const T &initial_content) :
+            container(make_container(initial_content))
+    {}
+    
+    inline operator bool() const noexcept
+    {
+        return (bool) container;
+    }
+    
+    /**
+     * Sum of every slot
+     * @return current content
+     */
+    inline T operator*() const noexcept
+    {
+        return container->sum(std::memory_order_relaxed);
+    }
+    
+    /**
+     * Sum of every slot
+     * @param order memory order of the load of each slot
+     * @return current content
+     */
+    inline T load(std::memory_order order = std::memory_order_relaxed) const noexcept
+    {
+        return container->sum(order);
+    }
+    
+    /**
+     * Add operand to the slot of the calling CPU
+     * @param operand
+     * @param order memory order of the addition
+     */
+    inline void add(const T &operand, std::memory_order order = std::memory_order_relaxed) noexcept
+    {
+        container->local_slot().fetch_add(operand, order);
+    }
+    
+    /**
+     * Subtract operand from the slot of the calling CPU
+     * @param operand
+     * @param order memory order of the subtraction
+     */
+    inline void sub(const T &operand, std::memory_order order = std::memory_order_relaxed) noexcept
+    {
+        container->local_slot().fetch_sub(operand, order);
+    }
+    
+    class weak_ptr final
+    {
+    private:
+        std::weak_ptr<Container> container_weak_ptr;
+        /**
+         * Dereferenced only inside an epoch_guard after container_weak_ptr is checked,
+         * because an expired Container is destroyed by epoch_domain.
+         */
+        Container *container_raw_ptr;
+        
+        /**
+         * Disable default constructor
+         */
+        inline explicit weak_ptr() = delete;
+        
+        /**
+         * Disable unnecessary move constructor
+         */
+        inline explicit weak_ptr(weak_ptr &&) = delete;
+        
+        /**
+         * 禁用移动赋值运算符
+         * @return lvalue reference of current object
+         */
+        inline weak_ptr &operator=(weak_ptr &&) = delete;
+    
+    public:
+        /**
+         * Copy constructor
+         * @param another the const lvalue reference of weak_ptr
+         */
+        inline explicit weak_ptr(const weak_ptr &another) noexcept :
+                container_weak_ptr(another.container_weak_ptr),
+                container_raw_ptr(another.container_raw_ptr)
+        {}
+        
+        /**
+         * 拷贝赋值运算符
+         * @param another the const lvalue reference of weak_ptr
+         * @return the lvalue reference of this weak_ptr
+         */
+        inline weak_ptr &operator=(const weak_ptr &another) noexcept
+        {
+            this->container_weak_ptr = another.container_weak_ptr;
+            this->container_raw_ptr = another.container_raw_ptr;
+            return *this;
+        }
+        
+        /**
+         * Commonly used constructor
+         * @param referable_unique__
+         */
+        inline explicit weak_ptr(const referable_unique &referable_unique__) noexcept :
+                container_weak_ptr(referable_unique__.container),
+                container_raw_ptr(referable_unique__.container.get())
+        {}
+        
+        /**
+         * 重载解引用运算符
+         * @return sum of every slot, or std::nullopt if the content has expired
+         */
+        inline std::optional<T> operator*() const noexcept
+        {
+            return load();
+        }
+        
+        /**
+         * Read inside an epoch_guard, without touching a reference count
+         * @param order memory order of the load of each slot
+         * @return sum of every slot, or std::nullopt if the content has expired
+         */
+        inline std::optional<T> load(std::memory_order order = std::memory_order_relaxed) const noexcept
+        {
+            epoch_guard content_epoch_guard;
+            if (container_weak_ptr.expired()) return std::nullopt;
+            return container_raw_ptr->sum(order);
+        }
+        
+        /**
+         * Add operand to the slot of the calling CPU,
+         * inside an epoch_guard without touching a reference count
+         * @param operand
+         * @param order memory order of the addition
+         * @return false if the content has expired
+         */
+        inline bool add(const T &operand, std::memory_order order = std::memory_order_relaxed) const noexcept
+        {
+            epoch_guard content_epoch_guard;
+            if (container_weak_ptr.expired()) return false;
+            container_raw_ptr->local_slot().fetch_add(operand, order);
+            return true;
+        }
+        
+        /**
+         * Subtract operand from the slot of the calling CPU
+         * @param operand
+         * @param order memory order of the subtraction
+         * @return false if the content has expired
+         */
+        inline bool sub(const T &operand, std::memory_order order = std::memory_order_relaxed) const noexcept
+        {
+            epoch_guard content_epoch_guard;
+            if (container_weak_ptr.expired()) return false;
+            container_raw_ptr->local_slot().fetch_sub(operand, order);
+            return true;
+        }
+    };
+};
+
+#endif //HEADER_GUARD__e3a58c02_7d1b_4e96_9f4a_16b0c7d2e85f__referable_unique_sharded_hpp
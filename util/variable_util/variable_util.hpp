@@ -7,10 +7,43 @@
 
 #include "variable_util_includes.h"
 
+/**
+ * Default lock_policy of referable_unique.
+ * Define VARIABLE_UTIL_INSTRUMENTED to collect lock_statistics of every object using the default,
+ * or define VARIABLE_UTIL_DEFAULT_LOCK_POLICY to any lock policy.
+ */
+#if !defined(VARIABLE_UTIL_DEFAULT_LOCK_POLICY)
+#if defined(VARIABLE_UTIL_INSTRUMENTED)
+#define VARIABLE_UTIL_DEFAULT_LOCK_POLICY instrumented_mutex<std::shared_timed_mutex>
+#else
+#define VARIABLE_UTIL_DEFAULT_LOCK_POLICY std::shared_timed_mutex
+#endif
+#endif
+
 namespace variable_util
 {
 
+#include "lock_policy.hpp"
+#include "epoch.hpp"
+#include "deferred_reclaimer.hpp"
+#include "referable_tag.hpp"
+#include "access_result.hpp"
+#include "flat_combining.hpp"
+#include "change_notifier.hpp"
+#include "instrumented_mutex.hpp"
+#include "awaitable_mutex.hpp"
+#include "referable_base.hpp"
 #include "referable_unique.hpp"
+#include "referable_registry.hpp"
+#include "lock_views.hpp"
+#include "handle_cache.hpp"
+#include "referable_unique_rcu.hpp"
+#include "referable_unique_sharded.hpp"
+#include "referable_unique_intrusive.hpp"
+#include "referable_unique_lock_free.hpp"
+#include "referable_unique_replicated.hpp"
+#include "referable_pool.hpp"
+#include "referable_snapshot.hpp"
 
 }
 #endif //HEADER_GUARD__3f4bf47e_102f_4dc1_80ae_757ec2701bab__variable_util_hpp